@@ -0,0 +1,26 @@
+#!/bin/sh
+
+# BLOCK_SIZE is fixed when surge-common is compiled, so comparing block sizes means one
+# testrunner build per size. This configures and builds each into ignore/bs<N> and runs the
+# benchmark suite from each. Medians are per block, so compare sizes by the x_realtime column,
+# and engine/idle for the fixed cost of a block.
+#
+# Usage: scripts/misc/block-size-benchmark.sh [sizes...]   (default: 8 16 32 64 128 256)
+
+if [ ! -f CMakeLists.txt ]; then
+    echo "Please run block-size-benchmark.sh from the root of the surge git directory"
+    exit 1
+fi
+
+SIZES=${*:-"8 16 32 64 128 256"}
+
+for bs in $SIZES; do
+    cmake -Bignore/bs${bs} -DCMAKE_BUILD_TYPE=Release -DSURGE_COMPILE_BLOCK_SIZE=${bs} > /dev/null || exit 1
+    cmake --build ignore/bs${bs} --target surge-testrunner --parallel > /dev/null || exit 1
+done
+
+for bs in $SIZES; do
+    runner=$(find ignore/bs${bs} -name surge-testrunner -type f -perm -u+x | head -1)
+    echo "# BLOCK_SIZE=${bs}"
+    ${runner} --non-test --benchmark-suite -
+done
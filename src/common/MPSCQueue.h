@@ -0,0 +1,109 @@
+/*
+ * Surge XT - a free and open source hybrid synthesizer,
+ * built by Surge Synth Team
+ *
+ * Learn more at https://surge-synthesizer.github.io/
+ *
+ * Copyright 2018-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * Surge XT is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Surge was a commercial product from 2004-2018, copyright and ownership
+ * held by Claes Johanson at Vember Audio during that period.
+ * Claes made Surge open source in September 2018.
+ *
+ * All source for Surge XT is available at
+ * https://github.com/surge-synthesizer/surge
+ */
+
+#ifndef SURGE_SRC_COMMON_MPSCQUEUE_H
+#define SURGE_SRC_COMMON_MPSCQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace Surge
+{
+
+/*
+ * A bounded lock-free queue for any number of producers and one consumer. Each cell carries a
+ * sequence number, so a producer claims a cell by advancing the write position with a CAS and
+ * then publishes it by bumping the cell's sequence; the consumer only reads cells whose sequence
+ * says they are published. push never blocks or allocates and fails if the queue is full.
+ */
+template <typename T, size_t capacity> struct MPSCQueue
+{
+    static_assert((capacity & (capacity - 1)) == 0, "capacity must be a power of two");
+
+    MPSCQueue()
+    {
+        for (size_t i = 0; i < capacity; ++i)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // Any thread
+    bool push(const T &v)
+    {
+        Cell *cell;
+        auto pos = writePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            cell = &cells[pos & (capacity - 1)];
+            auto seq = cell->sequence.load(std::memory_order_acquire);
+            auto dif = (intptr_t)seq - (intptr_t)pos;
+            if (dif == 0)
+            {
+                if (writePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (dif < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = writePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = v;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only
+    bool pop(T &v)
+    {
+        auto &cell = cells[readPos & (capacity - 1)];
+        auto seq = cell.sequence.load(std::memory_order_acquire);
+        if ((intptr_t)seq - (intptr_t)(readPos + 1) < 0)
+            return false;
+
+        v = std::move(cell.value);
+        cell.sequence.store(readPos + capacity, std::memory_order_release);
+        readPos++;
+        return true;
+    }
+
+  private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::array<Cell, capacity> cells;
+    alignas(64) std::atomic<size_t> writePos{0};
+    alignas(64) size_t readPos{0};
+};
+
+} // namespace Surge
+
+#endif // SURGE_SRC_COMMON_MPSCQUEUE_H
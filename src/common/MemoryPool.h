@@ -27,7 +27,7 @@ namespace Surge
 {
 namespace Memory
 {
-// pre-alloc must be at least one
+// pre-alloc may be zero; the first getItem on an empty pool grows it by growBy
 template <typename T, size_t preAlloc, size_t growBy, size_t capacity = 16384> struct MemoryPool
 {
     template <typename... Args> MemoryPool(Args &&...args)
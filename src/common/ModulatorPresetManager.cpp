@@ -216,6 +216,8 @@ void ModulatorPreset::loadPresetFrom(const fs::path &location, SurgeStorage *s,
         }
     }
 
+    s->getPatch().markAllParametersChanged();
+
     if (lfotype == lt_mseg)
     {
         auto msn = lfox->FirstChildElement("mseg");
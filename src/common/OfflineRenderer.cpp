@@ -0,0 +1,159 @@
+/*
+ * Surge XT - a free and open source hybrid synthesizer,
+ * built by Surge Synth Team
+ *
+ * Learn more at https://surge-synthesizer.github.io/
+ *
+ * Copyright 2018-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * Surge XT is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Surge was a commercial product from 2004-2018, copyright and ownership
+ * held by Claes Johanson at Vember Audio during that period.
+ * Claes made Surge open source in September 2018.
+ *
+ * All source for Surge XT is available at
+ * https://github.com/surge-synthesizer/surge
+ */
+
+#include "OfflineRenderer.h"
+#include "SurgeSynthesizer.h"
+#include "SurgeMemoryPools.h"
+
+#include <algorithm>
+#include <map>
+
+namespace Surge
+{
+namespace Offline
+{
+
+void Renderer::setEvents(std::vector<Event> ev)
+{
+    events = std::move(ev);
+    std::stable_sort(events.begin(), events.end(),
+                     [](const Event &a, const Event &b) { return a.atSample < b.atSample; });
+    prepared = false;
+}
+
+const Renderer::Plan &Renderer::prepare()
+{
+    currentPlan = Plan();
+
+    // Bucket the events by the block they land in
+    blockStart.clear();
+    if (!events.empty())
+        currentPlan.blocks = std::max(events.back().atSample, (int64_t)0) / BLOCK_SIZE + 1;
+    blockStart.resize(currentPlan.blocks + 1, events.size());
+
+    size_t ei = 0;
+    for (int64_t b = 0; b < currentPlan.blocks; ++b)
+    {
+        blockStart[b] = ei;
+        int ons = 0;
+        while (ei < events.size() && events[ei].atSample < (b + 1) * BLOCK_SIZE)
+        {
+            ons += (events[ei].type == Event::NOTE_ON);
+            ei++;
+        }
+        currentPlan.peakNoteOnsInBlock = std::max(currentPlan.peakNoteOnsInBlock, ons);
+    }
+
+    /*
+     * Work out how many voices can be sounding at once: a note holds a voice from its note on
+     * until releaseTailSamples after its note off. This ignores sustain and choking, so it can
+     * be high, but the pools are capped by the voice limit below anyway.
+     */
+    std::map<int, int> held;
+    std::vector<int64_t> releasingUntil;
+    int heldCount = 0;
+    for (const auto &e : events)
+    {
+        if (e.type == Event::CALLBACK)
+            continue;
+
+        releasingUntil.erase(std::remove_if(releasingUntil.begin(), releasingUntil.end(),
+                                            [&e](auto u) { return u <= e.atSample; }),
+                             releasingUntil.end());
+
+        auto k = (e.channel & 0xFF) * 128 + (e.key & 0x7F);
+        if (e.type == Event::NOTE_ON)
+        {
+            held[k]++;
+            heldCount++;
+        }
+        else if (held[k] > 0)
+        {
+            held[k]--;
+            heldCount--;
+            releasingUntil.push_back(e.atSample + releaseTailSamples);
+        }
+
+        currentPlan.peakVoices =
+            std::max(currentPlan.peakVoices, heldCount + (int)releasingUntil.size());
+    }
+
+    auto &storage = synth->storage;
+    storage.perform_queued_wtloads();
+
+    auto &pools = *storage.memoryPools;
+    pools.sizeOscillatorPools(&storage, std::min(currentPlan.peakVoices, MAX_VOICES));
+    pools.touchOscillatorPools();
+
+    prepared = true;
+    return currentPlan;
+}
+
+int64_t Renderer::render(float *interleaved, int64_t fromBlock, int64_t nBlocks)
+{
+    if (!prepared)
+        prepare();
+
+    auto toBlock = std::min(fromBlock + nBlocks, currentPlan.blocks);
+    if (fromBlock >= toBlock)
+        return 0;
+
+    // Nothing is waiting on this render, so there is no budget to spread note ons against
+    auto priorBudget = synth->storage.voiceStartBudgetNs;
+    synth->storage.voiceStartBudgetNs = 0;
+
+    for (auto b = fromBlock; b < toBlock; ++b)
+    {
+        for (auto ei = blockStart[b]; ei < blockStart[b + 1]; ++ei)
+        {
+            auto &e = events[ei];
+            switch (e.type)
+            {
+            case Event::NOTE_ON:
+                synth->playNote(e.channel, e.key, e.velocity, 0, e.host_noteid);
+                break;
+            case Event::NOTE_OFF:
+                synth->releaseNote(e.channel, e.key, e.velocity, e.host_noteid);
+                break;
+            case Event::CALLBACK:
+                if (e.callback)
+                    e.callback(synth);
+                break;
+            }
+        }
+
+        synth->process();
+
+        for (int i = 0; i < BLOCK_SIZE; ++i)
+        {
+            *interleaved++ = synth->output[0][i];
+            *interleaved++ = synth->output[1][i];
+        }
+    }
+
+    synth->storage.voiceStartBudgetNs = priorBudget;
+
+    return toBlock - fromBlock;
+}
+
+} // namespace Offline
+} // namespace Surge
@@ -0,0 +1,105 @@
+/*
+ * Surge XT - a free and open source hybrid synthesizer,
+ * built by Surge Synth Team
+ *
+ * Learn more at https://surge-synthesizer.github.io/
+ *
+ * Copyright 2018-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * Surge XT is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Surge was a commercial product from 2004-2018, copyright and ownership
+ * held by Claes Johanson at Vember Audio during that period.
+ * Claes made Surge open source in September 2018.
+ *
+ * All source for Surge XT is available at
+ * https://github.com/surge-synthesizer/surge
+ */
+
+#ifndef SURGE_SRC_COMMON_OFFLINERENDERER_H
+#define SURGE_SRC_COMMON_OFFLINERENDERER_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class SurgeSynthesizer;
+
+namespace Surge
+{
+namespace Offline
+{
+
+struct Event
+{
+    enum Type
+    {
+        NOTE_ON,
+        NOTE_OFF,
+        CALLBACK, // runs callback before the block holding atSample; may be empty to set a length
+    };
+
+    int64_t atSample{0};
+    Type type{NOTE_ON};
+    char channel{0}, key{0}, velocity{0};
+    int32_t host_noteid{-1};
+    std::function<void(SurgeSynthesizer *)> callback;
+};
+
+/*
+ * Renders a list of events which is entirely known up front, for the test runner, surgepy and
+ * other bounces. Events are applied at the start of the block holding their sample, in the order
+ * given, exactly as a host would deliver them, so the output is the same as feeding the synth
+ * block by block. What the lookahead buys is in prepare():
+ *
+ * - the events are bucketed by block once instead of being searched for every block
+ * - the number of voices the list can have sounding at once is worked out, the String delay
+ *   lines are sized for that many voices (the oscillator slots always cover MAX_VOICES), and
+ *   every free slot and delay line is written to before the first block, so no note on in the
+ *   render grows a pool or faults in fresh pages
+ * - queued wavetable loads are done before rendering starts
+ * - SurgeStorage::voiceStartBudgetNs is switched off for the render, since there is no deadline
+ *   to spread note ons against and spreading them would move notes
+ */
+struct Renderer
+{
+    explicit Renderer(SurgeSynthesizer *s) : synth(s) {}
+
+    // Events must be sorted by atSample; ties keep their order
+    void setEvents(std::vector<Event> events);
+
+    // How long a released note is assumed to keep its voice when sizing the pools
+    int64_t releaseTailSamples{44100};
+
+    struct Plan
+    {
+        int64_t blocks{0};
+        int peakVoices{0};
+        int peakNoteOnsInBlock{0};
+    };
+    const Plan &prepare();
+    const Plan &plan() const { return currentPlan; }
+
+    /*
+     * Renders blocks [fromBlock, fromBlock + nBlocks) of the plan into interleaved stereo, two
+     * floats per sample. Blocks must be rendered in order. Returns the number of blocks rendered.
+     */
+    int64_t render(float *interleaved, int64_t fromBlock, int64_t nBlocks);
+
+  private:
+    SurgeSynthesizer *synth;
+    std::vector<Event> events;
+    // events for block b are [blockStart[b], blockStart[b + 1])
+    std::vector<size_t> blockStart;
+    Plan currentPlan;
+    bool prepared{false};
+};
+
+} // namespace Offline
+} // namespace Surge
+
+#endif // SURGE_SRC_COMMON_OFFLINERENDERER_H
@@ -0,0 +1,127 @@
+/*
+ * Surge XT - a free and open source hybrid synthesizer,
+ * built by Surge Synth Team
+ *
+ * Learn more at https://surge-synthesizer.github.io/
+ *
+ * Copyright 2018-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * Surge XT is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Surge was a commercial product from 2004-2018, copyright and ownership
+ * held by Claes Johanson at Vember Audio during that period.
+ * Claes made Surge open source in September 2018.
+ *
+ * All source for Surge XT is available at
+ * https://github.com/surge-synthesizer/surge
+ */
+
+
+#ifndef SURGE_SRC_COMMON_PARAMETERREFRESHQUEUE_H
+#define SURGE_SRC_COMMON_PARAMETERREFRESHQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+#include "MPSCQueue.h"
+
+namespace Surge
+{
+
+/*
+ * Carries "this parameter changed, go redraw it" notifications from the synth (host automation,
+ * MIDI learn, OSC) to the editor. Any thread may push, since setParameter01 with external set is
+ * called from the audio thread and from the OSC and host threads; the editor idle loop is the one
+ * consumer.
+ *
+ * Ids go into a bounded MPSC ring. If the ring is full the id is marked in a dirty bitset instead,
+ * so an automation flood never loses a change and never needs a full editor refresh; the consumer
+ * just redraws the union of the two, once per id. The editor reads the current value when it
+ * redraws, so the queue does not carry one.
+ */
+template <int nParams, int ringSize = 1024> struct ParameterRefreshQueue
+{
+    ParameterRefreshQueue()
+    {
+        for (auto &w : dirty)
+            w = 0;
+    }
+
+    // Any thread. Never blocks or allocates.
+    void push(int id)
+    {
+        if (id < 0 || id >= nParams)
+            return;
+
+        if (!ring.push(id))
+        {
+            dirty[id >> 6].fetch_or((uint64_t)1 << (id & 63), std::memory_order_release);
+            overflowCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Consumer side. Appends each changed id once, ring events first in arrival order.
+    void drain(std::vector<int> &ids)
+    {
+        std::bitset<nParams> seen;
+
+        int32_t id;
+        while (ring.pop(id))
+        {
+            if (!seen[id])
+            {
+                seen[id] = true;
+                ids.push_back(id);
+            }
+        }
+
+        for (int i = 0; i < dirtyWords; ++i)
+        {
+            auto bits = dirty[i].exchange(0, std::memory_order_acquire);
+            while (bits)
+            {
+                int b = 0;
+                while (!(bits & ((uint64_t)1 << b)))
+                    ++b;
+                bits &= ~((uint64_t)1 << b);
+
+                auto did = i * 64 + b;
+                if (!seen[did])
+                {
+                    seen[did] = true;
+                    ids.push_back(did);
+                }
+            }
+        }
+    }
+
+    // Consumer side. Drops everything pending, for instance when the editor is rebuilt anyway.
+    void clear()
+    {
+        int32_t id;
+        while (ring.pop(id))
+            ;
+        for (auto &w : dirty)
+            w.store(0, std::memory_order_release);
+    }
+
+    // How many events went to the bitset because the ring was full
+    std::atomic<uint64_t> overflowCount{0};
+
+  private:
+    static constexpr int dirtyWords = (nParams + 63) / 64;
+
+    MPSCQueue<int32_t, ringSize> ring;
+    std::array<std::atomic<uint64_t>, dirtyWords> dirty;
+};
+
+} // namespace Surge
+
+#endif // SURGE_SRC_COMMON_PARAMETERREFRESHQUEUE_H
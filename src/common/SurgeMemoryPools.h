@@ -25,15 +25,143 @@
 
 #include "SurgeStorage.h"
 #include "MemoryPool.h"
+#include "Oscillator.h"
 #include "SSESincDelayLine.h"
 
+#include <algorithm>
+#include <cstring>
+#include <new>
+
 namespace Surge
 {
 namespace Memory
 {
+/*
+ * Voice oscillators are placement-new'd into slots from here. Each oscillator type keeps its own
+ * free list of slots sized for that type (rather than the oscillator_buffer_size worst case),
+ * and a type only has memory behind it once the patch uses it.
+ *
+ * Every type the patch uses has a slot for each of its oscillators in MAX_VOICES voices, so no
+ * polyphony setting can run short. The pool is sized at patch load and when loadOscalgos applies
+ * an oscillator type change, never from voice processing. A voice which finds no slot anyway (a
+ * type written some other way, like a paste, since the last sizing) takes the smallest free slot
+ * of another type which is big enough, or else counts a miss; the synth then sizes the pool for
+ * the patch and the voice tries again, see SurgeSynthesizer::processControl.
+ */
+struct OscillatorSlotPool
+{
+    static constexpr size_t slotAlignment = 64;
+
+    explicit OscillatorSlotPool(size_t maxSlotsPerType)
+    {
+        for (auto &f : freeSlots)
+            f.reserve(maxSlotsPerType);
+        for (auto &o : owned)
+            o.reserve(maxSlotsPerType);
+    }
+    ~OscillatorSlotPool()
+    {
+        // Voices which are still sounding when we go away never hand their slots back
+        for (auto &o : owned)
+            for (auto q : o)
+                ::operator delete(q, std::align_val_t(slotAlignment));
+    }
+
+    static size_t slotSize(int list)
+    {
+        return (oscillator_slot_size(list) + slotAlignment - 1) & ~(slotAlignment - 1);
+    }
+
+    /*
+     * Audio thread. Never allocates, and returns nullptr when nothing free fits. list is set to
+     * the free list the slot has to go back to.
+     */
+    unsigned char *getSlot(int type, int &list)
+    {
+        list = type;
+        if (freeSlots[list].empty())
+        {
+            list = -1;
+            auto need = slotSize(type);
+            for (int t = 0; t < n_osc_types; ++t)
+            {
+                if (!freeSlots[t].empty() && slotSize(t) >= need &&
+                    (list < 0 || slotSize(t) < slotSize(list)))
+                    list = t;
+            }
+        }
+
+        if (list < 0)
+        {
+            misses++;
+            return nullptr;
+        }
+
+        auto &f = freeSlots[list];
+        auto q = f.back();
+        f.pop_back();
+        inUse[list]++;
+        return q;
+    }
+    void returnSlot(int list, unsigned char *slot)
+    {
+        freeSlots[list].push_back(slot);
+        inUse[list]--;
+    }
+
+    // Not on the audio thread. Makes sure list has at least upTo free slots
+    void setupPoolToSize(int list, size_t upTo)
+    {
+        while (freeSlots[list].size() < upTo)
+            freeSlots[list].push_back(allocateSlot(list));
+    }
+    // Write to every free slot so a voice starting in it doesn't take the page faults
+    void touchFreeSlots(int list)
+    {
+        auto sz = slotSize(list);
+        for (auto q : freeSlots[list])
+            memset(q, 0, sz);
+    }
+    // Not on the audio thread. Slots still held by voices are released on a later reset
+    void releaseFreeSlots(int list)
+    {
+        auto &o = owned[list];
+        for (auto q : freeSlots[list])
+        {
+            o.erase(std::find(o.begin(), o.end(), q));
+            ::operator delete(q, std::align_val_t(slotAlignment));
+        }
+        freeSlots[list].clear();
+    }
+
+    size_t slotsInUse(int list) const { return inUse[list]; }
+    size_t slotsFree(int list) const { return freeSlots[list].size(); }
+    size_t slotMisses() const { return misses; }
+    size_t bytesAllocated() const
+    {
+        size_t res = 0;
+        for (int t = 0; t < n_osc_types; ++t)
+            res += owned[t].size() * slotSize(t);
+        return res;
+    }
+
+  private:
+    unsigned char *allocateSlot(int list)
+    {
+        auto q = static_cast<unsigned char *>(
+            ::operator new(slotSize(list), std::align_val_t(slotAlignment)));
+        owned[list].push_back(q);
+        return q;
+    }
+
+    std::array<std::vector<unsigned char *>, n_osc_types> freeSlots, owned;
+    std::array<size_t, n_osc_types> inUse{};
+    size_t misses{0};
+};
+
 struct SurgeMemoryPools
 {
-    SurgeMemoryPools(SurgeStorage *s) : stringDelayLines(s->sinctable) {}
+    SurgeMemoryPools(SurgeStorage *s) : stringDelayLines(s->sinctable), oscillatorSlots(maxosc) {}
 
     /*
      * The largest number of oscillator instances of a particular
@@ -42,30 +170,94 @@ struct SurgeMemoryPools
     static constexpr int maxosc = n_scenes * n_oscs * (MAX_VOICES + 8);
 
     /*
-     * The string needs 2 delay lines per oscillator
+     * The string needs 2 delay lines per oscillator. Each is about 64k, so none are held until a
+     * patch with a String oscillator sizes the pool; an FX plugin instance never holds any.
      */
-    MemoryPool<SSESincDelayLine<16384>, 8, 4, 2 * maxosc + 100> stringDelayLines;
-    void resetAllPools(SurgeStorage *storage) { resetOscillatorPools(storage); }
-    void resetOscillatorPools(SurgeStorage *storage)
+    MemoryPool<SSESincDelayLine<16384>, 0, 4, 2 * maxosc + 100> stringDelayLines;
+    OscillatorSlotPool oscillatorSlots;
+
+    void resetAllPools(SurgeStorage *storage)
+    {
+        sizeOscillatorPools(storage, storage->getPatch().polylimit.val.i);
+    }
+
+    // How many oscillators of each type the patch has, across both scenes
+    static std::array<int, n_osc_types> countOscillatorTypes(SurgeStorage *storage)
     {
-        bool hasString{false}, hasTwist{false};
-        int nString{0};
+        std::array<int, n_osc_types> nOfType{};
         for (int s = 0; s < n_scenes; ++s)
         {
             for (int os = 0; os < n_oscs; ++os)
             {
                 auto ot = storage->getPatch().scene[s].osc[os].type.val.i;
+                if (ot >= 0 && ot < n_osc_types)
+                    nOfType[ot]++;
+            }
+        }
+        return nOfType;
+    }
+
+    /*
+     * Sizes everything a voice oscillator takes memory from: the oscillator slots (see
+     * sizeOscillatorSlots) and two String delay lines per String oscillator for voices voices.
+     * Called at patch load and by the offline renderer once it knows how many voices its events
+     * need.
+     */
+    void sizeOscillatorPools(SurgeStorage *storage, int voices)
+    {
+        auto nOfType = countOscillatorTypes(storage);
+
+        sizeOscillatorSlots(nOfType);
+
+        if (nOfType[ot_string])
+            stringDelayLines.setupPoolToSize(nOfType[ot_string] * 2 * voices, storage->sinctable);
+        else
+            stringDelayLines.returnToPreAllocSize();
+    }
+
+    /*
+     * Writes to every free oscillator slot and clears every free String delay line, so the voices
+     * which start in them don't take the page faults. Not on the audio thread.
+     */
+    void touchOscillatorPools()
+    {
+        for (int t = 0; t < n_osc_types; ++t)
+            oscillatorSlots.touchFreeSlots(t);
+        for (size_t i = 0; i < stringDelayLines.position; ++i)
+            stringDelayLines.pool[i]->clear();
+    }
 
-                if (ot == ot_string)
-                {
-                    hasString = true;
-                    nString++;
-                }
-                hasTwist |= (ot == ot_twist);
+    /*
+     * Gives every oscillator type the patch uses a slot per oscillator in MAX_VOICES voices, less
+     * the ones voices hold. Types the patch doesn't use give their free slots back; slots still
+     * held by voices of such a type are released by a later sizing.
+     */
+    void sizeOscillatorSlots(const std::array<int, n_osc_types> &nOfType)
+    {
+        for (int t = 0; t < n_osc_types; ++t)
+        {
+            if (nOfType[t])
+            {
+                size_t want = nOfType[t] * MAX_VOICES, have = oscillatorSlots.slotsInUse(t);
+                oscillatorSlots.setupPoolToSize(t, want > have ? want - have : 0);
+            }
+            else
+            {
+                oscillatorSlots.releaseFreeSlots(t);
             }
         }
+    }
+
+    // After an oscillator type change. Sizes the slots for the new types, and the String delay
+    // lines at half of what polylimit voices need, as they always were
+    void resetOscillatorPools(SurgeStorage *storage)
+    {
+        auto nOfType = countOscillatorTypes(storage);
+        sizeOscillatorSlots(nOfType);
+
+        auto nString = nOfType[ot_string];
 
-        if (hasString)
+        if (nString)
         {
             int maxUsed = nString * 2 * storage->getPatch().polylimit.val.i;
             stringDelayLines.setupPoolToSize((int)(maxUsed * 0.5), storage->sinctable);
@@ -799,7 +799,7 @@ SurgePatch::SurgePatch(SurgeStorage *storage)
                 Surge::MSEG::createInitVoiceMSEG(ms);
             }
 
-            Surge::MSEG::rebuildCache(ms);
+            Surge::MSEG::rebuildCache(ms, storage->msegBakedLookup);
 
             auto *fs = &(formulamods[s][m]);
             Surge::Formula::createInitFormula(fs);
@@ -974,22 +974,78 @@ void SurgePatch::init_default_values()
                 LFOBankLabel[s][i][d][0] = 0;
             }
         }
+
+    markAllParametersChanged();
 }
 
 SurgePatch::~SurgePatch() { free(patchptr); }
 
+/*
+ * Calls f with the offset of every slot in [from, from + n) which the journal says is stale,
+ * which is all of them if a full copy was asked for, and records them in refreshedParams. The
+ * changed and modulated bits for the range are consumed.
+ */
+template <typename F>
+static void forEachStaleParameter(SurgePatch &patch, int from, int n, bool all, F &&f)
+{
+    for (int w = from >> 6; w <= (from + n - 1) >> 6; ++w)
+    {
+        int lo = std::max(from, w << 6), hi = std::min(from + n, (w + 1) << 6);
+        uint64_t mask = ~(uint64_t)0;
+        if (hi - lo < 64)
+            mask = (((uint64_t)1 << (hi - lo)) - 1) << (lo & 63);
+
+        uint64_t bits = (patch.changedParams[w].fetch_and(~mask) | patch.modulatedParams[w]) & mask;
+        if (all)
+            bits = mask;
+        patch.modulatedParams[w] &= ~mask;
+        patch.refreshedParams[w] = (patch.refreshedParams[w] & ~mask) | bits;
+
+        if (bits == 0)
+            continue;
+
+        for (int id = lo; id < hi; ++id)
+        {
+            if (bits & ((uint64_t)1 << (id & 63)))
+                f(id - from);
+        }
+    }
+}
+
+// Whether range (0 global, 1 + scene) was asked to be copied in full, consuming the request
+static bool takeFullCopy(SurgePatch &patch, int range)
+{
+    uint32_t bit = 1U << range;
+    return patch.fullCopyPending.fetch_and(~bit) & bit;
+}
+
 void SurgePatch::copy_scenedata(pdata *d, pdata *dUnmod, int scene)
 {
 
     int s = scene_start[scene];
-    for (int i = 0; i < n_scene_params; i++)
-    {
+    bool delta = storage->deltaParamCopy;
+
+    auto copySlot = [&](int i) {
         // if (param_ptr[i+s]->valtype == vt_float)
         // d[i].f = param_ptr[i+s]->val.f;
         d[i].i = param_ptr[i + s]->val.i;
 
         if (param_ptr[i + s]->ctrlgroup == cg_OSC)
             dUnmod[i].f = d[i].f;
+    };
+
+    if (delta)
+    {
+        forEachStaleParameter(*this, s, n_scene_params, takeFullCopy(*this, scene + 1), copySlot);
+
+        // processControl adds the scene modulation right after this, so put these back next time
+        for (auto &r : this->scene[scene].modulation_scene)
+            markParameterModulated(s + r.destination_id);
+    }
+    else
+    {
+        for (int i = 0; i < n_scene_params; i++)
+            copySlot(i);
     }
 
     for (int i = 0; i < paramModulationCount; ++i)
@@ -997,6 +1053,10 @@ void SurgePatch::copy_scenedata(pdata *d, pdata *dUnmod, int scene)
         auto &pm = monophonicParamModulations[i];
         if (pm.param_id >= s && pm.param_id < s + n_scene_params)
         {
+            // A slot the journal didn't refresh still holds this from last block
+            if (delta && !(refreshedParams[pm.param_id >> 6] & ((uint64_t)1 << (pm.param_id & 63))))
+                continue;
+
             switch (pm.vt_type)
             {
             case vt_float:
@@ -1022,10 +1082,24 @@ void SurgePatch::copy_scenedata(pdata *d, pdata *dUnmod, int scene)
 
 void SurgePatch::copy_globaldata(pdata *d)
 {
-    for (int i = 0; i < n_global_params; i++)
+    bool delta = storage->deltaParamCopy;
+
+    if (delta)
     {
-        // if (param_ptr[i]->valtype == vt_float)
-        d[i].i = param_ptr[i]->val.i; // int is safer (no exceptions or anything)
+        forEachStaleParameter(*this, 0, n_global_params, takeFullCopy(*this, 0), [&](int i) {
+            d[i].i = param_ptr[i]->val.i;
+        });
+
+        for (auto &r : modulation_global)
+            markParameterModulated(r.destination_id);
+    }
+    else
+    {
+        for (int i = 0; i < n_global_params; i++)
+        {
+            // if (param_ptr[i]->valtype == vt_float)
+            d[i].i = param_ptr[i]->val.i; // int is safer (no exceptions or anything)
+        }
     }
 
     for (int i = 0; i < paramModulationCount; ++i)
@@ -1033,6 +1107,9 @@ void SurgePatch::copy_globaldata(pdata *d)
         auto &pm = monophonicParamModulations[i];
         if (pm.param_id < n_global_params)
         {
+            if (delta && !(refreshedParams[pm.param_id >> 6] & ((uint64_t)1 << (pm.param_id & 63))))
+                continue;
+
             switch (pm.vt_type)
             {
             case vt_float:
@@ -1108,6 +1185,8 @@ void SurgePatch::update_controls(
             }
         }
     }
+
+    markAllParametersChanged();
 }
 
 // BASE 64 SUPPORT, THANKS TO:
@@ -2441,7 +2520,7 @@ void SurgePatch::load_xml(const void *data, int datasize, bool is_preset)
                 Surge::MSEG::createInitVoiceMSEG(ms);
             }
 
-            Surge::MSEG::rebuildCache(ms);
+            Surge::MSEG::rebuildCache(ms, storage->msegBakedLookup);
 
             auto *fs = &(formulamods[s][m]);
 
@@ -2970,6 +3049,9 @@ void SurgePatch::load_xml(const void *data, int datasize, bool is_preset)
                         node->QueryFloatAttribute("noise_floor", &oos->noise_floor);
                         node->QueryFloatAttribute("max_db", &oos->max_db);
                         node->QueryFloatAttribute("decay_rate", &oos->decay_rate);
+                        node->QueryIntAttribute("fft_order", &oos->fft_order);
+                        node->QueryIntAttribute("fft_overlap", &oos->fft_overlap);
+                        node->QueryIntAttribute("fft_averaging", &oos->fft_averaging);
                     }
                 }
             } // end of editor populated block
@@ -3285,6 +3367,8 @@ void SurgePatch::load_xml(const void *data, int datasize, bool is_preset)
             }
         }
     }
+
+    markAllParametersChanged();
 }
 
 struct srge_header
@@ -3788,6 +3872,11 @@ unsigned int SurgePatch::save_xml(void **data) // allocates mem, must be freed b
         scope.SetDoubleAttribute("max_db", dawExtraState.editor.oscilloscopeOverlayState.max_db);
         scope.SetDoubleAttribute("decay_rate",
                                  dawExtraState.editor.oscilloscopeOverlayState.decay_rate);
+        scope.SetAttribute("fft_order", dawExtraState.editor.oscilloscopeOverlayState.fft_order);
+        scope.SetAttribute("fft_overlap",
+                           dawExtraState.editor.oscilloscopeOverlayState.fft_overlap);
+        scope.SetAttribute("fft_averaging",
+                           dawExtraState.editor.oscilloscopeOverlayState.fft_averaging);
         eds.InsertEndChild(scope);
 
         dawExtraXML.InsertEndChild(eds);
@@ -4097,7 +4186,7 @@ void SurgePatch::msegFromXMLElement(MSEGStorage *ms, TiXmlElement *p, bool resto
         }
     }
     // Rebuild cache
-    Surge::MSEG::rebuildCache(ms);
+    Surge::MSEG::rebuildCache(ms, storage->msegBakedLookup);
 }
 
 void SurgePatch::stepSeqToXmlElement(StepSequencerStorage *ss, TiXmlElement &p,
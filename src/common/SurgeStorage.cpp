@@ -27,6 +27,7 @@
 #include <cctype>
 #include <map>
 #include <queue>
+#include <functional>
 #include "UserDefaults.h"
 #if HAS_JUCE
 #include "SurgeSharedBinary.h"
@@ -50,6 +51,7 @@
 #include "FxPresetAndClipboardManager.h"
 #include "ModulatorPresetManager.h"
 #include "SurgeMemoryPools.h"
+#include "airwindows/AirWindowsEffect.h"
 #include "sst/basic-blocks/tables/SincTableProvider.h"
 
 // FIXME probably remove this when we remove the hardcoded hack below
@@ -64,6 +66,47 @@ using namespace std;
 
 std::string SurgeStorage::skipPatchLoadDataPathSentinel = "<SKIP-PATCH-SENTINEL>";
 
+namespace
+{
+/*
+ * Hosts running dozens of instances (especially of the FX plugin) would otherwise build and
+ * hold identical copies of these tables. Hold them weakly so they go away with the last storage.
+ */
+std::shared_ptr<sst::basic_blocks::tables::SurgeSincTableProvider> sharedSincTableProvider()
+{
+    static std::mutex providerMutex;
+    static std::weak_ptr<sst::basic_blocks::tables::SurgeSincTableProvider> provider;
+
+    std::lock_guard<std::mutex> g(providerMutex);
+    auto res = provider.lock();
+    if (!res)
+    {
+        res = std::make_shared<sst::basic_blocks::tables::SurgeSincTableProvider>();
+        provider = res;
+    }
+    return res;
+}
+
+// The first storage to ask loads it; a failed load is not kept, so the next storage tries again
+std::shared_ptr<Wavetable> sharedWindowWavetable(const std::function<bool(Wavetable *)> &load)
+{
+    static std::mutex wtMutex;
+    static std::weak_ptr<Wavetable> windowWT;
+
+    std::lock_guard<std::mutex> g(wtMutex);
+    auto res = windowWT.lock();
+    if (!res)
+    {
+        res = std::make_shared<Wavetable>();
+        if (load(res.get()))
+            windowWT = res;
+        else
+            res->size = 0;
+    }
+    return res;
+}
+} // namespace
+
 SurgeStorage::SurgeStorage(const SurgeStorage::SurgeStorageConfig &config) : otherscene_clients(0)
 {
     auto suppliedDataPath = config.suppliedDataPath;
@@ -95,7 +138,7 @@ SurgeStorage::SurgeStorage(const SurgeStorage::SurgeStorageConfig &config) : oth
     _patch.reset(new SurgePatch(this));
 
     namespace tabl = sst::basic_blocks::tables;
-    sincTableProvider = std::make_unique<tabl::SurgeSincTableProvider>();
+    sincTableProvider = sharedSincTableProvider();
     static_assert(tabl::SurgeSincTableProvider::FIRipol_M == FIRipol_M);
     static_assert(tabl::SurgeSincTableProvider::FIRipol_N == FIRipol_N);
     static_assert(tabl::SurgeSincTableProvider::FIRipolI16_N == FIRipolI16_N);
@@ -425,30 +468,32 @@ SurgeStorage::SurgeStorage(const SurgeStorage::SurgeStorageConfig &config) : oth
         refresh_patchlist();
     }
 
+    WindowWT = sharedWindowWavetable([this](Wavetable *wt) {
 #if HAS_JUCE
-    if (!load_wt_wt_mem(SurgeSharedBinary::windows_wt, SurgeSharedBinary::windows_wtSize,
-                        &WindowWT))
-    {
-        WindowWT.size = 0;
-        std::ostringstream oss;
-        oss << "Unable to load 'windows.wt' from memory. "
-            << "This is a fatal internal software error which should never occur!";
-        reportError(oss.str(), "Resource Loading Error");
-    }
+        if (!load_wt_wt_mem(SurgeSharedBinary::windows_wt, SurgeSharedBinary::windows_wtSize, wt))
+        {
+            std::ostringstream oss;
+            oss << "Unable to load 'windows.wt' from memory. "
+                << "This is a fatal internal software error which should never occur!";
+            reportError(oss.str(), "Resource Loading Error");
+            return false;
+        }
 #else
-    if (fs::exists(datapath / "windows.wt"))
-    {
-        if (!load_wt_wt(path_to_string(datapath / "windows.wt"), &WindowWT))
+        if (!fs::exists(datapath / "windows.wt"))
+            return false;
+
+        if (!load_wt_wt(path_to_string(datapath / "windows.wt"), wt))
         {
-            WindowWT.size = 0;
             std::ostringstream oss;
             oss << "Unable to load 'windows.wt' from file. "
                 << "This is a fatal internal software error which should never occur!";
             reportError(oss.str(), "Resource Loading Error");
             _DBGCOUT << oss.str() << std::endl;
+            return false;
         }
-    }
 #endif
+        return true;
+    });
 
     // Tuning library support
     currentScale = Tunings::evenTemperament12NoteScale();
@@ -556,7 +601,7 @@ SurgeStorage::SurgeStorage(const SurgeStorage::SurgeStorageConfig &config) : oth
             {
                 Surge::MSEG::createInitVoiceMSEG(ms);
             }
-            Surge::MSEG::rebuildCache(ms);
+            Surge::MSEG::rebuildCache(ms, msegBakedLookup);
         }
     }
 
@@ -588,6 +633,8 @@ SurgeStorage::SurgeStorage(const SurgeStorage::SurgeStorageConfig &config) : oth
         Surge::Storage::getUserDefaultValue(this, Surge::Storage::OSCPortOut, DEFAULT_OSC_PORT_OUT);
     oscOutIP =
         Surge::Storage::getUserDefaultValue(this, Surge::Storage::OSCIPOut, DEFAULT_OSC_IPADDR_OUT);
+    oscSchedulingLatencyMs = Surge::Storage::getUserDefaultValue(
+        this, Surge::Storage::OSCSchedulingLatency, DEFAULT_OSC_SCHEDULING_LATENCY_MS);
 
     initPatchName =
         Surge::Storage::getUserDefaultValue(this, Surge::Storage::InitialPatchName, "Init Saw");
@@ -598,8 +645,11 @@ SurgeStorage::SurgeStorage(const SurgeStorage::SurgeStorageConfig &config) : oth
 
     try
     {
+        // Storages which don't scan the libraries (the FX plugin, headless use) scan the FX
+        // presets when a menu first asks for them instead of parsing every one at construction
         fxUserPreset = std::make_unique<Surge::Storage::FxUserPreset>();
-        fxUserPreset->doPresetRescan(this);
+        if (loadWtAndPatch)
+            fxUserPreset->doPresetRescan(this);
     }
     catch (fs::filesystem_error &e)
     {
@@ -618,6 +668,14 @@ SurgeStorage::SurgeStorage(const SurgeStorage::SurgeStorageConfig &config) : oth
     memoryPools = std::make_unique<Surge::Memory::SurgeMemoryPools>(this);
 }
 
+AirWindowsSubFXBuilder *SurgeStorage::getAirWindowsBuilder()
+{
+    std::call_once(airWindowsBuilderOnce, [this]() {
+        airWindowsBuilder = std::make_unique<AirWindowsSubFXBuilder>(this);
+    });
+    return airWindowsBuilder.get();
+}
+
 void SurgeStorage::createUserDirectory()
 {
     auto p = userDataPath;
@@ -2024,6 +2082,8 @@ void SurgeStorage::clipboard_paste(
             }
         }
 
+        getPatch().markAllParametersChanged();
+
         if (type & cp_osc)
         {
             if (uses_wavetabledata(getPatch().scene[scene].osc[entry].type.val.i))
@@ -2383,6 +2443,9 @@ void SurgeStorage::load_midi_controllers()
 
 SurgeStorage::~SurgeStorage()
 {
+    // A build reads storage, so stop the builder before anything else goes
+    airWindowsBuilder.reset();
+
 #ifndef SURGE_SKIP_ODDSOUND_MTS
     if (oddsound_mts_active_as_main)
         disconnect_as_oddsound_main();
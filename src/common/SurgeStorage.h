@@ -841,6 +841,18 @@ struct MSEGStorage
     float durationToLoopEnd;
     float durationLoopStartToLoopEnd;
     float envelopeModeDuration = -1, envelopeModeNV1 = -2; // -2 as sentinel since NV1 is -1/1
+    // Each segment starts at or after the end of the one before, so lookups can binary search
+    bool segmentsOrdered = false;
+
+    /*
+     * An LFO mode shape with no Brownian segments and no envelope retriggers is a pure function
+     * of phase, so rebuildCache bakes it into this table and valueAt reads it back with linear
+     * interpolation when SurgeStorage::msegBakedLookup is set. The table holds the undeformed
+     * shape and is only read while deform is zero or no segment uses deform.
+     */
+    static constexpr int bakedLookupSize = 1024;
+    bool bakedLookupValid = false, bakedLookupUsesDeform = false;
+    std::array<float, bakedLookupSize + 1> bakedLookup{};
 
     /*
      * These "UI" type things we decided, late in 1.8, are actually a critical part of
@@ -971,6 +983,9 @@ struct DAWExtraStateStorage
             float noise_floor = 0.f;
             float max_db = 1.f;
             float decay_rate = 1.f;
+            int fft_order = 13;    // log2 of the FFT size, 10 (1k) to 15 (32k).
+            int fft_overlap = 1;   // 0%, 50%, 75% or 87.5%.
+            int fft_averaging = 0; // 1, 2, 4 or 8 frames.
         } oscilloscopeOverlayState;
 
         struct TuningOverlayState
@@ -1035,6 +1050,38 @@ class SurgePatch
     void copy_scenedata(pdata *, pdata *, int scene);
     void copy_globaldata(pdata *);
 
+    /*
+     * Parameter change journal. When SurgeStorage::deltaParamCopy is set, copy_globaldata and
+     * copy_scenedata only refresh the slots which were marked here and the slots some modulation
+     * landed on last block. Anything which writes a patch Parameter's val outside of a patch load
+     * has to mark it once the write is done: setParameter01, the control smoothers and the
+     * editor's direct edits mark the ids they change. Paths which rewrite many parameters at
+     * once (patch, FX and oscillator loads, update_controls, pastes and presets) call
+     * markAllParametersChanged instead, and the next block copies every range in full.
+     */
+    void markParameterChanged(int id)
+    {
+        if (id < 0 || id >= n_total_params)
+            return;
+        changedParams[id >> 6].fetch_or((uint64_t)1 << (id & 63));
+    }
+    void markAllParametersChanged()
+    {
+        fullCopyPending = ~0U;
+    }
+    void markParameterModulated(int id)
+    {
+        modulatedParams[id >> 6] |= (uint64_t)1 << (id & 63);
+    }
+
+    static constexpr int journalWords = (n_total_params + 63) / 64;
+    std::array<std::atomic<uint64_t>, journalWords> changedParams{};
+    // One bit per range, global then each scene
+    std::atomic<uint32_t> fullCopyPending{~0U};
+    // Only touched by the audio thread. refreshedParams is what the last copy of a range rewrote
+    std::array<uint64_t, journalWords> modulatedParams{};
+    std::array<uint64_t, journalWords> refreshedParams{};
+
     // load/save
     // void load_xml();
     // void save_xml();
@@ -1176,6 +1223,7 @@ enum surge_copysource
 };
 
 class MTSClient;
+struct AirWindowsSubFXBuilder;
 
 /* storage layer */
 
@@ -1226,7 +1274,8 @@ class alignas(16) SurgeStorage
     // this will be a pointer to an aligned 2 x BLOCK_SIZE_OS array
     float audio_otherscene alignas(16)[2][BLOCK_SIZE_OS];
 
-    std::unique_ptr<sst::basic_blocks::tables::SurgeSincTableProvider> sincTableProvider;
+    // The sinc tables are read only once built, so every SurgeStorage in the process shares one
+    std::shared_ptr<sst::basic_blocks::tables::SurgeSincTableProvider> sincTableProvider;
     float *sinctable, *sinctable1X;
     int16_t *sinctableI16;
 
@@ -1448,7 +1497,8 @@ class alignas(16) SurgeStorage
 
     std::mutex waveTableDataMutex;
     std::recursive_mutex modRoutingMutex;
-    Wavetable WindowWT;
+    // Loaded once and never written after, so like the sinc tables it is shared process wide
+    std::shared_ptr<Wavetable> WindowWT;
 
     // hardclip
     enum HardClipMode
@@ -1459,6 +1509,18 @@ class alignas(16) SurgeStorage
     } hardclipMode = HARDCLIP_TO_18DBFS,
       sceneHardclipMode[n_scenes] = {HARDCLIP_TO_18DBFS, HARDCLIP_TO_18DBFS};
 
+    /*
+     * The voice path always runs at OSC_OVERSAMPLING times the host rate; that is compiled in.
+     * What we can pick per instance is how hard the halfband filters which come back down from
+     * (and, for audio input, go up to) that rate work. Eco is a short, gentle filter which is
+     * noticeably cheaper and lets a little more alias through near Nyquist.
+     */
+    enum DecimationQuality
+    {
+        DECIMATION_ECO = 0,
+        DECIMATION_STANDARD = 1
+    } decimationQuality = DECIMATION_STANDARD;
+
     void loadTuningFromSCL(const fs::path &p);
     void loadMappingFromKBM(const fs::path &p);
     std::function<void()> onTuningChanged{nullptr};
@@ -1515,6 +1577,8 @@ class alignas(16) SurgeStorage
     bool oscStartIn{false};
     bool oscStartOut{false};
     bool echoMIDIctrlToOSC{true}; // This may be made UI- or OSC-switchable in future
+    // Delay applied to timetagged OSC bundles before they land in the audio stream
+    std::atomic<int> oscSchedulingLatencyMs{DEFAULT_OSC_SCHEDULING_LATENCY_MS};
 
     static constexpr double MIDI_0_FREQ = Tunings::MIDI_0_FREQ;
     // this value needs to be passed along to FilterCoefficientMaker
@@ -1668,6 +1732,28 @@ class alignas(16) SurgeStorage
         return res;
     }
 
+    // When set, effects and idle scenes stop processing as soon as their output has stayed under
+    // fxTailThreshold (linear) for a short hold, instead of after a fixed ringout
+    bool fxMeasuredTail{false};
+    float fxTailThreshold{1.5849e-5f}; // -96 dB
+
+    // Let MSEG LFOs read the table baked by MSEG::rebuildCache instead of evaluating segments
+    bool msegBakedLookup{false};
+
+    // Apply timed host parameter events (CLAP) at the value their automation line has at the end
+    // of the block, which is where the per block parameter smoothing arrives. This is accurate to
+    // the block, not the sample: an event's offset only moves the block end value, and nothing
+    // inside the block ramps toward it any sooner
+    bool blockEndAutomation{false};
+
+    // Refresh globaldata and scenedata from the parameter change journal (see
+    // SurgePatch::markParameterChanged) instead of copying every parameter each block
+    bool deltaParamCopy{false};
+
+    // When non zero, note ons past this much voice start time in one block wait for the next
+    // block (see SurgeSynthesizer::deferredNotes)
+    int64_t voiceStartBudgetNs{0};
+
     Modulator::SmoothingMode smoothingMode = Modulator::SmoothingMode::LEGACY;
     Modulator::SmoothingMode pitchSmoothingMode = Modulator::SmoothingMode::LEGACY;
     float mpePitchBendRange = -1.0f;
@@ -1708,6 +1794,11 @@ class alignas(16) SurgeStorage
     static bool skipLoadWtAndPatch;
 
     std::unique_ptr<Surge::Memory::SurgeMemoryPools> memoryPools;
+    // Builds Airwindows processors off the audio thread. Made by the first Airwindows effect,
+    // so a storage which never has one never starts its thread
+    std::unique_ptr<AirWindowsSubFXBuilder> airWindowsBuilder;
+    std::once_flag airWindowsBuilderOnce;
+    AirWindowsSubFXBuilder *getAirWindowsBuilder();
 
 /*
  * An RNG which is decoupled from the non-Surge global state and is threadsafe.
@@ -30,6 +30,7 @@
 #include "UserDefaults.h"
 #include "filesystem/import.h"
 #include "Effect.h"
+#include "FXWorkerPool.h"
 #include "globals.h"
 
 #include <algorithm>
@@ -55,7 +56,8 @@ using CMSKey = ControllerModulationSourceVector<1>; // sigh see #4286 for failed
 SurgeSynthesizer::SurgeSynthesizer(PluginLayer *parent, const std::string &suppliedDataPath)
     : storage(suppliedDataPath), hpA{cutl::make_array<BiquadFilter, n_hpBQ>(&storage)},
       hpB{cutl::make_array<BiquadFilter, n_hpBQ>(&storage)}, _parent(parent), halfbandA(6, true),
-      halfbandB(6, true), halfbandIN(6, true), mpeEnabled(storage.mpeEnabled)
+      halfbandB(6, true), halfbandIN(6, true), halfbandOutgoingA(6, true),
+      halfbandOutgoingB(6, true), halfbandOutgoingIN(6, true), mpeEnabled(storage.mpeEnabled)
 {
     switch_toggled_queued = false;
     audio_processing_active = false;
@@ -92,7 +94,7 @@ SurgeSynthesizer::SurgeSynthesizer(PluginLayer *parent, const std::string &suppl
     memset(storage.getPatch().scenedataOrig[1], 0, sizeof(pdata) * n_scene_params);
 
     memset(storage.getPatch().globaldata, 0, sizeof(pdata) * n_global_params);
-    memset(mControlInterpolatorUsed, 0, sizeof(bool) * num_controlinterpolators);
+    ResetControlInterpolators();
 
     for (int i = 0; i < n_fx_slots; i++)
     {
@@ -121,6 +123,24 @@ SurgeSynthesizer::SurgeSynthesizer(PluginLayer *parent, const std::string &suppl
 
     SurgePatch &patch = storage.getPatch();
 
+    setFXWorkerThreads(
+        Surge::Storage::getUserDefaultValue(&storage, Surge::Storage::FXWorkerThreads, 0));
+
+    storage.fxMeasuredTail =
+        Surge::Storage::getUserDefaultValue(&storage, Surge::Storage::FXMeasuredTail, 0);
+    storage.fxTailThreshold = storage.db_to_linear(
+        Surge::Storage::getUserDefaultValue(&storage, Surge::Storage::FXTailThresholdDB, -96));
+    storage.msegBakedLookup =
+        Surge::Storage::getUserDefaultValue(&storage, Surge::Storage::MSEGBakedLookup, 0);
+    storage.blockEndAutomation =
+        Surge::Storage::getUserDefaultValue(&storage, Surge::Storage::BlockEndAutomation, 0);
+    storage.deltaParamCopy =
+        Surge::Storage::getUserDefaultValue(&storage, Surge::Storage::DeltaParamCopy, 0);
+    storage.voiceStartBudgetNs =
+        (int64_t)Surge::Storage::getUserDefaultValue(
+            &storage, Surge::Storage::VoiceStartBudgetMicroseconds, 0) *
+        1000;
+
     storage.smoothingMode = (Modulator::SmoothingMode)(int)Surge::Storage::getUserDefaultValue(
         &storage, Surge::Storage::SmoothingMode, (int)(Modulator::SmoothingMode::LEGACY));
     storage.pitchSmoothingMode = (Modulator::SmoothingMode)(int)Surge::Storage::getUserDefaultValue(
@@ -251,7 +271,6 @@ SurgeSynthesizer::SurgeSynthesizer(PluginLayer *parent, const std::string &suppl
     for (int i = 0; i < 8; i++)
     {
         refresh_ctrl_queue[i] = -1;
-        refresh_parameter_queue[i] = -1;
     }
 
     for (int i = 0; i < 8; i++)
@@ -299,6 +318,9 @@ SurgeSynthesizer::SurgeSynthesizer(PluginLayer *parent, const std::string &suppl
 
     patchid_queue = -1;
     has_patchid_file = false;
+
+    // The voices never grow the oscillator slots, so give the init patch its share now
+    storage.memoryPools->resetAllPools(&storage);
 }
 
 SurgeSynthesizer::~SurgeSynthesizer()
@@ -446,12 +468,14 @@ void SurgeSynthesizer::playNote(char channel, char key, char velocity, char detu
         if (sm == scene_mode::sm_split)
         {
             storage.getPatch().param_ptr[learn_param_from_note]->val.i = key;
+            storage.getPatch().markParameterChanged(learn_param_from_note);
             refresh_editor = true;
         }
 
         if (sm == scene_mode::sm_chsplit)
         {
             storage.getPatch().param_ptr[learn_param_from_note]->val.i = channel * 8;
+            storage.getPatch().markParameterChanged(learn_param_from_note);
             refresh_editor = true;
         }
 
@@ -460,6 +484,23 @@ void SurgeSynthesizer::playNote(char channel, char key, char velocity, char detu
         return;
     }
 
+    // Only notes which would play wait for the budget, so the checks above see them straight away
+    if (storage.voiceStartBudgetNs > 0 && !startingDeferredNotes &&
+        (deferredNoteCount > 0 || voiceStartNsThisBlock >= storage.voiceStartBudgetNs) &&
+        deferredNoteCount < maxDeferredNotes)
+    {
+        auto &dn = deferredNotes[deferredNoteCount++];
+        dn = DeferredNote();
+        dn.channel = channel;
+        dn.key = key;
+        dn.velocity = velocity;
+        dn.detune = detune;
+        dn.host_noteid = host_noteid;
+        dn.forceScene = forceScene;
+        voiceStartStats.deferred++;
+        return;
+    }
+
     midiNoteEvents++;
 
     if (!storage.isStandardTuning)
@@ -481,6 +522,8 @@ void SurgeSynthesizer::playNote(char channel, char key, char velocity, char detu
     if (forceScene == 1)
         channelmask = 2;
 
+    auto voiceStart = std::chrono::high_resolution_clock::now();
+
     // TODO: FIX SCENE ASSUMPTION
     if (channelmask & 1)
     {
@@ -493,6 +536,25 @@ void SurgeSynthesizer::playNote(char channel, char key, char velocity, char detu
         playVoice(1, channel, key, velocity, detune, host_noteid);
     }
 
+    if (channelmask & 3)
+    {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::high_resolution_clock::now() - voiceStart)
+                      .count();
+        auto &st = voiceStartStats;
+        st.notes++;
+        st.totalNs += ns;
+        st.maxNs = std::max(st.maxNs, (int64_t)ns);
+
+        int bucket = 0;
+        while (bucket < (int)st.histogram.size() - 1 && ns >= (1000LL << bucket))
+            bucket++;
+        st.histogram[bucket]++;
+
+        voiceStartNsThisBlock += ns;
+        st.maxBlockNs = std::max(st.maxBlockNs, voiceStartNsThisBlock);
+    }
+
     channelState[channel].keyState[key].keystate = velocity;
     channelState[channel].keyState[key].lastdetune = detune;
     channelState[channel].keyState[key].lastNoteIdForKey = host_noteid;
@@ -529,6 +591,71 @@ void SurgeSynthesizer::playNote(char channel, char key, char velocity, char detu
     }
 }
 
+void SurgeSynthesizer::startDeferredNotes()
+{
+    startingDeferredNotes = true;
+
+    int started = 0;
+    while (started < deferredNoteCount &&
+           (started == 0 || voiceStartNsThisBlock < storage.voiceStartBudgetNs))
+    {
+        auto dn = deferredNotes[started++];
+        playNote(dn.channel, dn.key, dn.velocity, dn.detune, dn.host_noteid, dn.forceScene);
+        if (dn.released)
+            releaseNote(dn.channel, dn.key, dn.releaseVelocity, dn.host_noteid);
+    }
+
+    std::copy(deferredNotes.begin() + started, deferredNotes.begin() + deferredNoteCount,
+              deferredNotes.begin());
+    deferredNoteCount -= started;
+
+    startingDeferredNotes = false;
+}
+
+bool SurgeSynthesizer::releaseDeferredNote(int channel, int key, char velocity, int32_t host_noteid,
+                                           bool choke)
+{
+    bool found = false;
+    int kept = 0;
+    for (int i = 0; i < deferredNoteCount; ++i)
+    {
+        auto &dn = deferredNotes[i];
+        bool matches = !dn.released && (dn.channel == channel || channel < 0) &&
+                       (dn.key == key || key < 0) &&
+                       (host_noteid < 0 || dn.host_noteid == host_noteid);
+
+        if (matches)
+        {
+            found = true;
+            if (choke)
+            {
+                if (dn.host_noteid >= 0)
+                    notifyEndedNote(dn.host_noteid, dn.key, dn.channel);
+                continue;
+            }
+
+            dn.released = true;
+            dn.releaseVelocity = velocity;
+        }
+
+        deferredNotes[kept++] = dn;
+    }
+    deferredNoteCount = kept;
+
+    return found;
+}
+
+void SurgeSynthesizer::clearDeferredNotes()
+{
+    for (int i = 0; i < deferredNoteCount; ++i)
+    {
+        auto &dn = deferredNotes[i];
+        if (dn.host_noteid >= 0)
+            notifyEndedNote(dn.host_noteid, dn.key, dn.channel);
+    }
+    deferredNoteCount = 0;
+}
+
 // This supports an OSC message that specifies pitch by frequency (rather than by MIDI note number)
 void SurgeSynthesizer::playNoteByFrequency(float freq, char velocity, int32_t id)
 {
@@ -1188,14 +1315,24 @@ void SurgeSynthesizer::releaseScene(int s)
             hpB[i].suspend();
     }
     if (s == 0)
+    {
         halfbandA.reset();
+        halfbandOutgoingA.reset();
+    }
     if (s == 1)
+    {
         halfbandB.reset();
+        halfbandOutgoingB.reset();
+    }
     halfbandIN.reset();
+    halfbandOutgoingIN.reset();
 }
 
 void SurgeSynthesizer::chokeNote(int16_t channel, int16_t key, char velocity, int32_t host_noteid)
 {
+    if (deferredNoteCount > 0)
+        releaseDeferredNote(channel, key, velocity, host_noteid, true);
+
     /*
      * The strategy here is pretty simple. Do a release note, then go find any voice
      * that matches me and do an uber-release. There may be some wierdo MPE mono
@@ -1218,6 +1355,12 @@ void SurgeSynthesizer::chokeNote(int16_t channel, int16_t key, char velocity, in
 
 void SurgeSynthesizer::releaseNote(char channel, char key, char velocity, int32_t host_noteid)
 {
+    if (deferredNoteCount > 0 && !startingDeferredNotes &&
+        releaseDeferredNote(channel, key, velocity, host_noteid, false))
+    {
+        return;
+    }
+
     midiNoteEvents++;
     bool foundVoice[n_scenes];
     for (int sc = 0; sc < n_scenes; ++sc)
@@ -1811,6 +1954,9 @@ void SurgeSynthesizer::releaseNotePostHoldCheck(int scene, char channel, char ke
 
 void SurgeSynthesizer::releaseNoteByHostNoteID(int32_t host_noteid, char velocity)
 {
+    if (deferredNoteCount > 0 && host_noteid >= 0)
+        releaseDeferredNote(-1, -1, velocity, host_noteid, false);
+
     std::array<uint16_t, 128> done;
     std::fill(done.begin(), done.end(), 0);
 
@@ -2440,6 +2586,9 @@ void SurgeSynthesizer::allSoundOff()
 
 void SurgeSynthesizer::allNotesOff()
 {
+    // Notes still waiting to start never made a sound
+    clearDeferredNotes();
+
     /*
      * For now, until we move to a sightly less delicate voice manager,
      * do two things here. First run over all the keys we have pressed. Then
@@ -2572,6 +2721,8 @@ void SurgeSynthesizer::purgeDuplicateHeldVoicesInPolyMode(int scene, int channel
 
 void SurgeSynthesizer::stopSound()
 {
+    clearDeferredNotes();
+
     for (int i = 0; i < 16; i++)
     {
         channelState[i].hold = false;
@@ -2598,6 +2749,7 @@ void SurgeSynthesizer::stopSound()
     halfbandA.reset();
     halfbandB.reset();
     halfbandIN.reset();
+    halfbandFadePosition = halfbandFadeBlocks;
 
     for (int i = 0; i < n_hpBQ; i++)
     {
@@ -2613,7 +2765,7 @@ void SurgeSynthesizer::stopSound()
         }
     }
 
-    memset(mControlInterpolatorUsed, 0, sizeof(bool) * num_controlinterpolators);
+    ResetControlInterpolators();
 }
 
 void SurgeSynthesizer::setSamplerate(float sr)
@@ -2640,31 +2792,59 @@ void SurgeSynthesizer::setSamplerate(float sr)
 
 //-------------------------------------------------------------------------------------------------
 
-int SurgeSynthesizer::GetFreeControlInterpolatorIndex()
+void SurgeSynthesizer::ResetControlInterpolators()
 {
+    mControlInterpolatorIndex.fill(-1);
+    mControlInterpolatorActiveCount = 0;
+    mControlInterpolatorFreeCount = num_controlinterpolators;
+
+    // Hand out slot 0 first
     for (int i = 0; i < num_controlinterpolators; i++)
     {
-        if (!mControlInterpolatorUsed[i])
-        {
-            return i;
-        }
+        mControlInterpolatorFree[i] = num_controlinterpolators - 1 - i;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+
+int SurgeSynthesizer::GetFreeControlInterpolatorIndex()
+{
+    if (mControlInterpolatorFreeCount == 0)
+    {
+        assert(0);
+        return -1;
     }
-    assert(0);
-    return -1;
+
+    return mControlInterpolatorFree[mControlInterpolatorFreeCount - 1];
 }
 
 //-------------------------------------------------------------------------------------------------
 
 int SurgeSynthesizer::GetControlInterpolatorIndex(int Id)
 {
-    for (int i = 0; i < num_controlinterpolators; i++)
+    if (Id < 0 || Id >= n_total_params)
     {
-        if (mControlInterpolatorUsed[i] && mControlInterpolator[i].id == Id)
-        {
-            return i;
-        }
+        return -1;
     }
-    return -1;
+
+    return mControlInterpolatorIndex[Id];
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void SurgeSynthesizer::ReleaseControlInterpolatorSlot(int Index)
+{
+    assert(Index >= 0 && Index < num_controlinterpolators);
+
+    mControlInterpolatorIndex[mControlInterpolator[Index].id] = -1;
+
+    // Swap the last live slot into this one's place in the active list
+    int pos = mControlInterpolatorActivePos[Index];
+    int last = mControlInterpolatorActive[--mControlInterpolatorActiveCount];
+    mControlInterpolatorActive[pos] = last;
+    mControlInterpolatorActivePos[last] = pos;
+
+    mControlInterpolatorFree[mControlInterpolatorFreeCount++] = Index;
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -2674,8 +2854,7 @@ void SurgeSynthesizer::ReleaseControlInterpolator(int Id)
     int Index = GetControlInterpolatorIndex(Id);
     if (Index >= 0)
     {
-        assert(Index < num_controlinterpolators);
-        mControlInterpolatorUsed[Index] = false;
+        ReleaseControlInterpolatorSlot(Index);
     }
 }
 
@@ -2707,13 +2886,22 @@ ControllerModulationSource *SurgeSynthesizer::AddControlInterpolator(int Id, boo
         return &mControlInterpolator[Index];
     }
 
+    if (Id < 0 || Id >= n_total_params)
+    {
+        return nullptr;
+    }
+
     Index = GetFreeControlInterpolatorIndex();
 
     if (Index >= 0)
     {
         // Add new
+        mControlInterpolatorFreeCount--;
+        mControlInterpolatorIndex[Id] = Index;
+        mControlInterpolatorActivePos[Index] = mControlInterpolatorActiveCount;
+        mControlInterpolatorActive[mControlInterpolatorActiveCount++] = Index;
+
         mControlInterpolator[Index].id = Id;
-        mControlInterpolatorUsed[Index] = true;
 
         mControlInterpolator[Index].set_samplerate(storage.samplerate, storage.samplerate_inv);
         mControlInterpolator[Index].smoothingMode = storage.smoothingMode; // IMPLEMENT THIS HERE
@@ -2760,6 +2948,7 @@ bool SurgeSynthesizer::setParameter01(long index, float value, bool external, bo
         oldval.i = storage.getPatch().param_ptr[index]->val.i;
 
         storage.getPatch().param_ptr[index]->set_value_f01(value, force_integer);
+        storage.getPatch().markParameterChanged(index);
 
         {
             auto p = storage.getPatch().param_ptr[index];
@@ -2861,6 +3050,7 @@ bool SurgeSynthesizer::setParameter01(long index, float value, bool external, bo
                     subp->val.i = 0;
                 else
                     subp->val.i = std::min(maxIVal - 1, subp->val.i);
+                storage.getPatch().markParameterChanged(index);
                 storage.subtypeMemory[subp->scene - 1][subp->ctrlgroup_entry][filterType] =
                     subp->val.i;
 
@@ -2959,6 +3149,10 @@ bool SurgeSynthesizer::setParameter01(long index, float value, bool external, bo
         };
     }
 
+    // Whatever needs the editor refreshed may also have rewritten neighbouring parameters
+    if (need_refresh)
+        storage.getPatch().markAllParametersChanged();
+
     if (external && !need_refresh)
     {
         queueForRefresh(index);
@@ -2968,18 +3162,10 @@ bool SurgeSynthesizer::setParameter01(long index, float value, bool external, bo
 
 void SurgeSynthesizer::queueForRefresh(int param_index)
 {
-    bool got = false;
-    for (int i = 0; i < 8; i++)
-    {
-        if (refresh_parameter_queue[i] < 0 || refresh_parameter_queue[i] == param_index)
-        {
-            refresh_parameter_queue[i] = param_index;
-            got = true;
-            break;
-        }
-    }
-    if (!got)
-        refresh_overflow = true;
+    if (param_index < 0 || param_index >= n_total_params)
+        return;
+
+    refreshParameterQueue.push(param_index);
 }
 
 void SurgeSynthesizer::switch_toggled()
@@ -3179,6 +3365,9 @@ bool SurgeSynthesizer::loadFx(bool initp, bool force_reload_all)
         {
             fx[s]->updateAfterReload();
         }
+
+        if (something_changed)
+            storage.getPatch().markAllParametersChanged();
     }
 
     if (!force_reload_all)
@@ -3212,16 +3401,16 @@ bool SurgeSynthesizer::loadOscalgos()
                     clear_osc_modulation(s, i);
                 }
 
+                auto new_type = osc_st.queue_type;
+                osc_st.type.val.i = new_type;
+                storage.getPatch().update_controls(false, &osc_st);
+
                 // Notify audio thread param change listeners (OSC, e.g.)
                 // (which run on juce messenger thread)
-                std::stringstream sb;
-                sb << "/param/" << (char)('a' + s) << "/osc/" << i + 1 << "/type";
-                auto new_type = osc_st.queue_type;
                 for (const auto &it : audioThreadParamListeners)
-                    (it.second)(sb.str(), new_type, osc_type_names[new_type]);
+                    (it.second)(osc_st.type.oscName, osc_st.type.get_value_f01(),
+                                osc_type_names[new_type]);
 
-                osc_st.type.val.i = osc_st.queue_type;
-                storage.getPatch().update_controls(false, &osc_st);
                 osc_st.queue_type = -1;
                 switch_toggled_queued = true;
                 refresh_editor = true;
@@ -3242,6 +3431,8 @@ bool SurgeSynthesizer::loadOscalgos()
                     int j;
                     std::string lbl;
 
+                    bool loaded = false;
+
                     lbl = fmt::format("p{:d}", k);
 
                     if (osc_st.p[k].valtype == vt_float)
@@ -3249,8 +3440,7 @@ bool SurgeSynthesizer::loadOscalgos()
                         if (e->QueryDoubleAttribute(lbl.c_str(), &d) == TIXML_SUCCESS)
                         {
                             osc_st.p[k].val.f = (float)d;
-                            for (const auto &it : audioThreadParamListeners)
-                                (it.second)(oname, d, sx);
+                            loaded = true;
                         }
                     }
                     else
@@ -3258,8 +3448,7 @@ bool SurgeSynthesizer::loadOscalgos()
                         if (e->QueryIntAttribute(lbl.c_str(), &j) == TIXML_SUCCESS)
                         {
                             osc_st.p[k].val.i = j;
-                            for (const auto &it : audioThreadParamListeners)
-                                (it.second)(oname, j, sx);
+                            loaded = true;
                         }
                     }
 
@@ -3268,8 +3457,7 @@ bool SurgeSynthesizer::loadOscalgos()
                     if (e->QueryIntAttribute(lbl.c_str(), &j) == TIXML_SUCCESS)
                     {
                         osc_st.p[k].deform_type = j;
-                        for (const auto &it : audioThreadParamListeners)
-                            (it.second)(oname, j, sx);
+                        loaded = true;
                     }
 
                     lbl = fmt::format("p{:d}_extend_range", k);
@@ -3277,8 +3465,15 @@ bool SurgeSynthesizer::loadOscalgos()
                     if (e->QueryIntAttribute(lbl.c_str(), &j) == TIXML_SUCCESS)
                     {
                         osc_st.p[k].set_extend_range(j);
+                        loaded = true;
+                    }
+
+                    // Listeners get the normalized value, once the deform and extend flags
+                    // which change what it means are in place
+                    if (loaded)
+                    {
                         for (const auto &it : audioThreadParamListeners)
-                            (it.second)(oname, j, sx);
+                            (it.second)(oname, osc_st.p[k].get_value_f01(), sx);
                     }
                 }
 
@@ -3286,11 +3481,10 @@ bool SurgeSynthesizer::loadOscalgos()
                 if (e->QueryIntAttribute("retrigger", &rt) == TIXML_SUCCESS)
                 {
                     osc_st.retrigger.val.b = rt;
-                    std::stringstream sb;
-                    sb << "/param/" << (char)('a' + s) << "/osc/" << i + 1 << "/retrigger";
                     std::string sx = rt > 0 ? "On" : "Off";
                     for (const auto &it : audioThreadParamListeners)
-                        (it.second)(sb.str(), rt, sx);
+                        (it.second)(osc_st.retrigger.oscName, osc_st.retrigger.get_value_f01(),
+                                    sx);
                 }
 
                 /*
@@ -3301,12 +3495,14 @@ bool SurgeSynthesizer::loadOscalgos()
                     refresh_editor = true;
                 }
                 osc_st.queue_xmldata = 0;
+                storage.getPatch().markAllParametersChanged();
             }
         }
     }
 
     if (algosChanged)
     {
+        storage.getPatch().markAllParametersChanged();
         storage.memoryPools->resetOscillatorPools(&storage);
         for (int s = 0; s < n_scenes; ++s)
         {
@@ -3725,6 +3921,8 @@ void SurgeSynthesizer::applyParameterMonophonicModulation(Parameter *p, float de
                 pt.monophonicParamModulations[i].value = depth;
                 break;
             }
+            // so the slot is refreshed before the new depth goes on
+            pt.markParameterChanged(p->id);
             return;
         }
     }
@@ -3749,6 +3947,7 @@ void SurgeSynthesizer::applyParameterMonophonicModulation(Parameter *p, float de
         break;
     }
     pt.paramModulationCount++;
+    pt.markParameterChanged(p->id);
     return;
 }
 
@@ -4366,19 +4565,19 @@ void SurgeSynthesizer::processControl()
         release_anyway[1] = false;
     }
 
-    // interpolate MIDI controllers
-    for (int i = 0; i < num_controlinterpolators; i++)
+    // interpolate MIDI controllers. Walk the active list backwards so releasing a slot, which
+    // swaps the last entry into its place, doesn't skip anything
+    for (int a = mControlInterpolatorActiveCount - 1; a >= 0; a--)
     {
-        if (mControlInterpolatorUsed[i])
+        int i = mControlInterpolatorActive[a];
+        ControllerModulationSource *mc = &mControlInterpolator[i];
+        bool cont = mc->process_block_until_close(0.001f);
+        int id = mc->id;
+        storage.getPatch().param_ptr[id]->set_value_f01(mc->get_output(0));
+        storage.getPatch().markParameterChanged(id);
+        if (!cont)
         {
-            ControllerModulationSource *mc = &mControlInterpolator[i];
-            bool cont = mc->process_block_until_close(0.001f);
-            int id = mc->id;
-            storage.getPatch().param_ptr[id]->set_value_f01(mc->get_output(0));
-            if (!cont)
-            {
-                mControlInterpolatorUsed[i] = false;
-            }
+            ReleaseControlInterpolatorSlot(i);
         }
     }
 
@@ -4489,6 +4688,16 @@ void SurgeSynthesizer::processControl()
 
     loadOscalgos();
 
+    // A voice which found no oscillator slot (a type pasted in since the last sizing) gets one
+    // once the pools match the patch, when switch_toggled below has it try again
+    auto slotMisses = storage.memoryPools->oscillatorSlots.slotMisses();
+    if (slotMisses != oscillatorSlotMissesSeen)
+    {
+        oscillatorSlotMissesSeen = slotMisses;
+        storage.memoryPools->resetOscillatorPools(&storage);
+        switch_toggled_queued = true;
+    }
+
     int n = storage.getPatch().modulation_global.size();
     for (int i = 0; i < n; i++)
     {
@@ -4591,6 +4800,10 @@ void SurgeSynthesizer::process()
 
     float mfade = 1.f;
 
+    // A change which arrives mid crossfade waits for it to finish
+    if (storage.decimationQuality != halfbandQuality && halfbandFadePosition >= halfbandFadeBlocks)
+        updateHalfbandQuality();
+
     if (halt_engine)
     {
         mech::clear_block<BLOCK_SIZE>(output[0]);
@@ -4638,6 +4851,10 @@ void SurgeSynthesizer::process()
         }
     }
 
+    voiceStartNsThisBlock = 0;
+    if (deferredNoteCount > 0)
+        startDeferredNotes();
+
     // process inputs (upsample & halfrate)
     if (process_input)
     {
@@ -4645,8 +4862,7 @@ void SurgeSynthesizer::process()
         sdsp::hardclip_block8<BLOCK_SIZE>(input[1]);
         mech::copy_from_to<BLOCK_SIZE>(input[0], storage.audio_in_nonOS[0]);
         mech::copy_from_to<BLOCK_SIZE>(input[1], storage.audio_in_nonOS[1]);
-        halfbandIN.process_block_U2(input[0], input[1], storage.audio_in[0], storage.audio_in[1],
-                                    BLOCK_SIZE_OS);
+        processHalfbandU2();
     }
     else
     {
@@ -4720,6 +4936,27 @@ void SurgeSynthesizer::process()
     for (int s = 0; s < n_scenes; s++)
     {
         FBentry[s] = 0;
+
+        if (SurgeVoice::canBatchEnvelopes(&storage, s))
+        {
+            SurgeVoice *batch[4];
+            int nb = 0;
+
+            for (auto *v : voices[s])
+            {
+                batch[nb++] = v;
+
+                if (nb == 4)
+                {
+                    SurgeVoice::processEnvelopesBatch(batch, nb);
+                    nb = 0;
+                }
+            }
+
+            if (nb > 0)
+                SurgeVoice::processEnvelopesBatch(batch, nb);
+        }
+
         iter = voices[s].begin();
         while (iter != voices[s].end())
         {
@@ -4842,7 +5079,7 @@ void SurgeSynthesizer::process()
             break;
         }
 
-        halfbandA.process_block_D2(sceneout[0][0], sceneout[0][1], BLOCK_SIZE_OS);
+        processHalfbandD2(0);
     }
 
     if (play_scene[1])
@@ -4861,15 +5098,32 @@ void SurgeSynthesizer::process()
             break;
         }
 
-        halfbandB.process_block_D2(sceneout[1][0], sceneout[1][1], BLOCK_SIZE_OS);
+        processHalfbandD2(1);
     }
 
+    if (halfbandFadePosition < halfbandFadeBlocks)
+        halfbandFadePosition++;
+
     /*
      * ABOVE: Oversampled, Below, Regular sample. So BLOCK_SIZE_OS above BLOCK_SIZE below
      */
 
+    // With the measured tail on, a scene with no voices whose lowcut tail has died away has
+    // nothing left to filter
+    bool sceneIdle[n_scenes];
+    uint32_t sceneDormant = 0;
+    for (int sc = 0; sc < n_scenes; ++sc)
+    {
+        if (play_scene[sc] || !storage.fxMeasuredTail)
+            sceneQuietBlocks[sc] = 0;
+        sceneIdle[sc] = sceneQuietBlocks[sc] > sceneIdleHoldBlocks;
+        if (sceneIdle[sc])
+            sceneDormant |= 1U << sc;
+    }
+    sceneDormantMask.store(sceneDormant, std::memory_order_relaxed);
+
     // TODO: FIX SCENE ASSUMPTION
-    if (storage.getPatch().scene[0].lowcut.deactivated == false)
+    if (storage.getPatch().scene[0].lowcut.deactivated == false && !sceneIdle[0])
     {
         auto freq =
             storage.getPatch().scenedata[0][storage.getPatch().scene[0].lowcut.param_id_in_scene].f;
@@ -4883,7 +5137,7 @@ void SurgeSynthesizer::process()
         }
     }
 
-    if (storage.getPatch().scene[1].lowcut.deactivated == false)
+    if (storage.getPatch().scene[1].lowcut.deactivated == false && !sceneIdle[1])
     {
         auto freq =
             storage.getPatch().scenedata[1][storage.getPatch().scene[1].lowcut.param_id_in_scene].f;
@@ -4897,6 +5151,16 @@ void SurgeSynthesizer::process()
         }
     }
 
+    for (int sc = 0; sc < n_scenes; ++sc)
+    {
+        if (storage.fxMeasuredTail && !play_scene[sc] && !sceneIdle[sc])
+        {
+            auto peak = std::max(mech::blockAbsMax<BLOCK_SIZE>(sceneout[sc][0]),
+                                 mech::blockAbsMax<BLOCK_SIZE>(sceneout[sc][1]));
+            sceneQuietBlocks[sc] = (peak < storage.fxTailThreshold) ? sceneQuietBlocks[sc] + 1 : 0;
+        }
+    }
+
     for (int cls = 0; cls < n_scenes; ++cls)
     {
         switch (storage.sceneHardclipMode[cls])
@@ -4926,23 +5190,63 @@ void SurgeSynthesizer::process()
         for (int channel = 0; channel < N_OUTPUTS; channel++)
             storage.scenesOutputData.provideSceneData(i, channel, sceneout[i][channel]);
 
-    // apply insert effects
-    if (fx_bypass != fxb_no_fx)
+    /*
+     * The scene insert chains are independent of each other, as are the send effects, so with a
+     * worker pool each runs as its own task. Anything which can't run concurrently goes on this
+     * thread in the original order, and the send returns are summed below in slot order, so the
+     * result matches the serial path exactly.
+     */
+    struct FXTaskContext
     {
-        for (auto v : {fxslot_ains1, fxslot_ains2, fxslot_ains3, fxslot_ains4})
+        SurgeSynthesizer *synth;
+        bool *sc_state;
+        bool *sendused;
+        float (*fxsendout)[2][BLOCK_SIZE];
+        bool sendInputPresent;
+        int activeSends[n_send_slots];
+    } fxctx{this, sc_state, nullptr, fxsendout, false, {}};
+
+    auto activeFXMask = [this](std::initializer_list<int> slots, uint32_t &callerOnly, int bit) {
+        int active = 0;
+        for (auto v : slots)
         {
             if (fx[v] && !(storage.getPatch().fx_disable.val.i & (1 << v)))
             {
-                sc_state[0] = fx[v]->process_ringout(sceneout[0][0], sceneout[0][1], sc_state[0]);
+                active++;
+                if (!fx[v]->allowsConcurrentProcessing())
+                    callerOnly |= 1U << bit;
             }
         }
+        return active;
+    };
 
-        for (auto v : {fxslot_bins1, fxslot_bins2, fxslot_bins3, fxslot_bins4})
+    // apply insert effects
+    if (fx_bypass != fxb_no_fx)
+    {
+        uint32_t callerOnly = 0;
+        int chainsActive = 0;
+        // TODO: FIX SCENE ASSUMPTION
+        chainsActive +=
+            activeFXMask({fxslot_ains1, fxslot_ains2, fxslot_ains3, fxslot_ains4}, callerOnly, 0) >
+            0;
+        chainsActive +=
+            activeFXMask({fxslot_bins1, fxslot_bins2, fxslot_bins3, fxslot_bins4}, callerOnly, 1) >
+            0;
+
+        if (fxWorkerPool && chainsActive > 1 && callerOnly != 3)
+        {
+            fxWorkerPool->run(
+                [](void *c, int scene) {
+                    auto ctx = static_cast<FXTaskContext *>(c);
+                    ctx->sc_state[scene] =
+                        ctx->synth->processInsertFXChain(scene, ctx->sc_state[scene]);
+                },
+                &fxctx, n_scenes, callerOnly);
+        }
+        else
         {
-            if (fx[v] && !(storage.getPatch().fx_disable.val.i & (1 << v)))
-            {
-                sc_state[1] = fx[v]->process_ringout(sceneout[1][0], sceneout[1][1], sc_state[1]);
-            }
+            for (int sc = 0; sc < n_scenes; ++sc)
+                sc_state[sc] = processInsertFXChain(sc, sc_state[sc]);
         }
     }
 
@@ -4975,6 +5279,37 @@ void SurgeSynthesizer::process()
     // TODO: FIX SCENE ASSUMPTION
     if (fx_bypass == fxb_all_fx)
     {
+        // Only enabled sends become tasks, so a disabled one keeps sendused false, as in the
+        // serial path
+        uint32_t callerOnly = 0;
+        int sendsActive = 0;
+        for (auto si : sendToIndex)
+        {
+            if (activeFXMask({si[0]}, callerOnly, sendsActive))
+                fxctx.activeSends[sendsActive++] = si[1];
+        }
+
+        if (fxWorkerPool && sendsActive > 1 && callerOnly != (1U << sendsActive) - 1)
+        {
+            fxctx.sendused = sendused;
+            fxctx.sendInputPresent = sc_state[0] || sc_state[1];
+            fxWorkerPool->run(
+                [](void *c, int task) {
+                    auto ctx = static_cast<FXTaskContext *>(c);
+                    auto idx = ctx->activeSends[task];
+                    ctx->sendused[idx] =
+                        ctx->synth->processSendFX(idx, ctx->fxsendout[idx][0],
+                                                  ctx->fxsendout[idx][1], ctx->sendInputPresent);
+                },
+                &fxctx, sendsActive, callerOnly);
+        }
+        else
+        {
+            for (auto si : sendToIndex)
+                sendused[si[1]] = processSendFX(si[1], fxsendout[si[1]][0], fxsendout[si[1]][1],
+                                                sc_state[0] || sc_state[1]);
+        }
+
         for (auto si : sendToIndex)
         {
             auto slot = si[0];
@@ -4982,12 +5317,6 @@ void SurgeSynthesizer::process()
 
             if (fx[slot] && !(storage.getPatch().fx_disable.val.i & (1 << slot)))
             {
-                send[idx][0].MAC_2_blocks_to(sceneout[0][0], sceneout[0][1], fxsendout[idx][0],
-                                             fxsendout[idx][1], BLOCK_SIZE_QUAD);
-                send[idx][1].MAC_2_blocks_to(sceneout[1][0], sceneout[1][1], fxsendout[idx][0],
-                                             fxsendout[idx][1], BLOCK_SIZE_QUAD);
-                sendused[idx] = fx[slot]->process_ringout(fxsendout[idx][0], fxsendout[idx][1],
-                                                          sc_state[0] || sc_state[1]);
                 FX[idx].MAC_2_blocks_to(fxsendout[idx][0], fxsendout[idx][1], output[0], output[1],
                                         BLOCK_SIZE_QUAD);
             }
@@ -5010,6 +5339,12 @@ void SurgeSynthesizer::process()
         }
     }
 
+    uint32_t fxDormant = 0;
+    for (int i = 0; i < n_fx_slots; ++i)
+        if (fx[i] && fx[i]->isDormant())
+            fxDormant |= 1U << i;
+    fxDormantMask.store(fxDormant, std::memory_order_relaxed);
+
     amp.multiply_2_blocks(output[0], output[1], BLOCK_SIZE_QUAD);
     amp_mute.multiply_2_blocks(output[0], output[1], BLOCK_SIZE_QUAD);
 
@@ -5059,6 +5394,194 @@ void SurgeSynthesizer::process()
     auto smoothed_ratio = (c * (window - 1) + ratio) / window;
     c = c * storage.cpu_falloff;
     cpu_level.store(max(c, smoothed_ratio));
+
+    publishModulationSnapshot();
+}
+
+void SurgeSynthesizer::publishModulationSnapshot()
+{
+    auto &snap = modulationSnapshot.writeBuffer();
+    snap.blockCount = ++modulationSnapshotBlocks;
+
+    for (int sc = 0; sc < n_scenes; ++sc)
+    {
+        auto &scene = storage.getPatch().scene[sc];
+
+        SurgeVoice *newest = nullptr;
+        for (auto *v : voices[sc])
+        {
+            if (v->state.keep_playing && (!newest || v->age < newest->age))
+                newest = v;
+        }
+        snap.voiceKey[sc] = newest ? newest->state.key : -1;
+
+        for (int ms = 0; ms < n_modsources; ++ms)
+        {
+            auto nIdx = std::min(getMaxModulationIndex(sc, (modsources)ms), max_lfo_indices);
+            auto *sms = scene.modsources[ms];
+            auto *vms = newest ? newest->modsources[ms] : nullptr;
+
+            for (int i = 0; i < max_lfo_indices; ++i)
+            {
+                snap.scene[sc][ms][i] = (sms && i < nIdx) ? sms->get_output(i) : 0.f;
+                snap.voice[sc][ms][i] = (vms && i < nIdx) ? vms->get_output(i) : 0.f;
+            }
+        }
+    }
+
+    for (int i = 0; i < n_customcontrollers; ++i)
+    {
+        auto cms =
+            (ControllerModulationSource *)storage.getPatch().scene[0].modsources[ms_ctrl1 + i];
+        snap.macroTarget01[i] = cms->get_target01(0);
+        snap.macroOutput01[i] = cms->get_output01(0);
+
+        // We are the only reader of the changed flag now, so it can be reset here
+        if (cms->has_changed(0, true))
+            macroChangeCount[i]++;
+        snap.macroChangeCount[i] = macroChangeCount[i];
+    }
+
+    modulationSnapshot.publish();
+}
+
+void SurgeSynthesizer::getModulationSnapshot(ModulationSnapshot &into)
+{
+    std::lock_guard<std::mutex> g(modulationSnapshotReadMutex);
+    modulationSnapshot.update();
+    into = modulationSnapshot.readBuffer();
+}
+
+void SurgeSynthesizer::updateHalfbandQuality()
+{
+    namespace hr = sst::filters::HalfRate;
+
+    halfbandQuality = storage.decimationQuality;
+
+    // Building a HalfRateFilter doesn't allocate so this is fine on the audio thread
+    auto make = [q = halfbandQuality]() {
+        if (q == SurgeStorage::DECIMATION_ECO)
+            return hr::HalfRateFilter(2, false);
+        return hr::HalfRateFilter(6, true);
+    };
+
+    // Swapping filters mid stream would click, so the outgoing ones keep their state and run
+    // alongside the new ones while processHalfbandD2/U2 crossfade between them
+    halfbandOutgoingA = halfbandA;
+    halfbandOutgoingB = halfbandB;
+    halfbandOutgoingIN = halfbandIN;
+    halfbandFadePosition = 0;
+
+    halfbandA = make();
+    halfbandB = make();
+    halfbandIN = make();
+}
+
+namespace
+{
+// Fades dst from the values in from towards its own, over blocks of n samples
+inline void halfbandCrossfade(float *dst, const float *from, int n, int position, int blocks)
+{
+    const float dt = 1.f / (n * blocks);
+    float t = position * n * dt;
+    for (int i = 0; i < n; ++i)
+    {
+        t += dt;
+        dst[i] = from[i] + t * (dst[i] - from[i]);
+    }
+}
+} // namespace
+
+void SurgeSynthesizer::processHalfbandD2(int scene)
+{
+    // TODO: FIX SCENE ASSUMPTION
+    auto &hb = scene == 0 ? halfbandA : halfbandB;
+    auto *L = sceneout[scene][0], *R = sceneout[scene][1];
+
+    if (halfbandFadePosition >= halfbandFadeBlocks)
+    {
+        hb.process_block_D2(L, R, BLOCK_SIZE_OS);
+        return;
+    }
+
+    float oldL alignas(16)[BLOCK_SIZE_OS], oldR alignas(16)[BLOCK_SIZE_OS];
+    mech::copy_from_to<BLOCK_SIZE_OS>(L, oldL);
+    mech::copy_from_to<BLOCK_SIZE_OS>(R, oldR);
+
+    (scene == 0 ? halfbandOutgoingA : halfbandOutgoingB)
+        .process_block_D2(oldL, oldR, BLOCK_SIZE_OS);
+    hb.process_block_D2(L, R, BLOCK_SIZE_OS);
+
+    halfbandCrossfade(L, oldL, BLOCK_SIZE, halfbandFadePosition, halfbandFadeBlocks);
+    halfbandCrossfade(R, oldR, BLOCK_SIZE, halfbandFadePosition, halfbandFadeBlocks);
+}
+
+void SurgeSynthesizer::processHalfbandU2()
+{
+    auto *L = storage.audio_in[0], *R = storage.audio_in[1];
+    halfbandIN.process_block_U2(input[0], input[1], L, R, BLOCK_SIZE_OS);
+
+    if (halfbandFadePosition >= halfbandFadeBlocks)
+        return;
+
+    float oldL alignas(16)[BLOCK_SIZE_OS], oldR alignas(16)[BLOCK_SIZE_OS];
+    halfbandOutgoingIN.process_block_U2(input[0], input[1], oldL, oldR, BLOCK_SIZE_OS);
+
+    halfbandCrossfade(L, oldL, BLOCK_SIZE_OS, halfbandFadePosition, halfbandFadeBlocks);
+    halfbandCrossfade(R, oldR, BLOCK_SIZE_OS, halfbandFadePosition, halfbandFadeBlocks);
+}
+
+bool SurgeSynthesizer::processInsertFXChain(int scene, bool inputPresent)
+{
+    // TODO: FIX SCENE ASSUMPTION
+    static constexpr int insertSlots[n_scenes][4] = {
+        {fxslot_ains1, fxslot_ains2, fxslot_ains3, fxslot_ains4},
+        {fxslot_bins1, fxslot_bins2, fxslot_bins3, fxslot_bins4}};
+
+    for (auto v : insertSlots[scene])
+    {
+        if (fx[v] && !(storage.getPatch().fx_disable.val.i & (1 << v)))
+        {
+            inputPresent =
+                fx[v]->process_ringout(sceneout[scene][0], sceneout[scene][1], inputPresent);
+        }
+    }
+
+    return inputPresent;
+}
+
+bool SurgeSynthesizer::processSendFX(int idx, float *sendL, float *sendR, bool inputPresent)
+{
+    static constexpr int sendSlots[n_send_slots] = {fxslot_send1, fxslot_send2, fxslot_send3,
+                                                    fxslot_send4};
+    auto slot = sendSlots[idx];
+
+    if (!fx[slot] || (storage.getPatch().fx_disable.val.i & (1 << slot)))
+        return false;
+
+    // TODO: FIX SCENE ASSUMPTION
+    send[idx][0].MAC_2_blocks_to(sceneout[0][0], sceneout[0][1], sendL, sendR, BLOCK_SIZE_QUAD);
+    send[idx][1].MAC_2_blocks_to(sceneout[1][0], sceneout[1][1], sendL, sendR, BLOCK_SIZE_QUAD);
+
+    return fx[slot]->process_ringout(sendL, sendR, inputPresent);
+}
+
+void SurgeSynthesizer::setFXWorkerThreads(int n)
+{
+    // At most one worker per send effect beyond the calling thread is ever useful
+    n = std::clamp(n, 0, n_send_slots - 1);
+
+    if (n == getFXWorkerThreads())
+        return;
+
+    fxWorkerPool.reset();
+    if (n > 0)
+        fxWorkerPool = std::make_unique<Surge::DSP::FXWorkerPool>(n);
+}
+
+int SurgeSynthesizer::getFXWorkerThreads() const
+{
+    return fxWorkerPool ? fxWorkerPool->workerCount() : 0;
 }
 
 SurgeSynthesizer::PluginLayer *SurgeSynthesizer::getParent()
@@ -5518,6 +6041,7 @@ void SurgeSynthesizer::reorderFx(int source, int target, FXReorderMode m)
     }
 
     storage.getPatch().fx_disable.val.i = startingBitmask;
+    storage.getPatch().markParameterChanged(storage.getPatch().fx_disable.id);
     fx_suspend_bitmask = startingBitmask;
 
     fx_reload[target] = true;
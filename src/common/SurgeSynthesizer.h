@@ -26,11 +26,21 @@
 #include "SurgeVoice.h"
 #include "Effect.h"
 #include "BiquadFilter.h"
+#include "ParameterRefreshQueue.h"
+#include "TripleBuffer.h"
 #include <set>
 #include <sst/filters/HalfRateFilter.h>
 
 struct QuadFilterChainState;
 
+namespace Surge
+{
+namespace DSP
+{
+struct FXWorkerPool;
+}
+} // namespace Surge
+
 #include <list>
 #include <utility>
 #include <atomic>
@@ -460,7 +470,7 @@ class alignas(16) SurgeSynthesizer
 
     //==============================================================================
     // Parameter changes coming from within the synth (e.g. from MIDI-learned input)
-    // are communicated to listeners here
+    // are communicated to listeners here, by the parameter's oscName and normalized value
     std::unordered_map<std::string, std::function<void(const std::string oscname, const float fval,
                                                        std::string valstr)>>
         audioThreadParamListeners;
@@ -478,8 +488,8 @@ class alignas(16) SurgeSynthesizer
     bool refresh_editor, refresh_vkb, patch_loaded;
     int learn_param_from_cc, learn_macro_from_cc, learn_param_from_note;
     int refresh_ctrl_queue[8];
-    int refresh_parameter_queue[8];
-    bool refresh_overflow = false;
+    // params changed from outside the editor which it should redraw; see queueForRefresh
+    Surge::ParameterRefreshQueue<n_total_params> refreshParameterQueue;
     float refresh_ctrl_queue_value[8];
     bool process_input;
     std::atomic<bool> has_patchid_file;
@@ -494,6 +504,31 @@ class alignas(16) SurgeSynthesizer
 
     float vu_peak[8];
     std::atomic<float> cpu_level{0.f};
+    // Bit per FX slot / scene which skipped processing in the last block, for the GUI
+    std::atomic<uint32_t> fxDormantMask{0}, sceneDormantMask{0};
+
+    /*
+     * Every modulator output as of the end of a block, published by the audio thread once per
+     * block. Scene level sources come from the scene, voice level ones from the most recently
+     * started voice in that scene. Displays, OSC and surgepy read this rather than the live
+     * ModulationSource objects the engine is writing.
+     */
+    struct ModulationSnapshot
+    {
+        uint64_t blockCount{0};
+        float scene[n_scenes][n_modsources][max_lfo_indices];
+        float voice[n_scenes][n_modsources][max_lfo_indices];
+        int voiceKey[n_scenes]; // -1 if nothing is playing in the scene
+        float macroTarget01[n_customcontrollers], macroOutput01[n_customcontrollers];
+        /*
+         * Counts the times each macro was set with its changed flag up (host automation, MIDI,
+         * setMacroParameter01) but not the editor's own set_target01(..., false). The editor
+         * follows a macro when this moves, as it used to when has_changed(0, true) was true.
+         */
+        uint32_t macroChangeCount[n_customcontrollers];
+    };
+    // Callable from any thread but the audio thread. Never blocks the engine.
+    void getModulationSnapshot(ModulationSnapshot &into);
 
     void populateDawExtraState();
 
@@ -505,6 +540,15 @@ class alignas(16) SurgeSynthesizer
     bool approachingAllSoundOff{false};
     // TODO: FIX SCENE ASSUMPTION (for halfbandA/B - use std::array)
     sst::filters::HalfRate::HalfRateFilter halfbandA, halfbandB, halfbandIN;
+    SurgeStorage::DecimationQuality halfbandQuality{SurgeStorage::DECIMATION_STANDARD};
+    // After a quality change the previous filters run alongside for halfbandFadeBlocks blocks
+    sst::filters::HalfRate::HalfRateFilter halfbandOutgoingA, halfbandOutgoingB,
+        halfbandOutgoingIN;
+    static constexpr int halfbandFadeBlocks = 8;
+    int halfbandFadePosition{halfbandFadeBlocks};
+    void updateHalfbandQuality();
+    void processHalfbandD2(int scene);
+    void processHalfbandU2();
     std::list<SurgeVoice *> voices[n_scenes];
     std::unique_ptr<Effect> fx[n_fx_slots];
     std::atomic<bool> halt_engine;
@@ -518,11 +562,49 @@ class alignas(16) SurgeSynthesizer
     uint64_t orderedMidiKey = 0;
     std::atomic<uint64_t> midiNoteEvents{0};
 
+    /*
+     * Voice start accounting. Every note on is timed around its playVoice calls. When
+     * SurgeStorage::voiceStartBudgetNs is set and the note ons in this block have used it up,
+     * further note ons wait in deferredNotes and start at the top of the following blocks, at
+     * least one per block, so a dense chord is spread over a few blocks rather than landing in
+     * one. A release or choke for a note which is still waiting is applied to it in order, and a
+     * waiting note which is dropped is reported to the host as ended. Only touched on the audio
+     * thread.
+     */
+    struct VoiceStartStats
+    {
+        uint64_t notes{0}, deferred{0};
+        int64_t totalNs{0}, maxNs{0}, maxBlockNs{0};
+        // note on cost by powers of two microseconds: < 1, < 2, < 4 ... < 64, and the rest
+        std::array<uint32_t, 8> histogram{};
+    } voiceStartStats;
+    int64_t voiceStartNsThisBlock{0};
+
+    struct DeferredNote
+    {
+        char channel{0}, key{0}, velocity{0}, detune{0};
+        int32_t host_noteid{-1}, forceScene{-1};
+        bool released{false};
+        char releaseVelocity{0};
+    };
+    static constexpr int maxDeferredNotes = 128;
+    std::array<DeferredNote, maxDeferredNotes> deferredNotes;
+    int deferredNoteCount{0};
+    bool startingDeferredNotes{false};
+    void startDeferredNotes();
+    // Returns true if a waiting note matched; a negative channel, key or note id matches any, and
+    // choke drops the note instead of marking it released
+    bool releaseDeferredNote(int channel, int key, char velocity, int32_t host_noteid, bool choke);
+    // Drops every waiting note, telling the host each one with a note id has ended
+    void clearDeferredNotes();
+
     int current_category_id = 0;
     bool modsourceused[n_modsources];
     bool midiprogramshavechanged = false;
 
     bool switch_toggled_queued, release_if_latched[n_scenes], release_anyway[n_scenes];
+    // The oscillator slot miss count processControl last resized the pools for
+    size_t oscillatorSlotMissesSeen{0};
     void setParameterSmoothed(long index, float value);
 
     static constexpr int n_hpBQ = 4;
@@ -574,19 +656,53 @@ class alignas(16) SurgeSynthesizer
 
     void changeModulatorSmoothing(Modulator::SmoothingMode m);
 
+    /*
+     * With one or more FX worker threads, process() runs the scene A and B insert chains, and
+     * then the four send effects, concurrently. Output is bit-identical to the serial path.
+     * 0 turns it off. Rebuilds the pool so call it only while process() is not running.
+     */
+    void setFXWorkerThreads(int n);
+    int getFXWorkerThreads() const;
+
     void queueForRefresh(int param_index);
 
     // these have to be thread-safe, so keep them private
   private:
     PluginLayer *_parent = nullptr;
 
+    std::unique_ptr<Surge::DSP::FXWorkerPool> fxWorkerPool;
+
+    static constexpr int sceneIdleHoldBlocks = 16;
+    int sceneQuietBlocks[n_scenes]{};
+
+    Surge::TripleBuffer<ModulationSnapshot> modulationSnapshot;
+    // The triple buffer has a single reader, so readers on different threads take turns
+    std::mutex modulationSnapshotReadMutex;
+    uint64_t modulationSnapshotBlocks{0};
+    uint32_t macroChangeCount[n_customcontrollers]{};
+    void publishModulationSnapshot();
+
+    bool processInsertFXChain(int scene, bool inputPresent);
+    bool processSendFX(int idx, float *sendL, float *sendR, bool inputPresent);
+
     void switch_toggled();
 
-    // MIDI control interpolators
+    /*
+     * MIDI control interpolators. A parameter id maps straight to its slot, live slots are
+     * packed at the front of mControlInterpolatorActive (with each slot's position in
+     * mControlInterpolatorActivePos) and unused slots sit on a free stack, so lookups, adds and
+     * releases are constant time and the per block update only visits live interpolators.
+     */
     static constexpr int num_controlinterpolators = 128;
     ControllerModulationSource mControlInterpolator[num_controlinterpolators];
-    bool mControlInterpolatorUsed[num_controlinterpolators];
-
+    std::array<int16_t, n_total_params> mControlInterpolatorIndex;
+    int16_t mControlInterpolatorActive[num_controlinterpolators];
+    int16_t mControlInterpolatorActivePos[num_controlinterpolators];
+    int16_t mControlInterpolatorFree[num_controlinterpolators];
+    int mControlInterpolatorActiveCount{0}, mControlInterpolatorFreeCount{0};
+
+    void ResetControlInterpolators();
+    void ReleaseControlInterpolatorSlot(int Index);
     int GetFreeControlInterpolatorIndex();
     int GetControlInterpolatorIndex(int Idx);
     void ReleaseControlInterpolator(int Idx);
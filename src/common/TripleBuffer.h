@@ -0,0 +1,71 @@
+/*
+ * Surge XT - a free and open source hybrid synthesizer,
+ * built by Surge Synth Team
+ *
+ * Learn more at https://surge-synthesizer.github.io/
+ *
+ * Copyright 2018-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * Surge XT is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Surge was a commercial product from 2004-2018, copyright and ownership
+ * held by Claes Johanson at Vember Audio during that period.
+ * Claes made Surge open source in September 2018.
+ *
+ * All source for Surge XT is available at
+ * https://github.com/surge-synthesizer/surge
+ */
+
+
+#ifndef SURGE_SRC_COMMON_TRIPLEBUFFER_H
+#define SURGE_SRC_COMMON_TRIPLEBUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace Surge
+{
+
+/*
+ * A wait-free single writer / single reader triple buffer. The writer fills writeBuffer() and
+ * calls publish(); the reader calls update() and then looks at readBuffer(), which stays stable
+ * until its next update(). Neither side ever waits on the other, the reader simply sees the most
+ * recently published value and skips anything published in between.
+ */
+template <typename T> struct TripleBuffer
+{
+    // Writer side
+    T &writeBuffer() { return buffers[writeIdx]; }
+    void publish()
+    {
+        auto prior = middle.exchange(writeIdx | freshBit, std::memory_order_acq_rel);
+        writeIdx = prior & indexMask;
+    }
+
+    // Reader side. Returns true if a newer buffer was picked up.
+    bool update()
+    {
+        if (!(middle.load(std::memory_order_relaxed) & freshBit))
+            return false;
+
+        auto prior = middle.exchange(readIdx, std::memory_order_acq_rel);
+        readIdx = prior & indexMask;
+        return true;
+    }
+    const T &readBuffer() const { return buffers[readIdx]; }
+
+  private:
+    static constexpr uint32_t indexMask = 3, freshBit = 4;
+
+    T buffers[3]{};
+    uint32_t writeIdx{0}, readIdx{1};
+    std::atomic<uint32_t> middle{2};
+};
+
+} // namespace Surge
+
+#endif // SURGE_SRC_COMMON_TRIPLEBUFFER_H
@@ -374,6 +374,33 @@ std::string defaultKeyToString(DefaultKey k)
         r = "openSoundControlIPAddrOut";
         break;
 
+    case OSCSchedulingLatency:
+        r = "openSoundControlSchedulingLatencyMs";
+        break;
+
+    case FXWorkerThreads:
+        r = "fxWorkerThreads";
+        break;
+    case FXMeasuredTail:
+        r = "fxMeasuredTail";
+        break;
+    case FXTailThresholdDB:
+        r = "fxTailThresholdDB";
+        break;
+
+    case MSEGBakedLookup:
+        r = "msegBakedLookup";
+        break;
+    case BlockEndAutomation:
+        r = "blockEndAutomation";
+        break;
+    case DeltaParamCopy:
+        r = "deltaParamCopy";
+        break;
+    case VoiceStartBudgetMicroseconds:
+        r = "voiceStartBudgetMicroseconds";
+        break;
+
     case StartOSCIn:
         r = "startOSCIn";
         break;
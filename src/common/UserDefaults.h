@@ -178,6 +178,16 @@ enum DefaultKey
     OSCPortIn,
     OSCPortOut,
     OSCIPOut,
+    OSCSchedulingLatency,
+
+    FXWorkerThreads,
+    FXMeasuredTail,
+    FXTailThresholdDB,
+
+    MSEGBakedLookup,
+    BlockEndAutomation,
+    DeltaParamCopy,
+    VoiceStartBudgetMicroseconds,
 
     nKeys
 };
@@ -50,6 +50,10 @@
 #include "DebugHelpers.h"
 #include "AudioInputEffect.h"
 
+#include "sst/basic-blocks/mechanics/block-ops.h"
+
+namespace mech = sst::basic_blocks::mechanics;
+
 using namespace std;
 
 Effect *spawn_effect(int id, SurgeStorage *storage, FxStorage *fxdata, pdata *pd)
@@ -141,19 +145,44 @@ Effect::Effect(SurgeStorage *storage, FxStorage *fxdata, pdata *pd)
 bool Effect::process_ringout(float *dataL, float *dataR, bool indata_present)
 {
     if (indata_present)
+    {
         ringout = 0;
+        quietBlocks = 0;
+    }
     else
         ringout++;
 
     int d = get_ringout_decay();
-    if ((d < 0) || (ringout < d) || (ringout == 0))
+
+    // The measured tail never runs longer than the fixed one would; it can only stop earlier
+    bool measured = storage && storage->fxMeasuredTail && d >= 0;
+
+    dormant = !((d < 0) || (ringout < d) || (ringout == 0));
+    if (measured && !indata_present && quietBlocks > get_measured_tail_hold())
+        dormant = true;
+
+    if (dormant)
     {
-        process(dataL, dataR);
-        return true;
-    }
-    else
         process_only_control();
-    return false;
+        return false;
+    }
+
+    process(dataL, dataR);
+
+    if (measured && !indata_present)
+    {
+        auto peak = std::max(mech::blockAbsMax<BLOCK_SIZE>(dataL),
+                             mech::blockAbsMax<BLOCK_SIZE>(dataR));
+        quietBlocks = (peak < storage->fxTailThreshold) ? quietBlocks + 1 : 0;
+    }
+
+    return true;
+}
+
+int Effect::get_measured_tail_hold()
+{
+    // A quarter second covers the quiet gap at the start of a pre-delayed tail
+    return (int)(0.25f * storage->samplerate * BLOCK_SIZE_INV);
 }
 
 void Effect::init_ctrltypes()
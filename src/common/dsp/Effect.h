@@ -67,6 +67,11 @@ class alignas(16) Effect
     {
         return -1;
     } // number of blocks it takes for the effect to 'ring out'
+    // With the measured tail on, how many blocks the output has to stay under the threshold
+    // before the effect goes dormant. Effects with silent gaps in their tail (delays) extend it.
+    virtual int get_measured_tail_hold();
+    // True when process_ringout skipped processing this block
+    bool isDormant() const { return dormant; }
     int groupIndexForParamIndex(int paramIndex)
     {
         int fpos = fxdata->p[paramIndex].posy / 10 + fxdata->p[paramIndex].posy_offset;
@@ -100,6 +105,11 @@ class alignas(16) Effect
     // keeps a cache so give loaded fx a notice when the sample rate changes
     virtual void sampleRateReset() {}
 
+    // Return true to let the FX worker pool run this effect on another thread, alongside other
+    // effects. Only do so if process() touches nothing shared with other effects; the storage
+    // RNG, which the sst effect adapter hands out as rand01, is the usual culprit.
+    virtual bool allowsConcurrentProcessing() { return false; }
+
     virtual void handleStreamingMismatches(int streamingRevision, int currentSynthStreamingRevision)
     {
         // No-op here.
@@ -131,6 +141,8 @@ class alignas(16) Effect
     FxStorage *fxdata;
     pdata *pd;
     int ringout;
+    int quietBlocks{0};
+    bool dormant{false};
     bool hasInvalidated{false};
 };
 
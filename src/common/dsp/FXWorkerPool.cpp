@@ -0,0 +1,235 @@
+/*
+ * Surge XT - a free and open source hybrid synthesizer,
+ * built by Surge Synth Team
+ *
+ * Learn more at https://surge-synthesizer.github.io/
+ *
+ * Copyright 2018-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * Surge XT is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Surge was a commercial product from 2004-2018, copyright and ownership
+ * held by Claes Johanson at Vember Audio during that period.
+ * Claes made Surge open source in September 2018.
+ *
+ * All source for Surge XT is available at
+ * https://github.com/surge-synthesizer/surge
+ */
+
+#include "FXWorkerPool.h"
+
+#include "sst/plugininfra/cpufeatures.h"
+
+#include <cassert>
+#include <climits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+#if WINDOWS
+#include <windows.h>
+#elif defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif MAC && __has_include(<os/os_sync_wait_on_address.h>)
+#include <os/os_sync_wait_on_address.h>
+#define SURGE_FX_POOL_HAS_OS_SYNC 1
+#endif
+
+namespace Surge
+{
+namespace DSP
+{
+
+namespace
+{
+inline uint64_t packClaim(uint32_t gen, uint32_t n, uint32_t idx)
+{
+    return ((uint64_t)gen << 32) | ((uint64_t)(n & 0xFFFF) << 16) | (uint64_t)(idx & 0xFFFF);
+}
+
+inline uint32_t claimGeneration(uint64_t w) { return (uint32_t)(w >> 32); }
+inline uint32_t claimCount(uint64_t w) { return (uint32_t)((w >> 16) & 0xFFFF); }
+inline uint32_t claimIndex(uint64_t w) { return (uint32_t)(w & 0xFFFF); }
+
+// How many times an idle worker polls for new work before parking. Each poll is one CPU pause,
+// which is tens of nanoseconds, so this stays awake for roughly one block at 48k.
+constexpr int spinsBeforePark = 4096;
+
+inline void cpuRelax()
+{
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    __yield();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#endif
+}
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) &&
+                  std::atomic<uint32_t>::is_always_lock_free,
+              "The wake word is handed to the OS as a plain 32 bit word");
+} // namespace
+
+/*
+ * Sleeps while the wake word still holds expected. There is no timeout: run() and the destructor
+ * always move the word before they wake, and workerLoop announces itself in sleepers before it
+ * looks at the word, so a wake can not slip between the check and the sleep.
+ */
+void FXWorkerPool::parkWhile(uint32_t expected)
+{
+#if WINDOWS
+    WaitOnAddress(&wakeWord, &expected, sizeof(expected), INFINITE);
+#elif defined(__linux__)
+    syscall(SYS_futex, &wakeWord, FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+#if SURGE_FX_POOL_HAS_OS_SYNC
+    if (__builtin_available(macOS 14.4, *))
+    {
+        os_sync_wait_on_address(&wakeWord, expected, sizeof(expected),
+                                OS_SYNC_WAIT_ON_ADDRESS_NONE);
+        return;
+    }
+#endif
+    std::unique_lock<std::mutex> lk(parkMutex);
+    parkCV.wait(lk, [this, expected]() { return wakeWord.load() != expected; });
+#endif
+}
+
+void FXWorkerPool::unparkAll()
+{
+#if WINDOWS
+    WakeByAddressAll(&wakeWord);
+#elif defined(__linux__)
+    syscall(SYS_futex, &wakeWord, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+#if SURGE_FX_POOL_HAS_OS_SYNC
+    if (__builtin_available(macOS 14.4, *))
+    {
+        os_sync_wake_by_address_all(&wakeWord, sizeof(uint32_t), OS_SYNC_WAKE_BY_ADDRESS_NONE);
+        return;
+    }
+#endif
+    // Taking the lock orders the wake after any waiter's predicate check. This is the one place
+    // the audio thread can block, and only on systems without a wait on address primitive.
+    {
+        std::lock_guard<std::mutex> g(parkMutex);
+    }
+    parkCV.notify_all();
+#endif
+}
+
+FXWorkerPool::FXWorkerPool(int nWorkers)
+{
+    for (int i = 0; i < nWorkers; ++i)
+        workers.emplace_back([this]() { workerLoop(); });
+}
+
+FXWorkerPool::~FXWorkerPool()
+{
+    running = false;
+    wakeWord.fetch_add(1);
+    unparkAll();
+
+    for (auto &w : workers)
+        if (w.joinable())
+            w.join();
+}
+
+bool FXWorkerPool::claimAndRun(uint32_t forGeneration)
+{
+    auto w = claim.load(std::memory_order_acquire);
+    while (true)
+    {
+        if (claimGeneration(w) != forGeneration || claimIndex(w) >= claimCount(w))
+            return false;
+
+        if (claim.compare_exchange_weak(w, w + 1, std::memory_order_acq_rel,
+                                        std::memory_order_acquire))
+            break;
+    }
+
+    currentTask(currentCtx, sharedIndices[claimIndex(w)]);
+    inFlight.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+void FXWorkerPool::run(task_t task, void *ctx, int n, uint32_t callerOnlyMask)
+{
+    assert(n <= maxTasks);
+
+    int nShared = 0;
+    for (int i = 0; i < n; ++i)
+        if (!(callerOnlyMask & (1U << i)))
+            sharedIndices[nShared++] = i;
+
+    currentTask = task;
+    currentCtx = ctx;
+    inFlight.store(nShared, std::memory_order_relaxed);
+
+    generation++;
+    claim.store(packClaim(generation, nShared, 0), std::memory_order_release);
+
+    // Paired with the sleepers increment in workerLoop: either we see the worker about to park,
+    // or it sees the new wake word and does not park at all
+    wakeWord.store(generation);
+    if (nShared > 1 && sleepers.load() > 0)
+        unparkAll();
+
+    // Caller-only tasks first and in order, then help with whatever is left
+    for (int i = 0; i < n; ++i)
+        if (callerOnlyMask & (1U << i))
+            task(ctx, i);
+
+    while (claimAndRun(generation))
+        ;
+
+    // Everything is claimed; wait for the workers to finish what they picked up
+    while (inFlight.load(std::memory_order_acquire) > 0)
+        cpuRelax();
+}
+
+void FXWorkerPool::workerLoop()
+{
+    // Match the audio thread; without this denormals in the effect tails get very expensive
+    auto fpuguard = sst::plugininfra::cpufeatures::FPUStateGuard();
+
+    uint32_t lastSeen = 0;
+    int spins = 0;
+
+    while (running)
+    {
+        auto gen = claimGeneration(claim.load(std::memory_order_acquire));
+        if (gen != lastSeen)
+        {
+            while (claimAndRun(gen))
+                ;
+            lastSeen = gen;
+            spins = 0;
+            continue;
+        }
+
+        if (spins < spinsBeforePark)
+        {
+            spins++;
+            cpuRelax();
+            continue;
+        }
+
+        sleepers++;
+        if (running && wakeWord.load() == lastSeen)
+            parkWhile(lastSeen);
+        sleepers--;
+        spins = 0;
+    }
+}
+
+} // namespace DSP
+} // namespace Surge
@@ -0,0 +1,106 @@
+/*
+ * Surge XT - a free and open source hybrid synthesizer,
+ * built by Surge Synth Team
+ *
+ * Learn more at https://surge-synthesizer.github.io/
+ *
+ * Copyright 2018-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * Surge XT is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Surge was a commercial product from 2004-2018, copyright and ownership
+ * held by Claes Johanson at Vember Audio during that period.
+ * Claes made Surge open source in September 2018.
+ *
+ * All source for Surge XT is available at
+ * https://github.com/surge-synthesizer/surge
+ */
+
+#ifndef SURGE_SRC_COMMON_DSP_FXWORKERPOOL_H
+#define SURGE_SRC_COMMON_DSP_FXWORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Surge
+{
+namespace DSP
+{
+
+/*
+ * FXWorkerPool lets SurgeSynthesizer::process run independent effect chains (the two scene
+ * insert chains, then the four send effects) at the same time. It is deliberately tiny:
+ *
+ * - The threads are made once, up front. run() never allocates, locks or waits on a thread
+ *   which has not yet picked up work; the calling (audio) thread claims tasks too, so if every
+ *   worker is asleep or descheduled the block simply runs serially on the caller.
+ * - Tasks are a plain function pointer plus context and an index, so there is no std::function
+ *   or capture allocation per block.
+ * - Tasks flagged in callerOnlyMask run on the calling thread, in ascending index order. This
+ *   is how we keep effects which draw from the shared SurgeStorage RNG in the same order (and
+ *   on the same thread) as the serial path, which keeps the output bit-identical.
+ *
+ * The only cross-thread state is the claim word (the generation in the top 32 bits, then the
+ * number of shared tasks and the next one to hand out) and the count of shared tasks still in
+ * flight. Workers spin briefly with a CPU pause after each run and then park on the wake word
+ * (a futex, WaitOnAddress or os_sync_wait_on_address, depending on the platform) until run()
+ * moves it. Waking them is a single system call, so the audio thread never takes a lock. Where
+ * none of those exist (macOS before 14.4, for instance) the workers park on a condition variable
+ * instead, and run() takes its mutex briefly when it has to wake them.
+ */
+struct FXWorkerPool
+{
+    typedef void (*task_t)(void *ctx, int index);
+
+    static constexpr int maxTasks = 32;
+
+    explicit FXWorkerPool(int nWorkers);
+    ~FXWorkerPool();
+
+    int workerCount() const { return (int)workers.size(); }
+
+    /*
+     * Runs task(ctx, i) for every i in [0, n) and returns once all of them are done. The caller
+     * must not call run() re-entrantly or from more than one thread.
+     */
+    void run(task_t task, void *ctx, int n, uint32_t callerOnlyMask = 0);
+
+  private:
+    void workerLoop();
+    bool claimAndRun(uint32_t forGeneration);
+    void parkWhile(uint32_t expected);
+    void unparkAll();
+
+    std::vector<std::thread> workers;
+
+    std::atomic<uint64_t> claim{0};
+    std::atomic<int> inFlight{0};
+
+    // Written by run() before the claim word is published and read only after a successful
+    // claim, so they need no synchronisation of their own
+    task_t currentTask{nullptr};
+    void *currentCtx{nullptr};
+    int sharedIndices[maxTasks]{};
+    uint32_t generation{0};
+
+    std::atomic<bool> running{true};
+    std::atomic<int> sleepers{0};
+    // Holds the last published generation; parked workers wait for it to move
+    std::atomic<uint32_t> wakeWord{0};
+    // Only used where the platform has no wait on address primitive
+    std::mutex parkMutex;
+    std::condition_variable parkCV;
+};
+
+} // namespace DSP
+} // namespace Surge
+
+#endif // SURGE_SRC_COMMON_DSP_FXWORKERPOOL_H
@@ -96,7 +96,7 @@ Oscillator *spawn_osc(int osctype, SurgeStorage *storage, OscillatorStorage *osc
     {
         // In the event we are misconfigured, window oscillator will segfault. If you still play
         // after clicking through 100 warnings, let's just give you a sine
-        if (storage && storage->WindowWT.size == 0)
+        if (storage && storage->WindowWT->size == 0)
             return new (onto) SineOscillator(storage, oscdata, localcopy);
 
         return new (onto) WindowOscillator(storage, oscdata, localcopy);
@@ -124,6 +124,39 @@ Oscillator *spawn_osc(int osctype, SurgeStorage *storage, OscillatorStorage *osc
     return osc;
 }
 
+size_t oscillator_slot_size(int osctype)
+{
+    switch (osctype)
+    {
+    case ot_classic:
+        return sizeof(ClassicOscillator);
+    case ot_wavetable:
+        return sizeof(WavetableOscillator);
+    case ot_window:
+        // spawn_osc can fall back to a sine in the same slot
+        return std::max(sizeof(WindowOscillator), sizeof(SineOscillator));
+    case ot_shnoise:
+        return sizeof(SampleAndHoldOscillator);
+    case ot_audioinput:
+        return sizeof(AudioInputOscillator);
+    case ot_FM3:
+        return sizeof(FM3Oscillator);
+    case ot_FM2:
+        return sizeof(FM2Oscillator);
+    case ot_modern:
+        return sizeof(ModernOscillator);
+    case ot_string:
+        return sizeof(StringOscillator);
+    case ot_twist:
+        return sizeof(TwistOscillator);
+    case ot_alias:
+        return sizeof(AliasOscillator);
+    case ot_sine:
+    default:
+        return sizeof(SineOscillator);
+    }
+}
+
 Oscillator::Oscillator(SurgeStorage *storage, OscillatorStorage *oscdata, pdata *localcopy)
     : master_osc(0)
 {
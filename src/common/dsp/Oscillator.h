@@ -35,4 +35,7 @@ Oscillator *spawn_osc(int osctype, SurgeStorage *storage, OscillatorStorage *osc
                       pdata *localcopy, pdata *localcopyUnmod,
                       unsigned char *onto); // This buffer should be at least oscillator_buffer_size
 
+// The bytes spawn_osc needs at onto for this type, which is at most oscillator_buffer_size
+size_t oscillator_slot_size(int osctype);
+
 #endif // SURGE_SRC_COMMON_DSP_OSCILLATOR_H
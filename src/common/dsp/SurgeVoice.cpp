@@ -21,6 +21,7 @@
  */
 
 #include "SurgeVoice.h"
+#include "SurgeMemoryPools.h"
 #include "UserDefaults.h"
 #include "DSPUtils.h"
 #include "QuadFilterChain.h"
@@ -238,6 +239,9 @@ SurgeVoice::SurgeVoice(SurgeStorage *storage, SurgeSceneStorage *oscene, pdata *
     // init subcomponents
     for (int i = 0; i < n_oscs; i++)
     {
+        osc[i] = nullptr;
+        oscslot[i] = nullptr;
+        oscslotList[i] = -1;
         osctype[i] = -1;
     }
 
@@ -526,9 +530,23 @@ void SurgeVoice::switch_toggled()
     {
         if (osctype[i] != scene->osc[i].type.val.i)
         {
+            auto &slots = storage->memoryPools->oscillatorSlots;
+            if (osc[i])
+            {
+                osc[i]->~Oscillator();
+                osc[i] = nullptr;
+            }
+            if (oscslot[i])
+            {
+                slots.returnSlot(oscslotList[i], oscslot[i]);
+            }
+            oscslot[i] = slots.getSlot(scene->osc[i].type.val.i, oscslotList[i]);
+
             bool nzid = scene->drift.extend_range;
-            osc[i] = spawn_osc(scene->osc[i].type.val.i, storage, &scene->osc[i], localcopy,
-                               this->paramptrUnmod, oscbuffer[i]);
+            // With no slot free the synth sizes the pool and toggles us again, see getSlot
+            if (oscslot[i])
+                osc[i] = spawn_osc(scene->osc[i].type.val.i, storage, &scene->osc[i], localcopy,
+                                   this->paramptrUnmod, oscslot[i]);
             if (osc[i])
             {
                 // this matches the override in ::process_block
@@ -539,7 +557,7 @@ void SurgeVoice::switch_toggled()
                     0);
                 osc[i]->init(usep, false, nzid);
             }
-            osctype[i] = scene->osc[i].type.val.i;
+            osctype[i] = osc[i] ? scene->osc[i].type.val.i : -1;
         }
     }
 
@@ -619,6 +637,16 @@ void SurgeVoice::switch_toggled()
                 FBP.FU[u + 2].subtype = scene->filterunit[u].subtype.val.i;
             }
 
+            if (FBP.FU[u].type == sst::filters::fut_comb_pos ||
+                FBP.FU[u].type == sst::filters::fut_comb_neg)
+            {
+                memset(combDelay[u], 0, sizeof(combDelay[u]));
+                if (scene->filterblock_configuration.val.i == fc_wide)
+                {
+                    memset(combDelay[u + 2], 0, sizeof(combDelay[u + 2]));
+                }
+            }
+
             CM[u].Reset();
         }
     }
@@ -727,6 +755,39 @@ int SurgeVoice::routefilter(int r)
     return r;
 }
 
+bool SurgeVoice::canBatchEnvelopes(SurgeStorage *storage, int scene_id)
+{
+    auto &patch = storage->getPatch();
+
+    for (int i = 0; i < n_lfos_voice; ++i)
+    {
+        auto shape = patch.scene[scene_id].lfo[i].shape.val.i;
+
+        if (shape == lt_mseg || shape == lt_formula ||
+            (shape == lt_stepseq && patch.stepsequences[scene_id][i].trigmask != 0))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void SurgeVoice::processEnvelopesBatch(SurgeVoice *const *voices, int n)
+{
+    ADSRModulationSource *aeg[4], *feg[4];
+
+    for (int i = 0; i < n; ++i)
+    {
+        aeg[i] = &voices[i]->ampEGSource;
+        feg[i] = &voices[i]->filterEGSource;
+        voices[i]->envelopesProcessed = true;
+    }
+
+    ADSRModulationSource::processBlockQuad(aeg, n);
+    ADSRModulationSource::processBlockQuad(feg, n);
+}
+
 template <bool first> void SurgeVoice::calc_ctrldata(QuadFilterChainState *Q, int e)
 {
     // Always process LFO1 so the gate retrigger always work
@@ -773,8 +834,16 @@ template <bool first> void SurgeVoice::calc_ctrldata(QuadFilterChainState *Q, in
         }
     }
 
-    modsources[ms_ampeg]->process_block();
-    modsources[ms_filtereg]->process_block();
+    if (envelopesProcessed)
+    {
+        // SurgeSynthesizer already ran this block's envelopes alongside the other voices
+        envelopesProcessed = false;
+    }
+    else
+    {
+        modsources[ms_ampeg]->process_block();
+        modsources[ms_filtereg]->process_block();
+    }
 
     if (((ADSRModulationSource *)modsources[ms_ampeg])->is_idle())
     {
@@ -1381,6 +1450,13 @@ void SurgeVoice::set_path(bool osc1, bool osc2, bool osc3, int FMmode, bool ring
     this->ring12 = ring12;
     this->ring23 = ring23;
     this->noise = noise;
+
+    // Until a voice has a slot for every oscillator it only plays its noise, see getSlot
+    if (!osc[0] || !osc[1] || !osc[2])
+    {
+        this->osc1 = this->osc2 = this->osc3 = false;
+        this->ring12 = this->ring23 = false;
+    }
 }
 
 void SurgeVoice::SetQFB(QuadFilterChainState *Q, int e) // Q == 0 means init(ialise)
@@ -1493,7 +1569,7 @@ void SurgeVoice::SetQFB(QuadFilterChainState *Q, int e) // Q == 0 means init(ial
                     set1f(Q->FU[u].R[i], e, FBP.FU[u].R[i]);
                 }
 
-                Q->FU[u].DB[e] = FBP.Delay[u];
+                Q->FU[u].DB[e] = combDelay[u];
                 Q->FU[u].WP[e] = FBP.FU[u].WP;
 
                 if (scene->filterblock_configuration.val.i == fc_wide)
@@ -1504,7 +1580,7 @@ void SurgeVoice::SetQFB(QuadFilterChainState *Q, int e) // Q == 0 means init(ial
                         set1f(Q->FU[u + 2].R[i], e, FBP.FU[u + 2].R[i]);
                     }
 
-                    Q->FU[u + 2].DB[e] = FBP.Delay[u + 2];
+                    Q->FU[u + 2].DB[e] = combDelay[u + 2];
                     Q->FU[u + 2].WP[e] = FBP.FU[u].WP;
                 }
             }
@@ -1556,8 +1632,16 @@ void SurgeVoice::freeAllocatedElements()
 {
     for (int i = 0; i < n_oscs; ++i)
     {
-        osc[i]->~Oscillator();
-        osc[i] = nullptr;
+        if (osc[i])
+        {
+            osc[i]->~Oscillator();
+            osc[i] = nullptr;
+        }
+        if (oscslot[i])
+        {
+            storage->memoryPools->oscillatorSlots.returnSlot(oscslotList[i], oscslot[i]);
+            oscslot[i] = nullptr;
+        }
         osctype[i] = -1;
     }
     for (int i = 0; i < n_lfos_voice; ++i)
@@ -62,6 +62,16 @@ class alignas(16) SurgeVoice
     void legato(int key, int velocity, char detune);
     void switch_toggled();
     void freeAllocatedElements();
+
+    /*
+     * The amp and filter envelopes of a scene's voices can run four at a time ahead of the voice
+     * loop (see ADSRModulationSource::processBlockQuad) as long as nothing earlier in
+     * calc_ctrldata retriggers them. That holds unless a voice LFO is an MSEG, a formula or a
+     * step sequencer with envelope retrigger steps.
+     */
+    static bool canBatchEnvelopes(SurgeStorage *storage, int scene_id);
+    static void processEnvelopesBatch(SurgeVoice *const *voices, int n);
+    bool envelopesProcessed{false};
     int osctype[n_oscs];
     SurgeVoiceState state;
     int age, age_release;
@@ -245,8 +255,6 @@ class alignas(16) SurgeVoice
     struct
     {
         float Gain, FB, Mix1, Mix2, OutL, OutR, Out2L, Out2R, Drive, wsLPF, FBlineL, FBlineR;
-        float Delay[4][sst::filters::utilities::MAX_FB_COMB +
-                       sst::filters::utilities::SincTable::FIRipol_N];
         struct
         {
             float C[sst::filters::n_cm_coeffs], R[sst::filters::n_filter_registers];
@@ -273,8 +281,10 @@ class alignas(16) SurgeVoice
     int FMmode;
     float noisegenL[2], noisegenR[2];
 
+    // Oscillators live in slots from storage->memoryPools, sized for their type
     Oscillator *osc[n_oscs];
-    unsigned char oscbuffer alignas(16)[n_oscs][oscillator_buffer_size];
+    unsigned char *oscslot[n_oscs];
+    int oscslotList[n_oscs];
 
   public: // this is public, but only for the regtests
     std::array<ModulationSource *, n_modsources> modsources;
@@ -297,6 +307,15 @@ class alignas(16) SurgeVoice
 
     // MPE special cases
     bool mpeEnabled;
+
+  private:
+    /*
+     * The comb filter delay lines are most of the voice's size but only a comb filter touches
+     * them, so they sit after everything processed per block and are only cleared when a filter
+     * unit becomes a comb.
+     */
+    float combDelay alignas(16)[4][sst::filters::utilities::MAX_FB_COMB +
+                                   sst::filters::utilities::SincTable::FIRipol_N];
 };
 
 void all_ring_modes_block(float *__restrict src1_l, float *__restrict src2_l,
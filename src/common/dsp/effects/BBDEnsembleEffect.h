@@ -78,6 +78,7 @@ class BBDEnsembleEffect : public Effect
     virtual void sampleRateReset() override;
     virtual void process(float *dataL, float *dataR) override;
     virtual void suspend() override;
+    virtual bool allowsConcurrentProcessing() override { return true; }
     void setvars(bool init);
     virtual void init_ctrltypes() override;
     virtual void init_default_values() override;
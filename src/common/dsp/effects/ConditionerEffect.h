@@ -44,6 +44,7 @@ class ConditionerEffect : public Effect
     virtual void process(float *dataL, float *dataR) override;
     virtual int get_ringout_decay() override { return 100; }
     virtual void suspend() override;
+    virtual bool allowsConcurrentProcessing() override { return true; }
     void setvars(bool init);
     virtual void init_ctrltypes() override;
     virtual void init_default_values() override;
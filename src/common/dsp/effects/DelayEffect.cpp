@@ -24,6 +24,8 @@
 #include "sst/basic-blocks/mechanics/block-ops.h"
 #include "sst/basic-blocks/dsp/Clippers.h"
 
+#include <algorithm>
+
 namespace mech = sst::basic_blocks::mechanics;
 namespace sdsp = sst::basic_blocks::dsp;
 
@@ -76,6 +78,32 @@ int DelayEffect::group_label_ypos(int id)
     return 0;
 }
 
+int DelayEffect::get_measured_tail_hold()
+{
+    // The output is silent between repeats while the line still holds signal, so wait out the
+    // longer of the two delay times before calling the effect idle. This is asked every quiet
+    // block, so the powf only reruns when one of its inputs has moved.
+    auto tsL = fxdata->p[dly_time_left].temposync ? storage->temposyncratio_inv : 1.f;
+    auto tsR = fxdata->p[dly_time_right].temposync ? storage->temposyncratio_inv : 1.f;
+    float key[tailHoldKeySize] = {*pd_float[dly_time_left],
+                                  *pd_float[dly_time_right],
+                                  tsL,
+                                  tsR,
+                                  fxdata->p[dly_time_right].deactivated ? 1.f : 0.f,
+                                  storage->samplerate};
+
+    if (tailHold >= 0 && std::equal(key, key + tailHoldKeySize, tailHoldKey))
+        return tailHold;
+
+    auto t = tsL * powf(2.f, key[0]);
+    if (!fxdata->p[dly_time_right].deactivated)
+        t = std::max(t, tsR * powf(2.f, key[1]));
+
+    std::copy(key, key + tailHoldKeySize, tailHoldKey);
+    tailHold = (int)(t * storage->samplerate * BLOCK_SIZE_INV) + Effect::get_measured_tail_hold();
+    return tailHold;
+}
+
 void DelayEffect::init_ctrltypes()
 {
     Effect::init_ctrltypes();
@@ -42,9 +42,16 @@ class DelayEffect
     virtual void init_default_values() override;
     virtual const char *group_label(int id) override;
     virtual int group_label_ypos(int id) override;
+    virtual int get_measured_tail_hold() override;
 
     virtual void handleStreamingMismatches(int streamingRevision,
                                            int currentSynthStreamingRevision) override;
+
+  private:
+    // The inputs get_measured_tail_hold last computed tailHold from
+    static constexpr int tailHoldKeySize = 6;
+    float tailHoldKey[tailHoldKeySize]{};
+    int tailHold{-1};
 };
 
 #endif // SURGE_SRC_COMMON_DSP_EFFECTS_DELAYEFFECT_H
@@ -44,6 +44,7 @@ class DistortionEffect : public Effect
     virtual void init() override;
     virtual void process(float *dataL, float *dataR) override;
     virtual void suspend() override;
+    virtual bool allowsConcurrentProcessing() override { return true; }
 
     static constexpr int ringout_time = 1600, ringout_end = 320;
 
@@ -26,12 +26,100 @@
 #include "sst/basic-blocks/mechanics/block-ops.h"
 namespace mech = sst::basic_blocks::mechanics;
 
+#include <algorithm>
+#include <limits>
+
 constexpr int subblock_factor = 3; // divide block by 2^this
 
 std::vector<AirWinBaseClass::Registration> AirWindowsEffect::fxreg;
 std::vector<int> AirWindowsEffect::fxregOrdering;
 AirWindowsEffect::AWFxSelectorMapper AirWindowsEffect::mapper;
 
+namespace
+{
+inline int64_t packSubFXRequest(uint32_t generation, int type)
+{
+    return ((int64_t)(generation & 0x7FFFFFFF) << 32) | (uint32_t)type;
+}
+inline int subFXRequestType(int64_t r) { return (int)(r & 0xFFFFFFFF); }
+} // namespace
+
+AirWindowsSubFXBuilder::AirWindowsSubFXBuilder(SurgeStorage *s) : storage(s)
+{
+    builderThread = std::thread([this]() { run(); });
+}
+
+AirWindowsSubFXBuilder::~AirWindowsSubFXBuilder()
+{
+    {
+        std::lock_guard<std::mutex> g(sleepMutex);
+        running = false;
+    }
+    cv.notify_all();
+
+    if (builderThread.joinable())
+        builderThread.join();
+}
+
+bool AirWindowsSubFXBuilder::add(const std::shared_ptr<AirWindowsSubFXHandoff> &h)
+{
+    return arrivals.push(h);
+}
+
+void AirWindowsSubFXBuilder::wake()
+{
+    {
+        std::lock_guard<std::mutex> g(sleepMutex);
+        workPending = true;
+    }
+    cv.notify_one();
+}
+
+void AirWindowsSubFXBuilder::run()
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lk(sleepMutex);
+            cv.wait(lk, [this]() { return !running || workPending; });
+            if (!running)
+                return;
+            workPending = false;
+        }
+
+        std::shared_ptr<AirWindowsSubFXHandoff> h;
+        while (arrivals.pop(h))
+            handoffs.push_back(std::move(h));
+
+        // Orphaned handoffs are freed here, along with anything still staged or retired in them
+        handoffs.erase(std::remove_if(handoffs.begin(), handoffs.end(),
+                                      [](const auto &q) { return q->orphaned.load(); }),
+                       handoffs.end());
+
+        for (auto &q : handoffs)
+            service(*q);
+    }
+}
+
+void AirWindowsSubFXBuilder::service(AirWindowsSubFXHandoff &h)
+{
+    if (h.hasRetired.load(std::memory_order_acquire))
+    {
+        h.retiredAirwin.reset();
+        h.hasRetired.store(false, std::memory_order_release);
+    }
+
+    if (h.staged.load(std::memory_order_acquire) >= 0)
+        return;
+
+    auto want = h.requested.exchange(-1, std::memory_order_acq_rel);
+    if (want < 0)
+        return;
+
+    h.stagedAirwin = AirWindowsEffect::makeSubFX(storage, subFXRequestType(want));
+    h.staged.store(want, std::memory_order_release);
+}
+
 AirWindowsEffect::AirWindowsEffect(SurgeStorage *storage, FxStorage *fxdata, pdata *pd)
     : Effect(storage, fxdata, pd)
 {
@@ -47,9 +135,29 @@ AirWindowsEffect::AirWindowsEffect(SurgeStorage *storage, FxStorage *fxdata, pda
         param_lags[i].instantize();
         param_lags[i].setRate(0.004 * (BLOCK_SIZE >> subblock_factor));
     }
+    invalidatePushedParams();
+
+    handoff = std::make_shared<AirWindowsSubFXHandoff>();
+    if (!storage || !storage->getAirWindowsBuilder()->add(handoff))
+        handoff.reset();
+}
+
+AirWindowsEffect::~AirWindowsEffect()
+{
+    // The builder frees the handoff, and anything still in it, once it wakes
+    if (handoff)
+    {
+        handoff->orphaned = true;
+        storage->airWindowsBuilder->wake();
+    }
 }
 
-AirWindowsEffect::~AirWindowsEffect() {}
+void AirWindowsEffect::invalidatePushedParams()
+{
+    // NaN never compares equal so the next block pushes everything
+    for (auto &p : lastPushedParam)
+        p = std::numeric_limits<float>::quiet_NaN();
+}
 
 void AirWindowsEffect::init()
 {
@@ -204,9 +312,10 @@ void AirWindowsEffect::process(float *dataL, float *dataR)
 {
     if (fxdata->p[0].deactivated)
     {
-        // We are un-suspended
+        // We are un-suspended. While suspended the formatters poke values into airwin
         fxdata->p[0].deactivated = false;
         hasInvalidated = true;
+        invalidatePushedParams();
     }
 
     if (!airwin || fxdata->p[0].val.i != lastSelected || fxdata->p[0].user_data == nullptr)
@@ -227,9 +336,18 @@ void AirWindowsEffect::process(float *dataL, float *dataR)
         {
             useStreamedValues = true;
         }
-        setupSubFX(fxdata->p[0].val.i, useStreamedValues);
+
+        requestSubFX(fxdata->p[0].val.i, useStreamedValues);
+    }
+    else if (pendingSubFX >= 0)
+    {
+        // Back on the running type before the build arrived, so it is no longer wanted
+        cancelSubFXRequest();
     }
 
+    takeStagedSubFX();
+
+    // A new or reloaded slot passes audio through until its first build arrives
     if (!airwin)
         return;
 
@@ -253,13 +371,21 @@ void AirWindowsEffect::process(float *dataL, float *dataR)
         for (int i = 0; i < airwin->paramCount && i < n_fx_params - 1; ++i)
         {
             param_lags[i].newValue(clamp01(*pd_float[i + 1]));
+
+            float v;
             if (fxdata->p[i + 1].ctrltype == ct_airwindows_param_integral)
             {
-                airwin->setParameter(i, fxdata->p[i + 1].get_value_f01());
+                v = fxdata->p[i + 1].get_value_f01();
             }
             else
             {
-                airwin->setParameter(i, param_lags[i].v);
+                v = param_lags[i].v;
+            }
+
+            if (v != lastPushedParam[i])
+            {
+                airwin->setParameter(i, v);
+                lastPushedParam[i] = v;
             }
             param_lags[i].process();
         }
@@ -280,6 +406,14 @@ void AirWindowsEffect::process(float *dataL, float *dataR)
 }
 
 void AirWindowsEffect::setupSubFX(int sfx, bool useStreamedValues)
+{
+    // Anything in flight is for a type we no longer want
+    cancelSubFXRequest();
+
+    installSubFX(makeSubFX(storage, sfx), sfx, useStreamedValues);
+}
+
+std::unique_ptr<AirWinBaseClass> AirWindowsEffect::makeSubFX(SurgeStorage *storage, int sfx)
 {
     const auto &r = fxreg[sfx];
 
@@ -290,11 +424,77 @@ void AirWindowsEffect::setupSubFX(int sfx, bool useStreamedValues)
 
     int dp = (detailedMode ? 6 : 2);
 
-    airwin = r.create(r.id, storage->dsamplerate, dp); // FIXME
-    airwin->storage = storage;
+    auto res = r.create(r.id, storage->dsamplerate, dp); // FIXME
+    res->storage = storage;
+    return res;
+}
+
+void AirWindowsEffect::requestSubFX(int sfx, bool useStreamedValues)
+{
+    if (pendingSubFX == sfx)
+        return;
+
+    if (!handoff)
+    {
+        setupSubFX(sfx, useStreamedValues);
+        return;
+    }
+
+    pendingSubFX = sfx;
+    pendingUseStreamedValues = useStreamedValues;
+    pendingRequest = packSubFXRequest(++requestGeneration, sfx);
+    handoff->requested.store(pendingRequest, std::memory_order_release);
+    storage->airWindowsBuilder->wake();
+}
+
+void AirWindowsEffect::cancelSubFXRequest()
+{
+    // A build already under way still arrives, and is retired since it matches nothing
+    pendingSubFX = -1;
+    pendingRequest = -1;
+    if (handoff)
+        handoff->requested.store(-1, std::memory_order_release);
+}
+
+void AirWindowsEffect::takeStagedSubFX()
+{
+    if (!handoff)
+        return;
+
+    auto &h = *handoff;
+    auto st = h.staged.load(std::memory_order_acquire);
+
+    // Wait for the builder to free the last one we gave back before giving it another
+    if (st < 0 || h.hasRetired.load(std::memory_order_acquire))
+        return;
+
+    if (st == pendingRequest)
+    {
+        h.retiredAirwin = std::move(airwin);
+        installSubFX(std::move(h.stagedAirwin), subFXRequestType(st), pendingUseStreamedValues);
+        pendingSubFX = -1;
+        pendingRequest = -1;
+    }
+    else
+    {
+        // Superseded by a later request (or a synchronous setup) while it was being built
+        h.retiredAirwin = std::move(h.stagedAirwin);
+    }
+
+    h.staged.store(-1, std::memory_order_release);
+    if (h.retiredAirwin)
+    {
+        h.hasRetired.store(true, std::memory_order_release);
+    }
+    storage->airWindowsBuilder->wake();
+}
+
+void AirWindowsEffect::installSubFX(std::unique_ptr<AirWinBaseClass> &&a, int sfx,
+                                    bool useStreamedValues)
+{
+    airwin = std::move(a);
+    invalidatePushedParams();
 
-    char fxname[1024];
-    airwin->getEffectName(fxname);
     lastSelected = sfx;
     resetCtrlTypes(useStreamedValues);
 
@@ -311,5 +511,6 @@ void AirWindowsEffect::setupSubFX(int sfx, bool useStreamedValues)
 void AirWindowsEffect::updateAfterReload()
 {
     fxdata->p[0].deactivated = true; // assume I'm suspended unless I run
-    setupSubFX(fxdata->p[0].val.i, true);
+    // This runs on the audio thread when a patch or preset is loaded, so build off it
+    requestSubFX(fxdata->p[0].val.i, true);
 }
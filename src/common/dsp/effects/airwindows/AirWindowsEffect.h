@@ -26,9 +26,68 @@
 #include "Effect.h"
 #include "airwindows/AirWinBaseClass.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include "UserDefaults.h"
 #include "StringOps.h"
+#include "MPSCQueue.h"
+
+/*
+ * Creating an Airwindows processor allocates, so process() asks a background thread to build
+ * it. When the type changes while an effect is running (automation, a UI change, a preset load
+ * into a running slot) the previous processor keeps running until the new one arrives; a new or
+ * reloaded slot with no processor yet passes audio through.
+ *
+ * Each handoff is a single slot owned by whoever last wrote its atomic: requested (audio to
+ * builder), staged (builder to audio) and retired (audio back to builder, which frees it).
+ * Requests carry a generation with the type, so a build which was overtaken by later requests
+ * is dropped even if they came back round to the same type.
+ *
+ * The handoff is shared between the effect and the builder. The effect only marks it orphaned
+ * and wakes the builder when it goes away, and the builder frees it, with anything still staged
+ * in it.
+ */
+struct AirWindowsSubFXHandoff
+{
+    // (generation << 32) | type, or -1 for none
+    std::atomic<int64_t> requested{-1}, staged{-1};
+    std::atomic<bool> hasRetired{false}, orphaned{false};
+    std::unique_ptr<AirWinBaseClass> stagedAirwin, retiredAirwin;
+};
+
+/*
+ * One builder thread per SurgeStorage, started by its first Airwindows effect, and asleep until
+ * woken. Effects register by pushing their handoff onto a lock-free queue. wake() only holds the
+ * builder's mutex to set a flag, and the builder never builds with it held, so neither waits on
+ * a build.
+ */
+struct AirWindowsSubFXBuilder
+{
+    explicit AirWindowsSubFXBuilder(SurgeStorage *storage);
+    ~AirWindowsSubFXBuilder();
+
+    // Any thread. Fails only when the registration queue is full
+    bool add(const std::shared_ptr<AirWindowsSubFXHandoff> &h);
+    // Any thread
+    void wake();
+
+  private:
+    void run();
+    void service(AirWindowsSubFXHandoff &h);
+
+    SurgeStorage *storage;
+    Surge::MPSCQueue<std::shared_ptr<AirWindowsSubFXHandoff>, 64> arrivals;
+    std::vector<std::shared_ptr<AirWindowsSubFXHandoff>> handoffs; // builder thread only
+
+    std::thread builderThread;
+    std::mutex sleepMutex;
+    std::condition_variable cv;
+    bool running{true}, workPending{false}; // guarded by sleepMutex
+};
 
 class alignas(16) AirWindowsEffect : public Effect
 {
@@ -69,9 +128,26 @@ class alignas(16) AirWindowsEffect : public Effect
     lag<float, true> param_lags[n_fx_params - 1];
 
     void setupSubFX(int awfx, bool useStreamedValues);
+    static std::unique_ptr<AirWinBaseClass> makeSubFX(SurgeStorage *storage, int awfx);
+    void installSubFX(std::unique_ptr<AirWinBaseClass> &&a, int awfx, bool useStreamedValues);
     std::unique_ptr<AirWinBaseClass> airwin;
     int lastSelected = -1;
 
+    // See AirWindowsSubFXHandoff. Null if the builder could not take us, in which case type
+    // changes are built in place
+    std::shared_ptr<AirWindowsSubFXHandoff> handoff;
+    uint32_t requestGeneration{0};
+    int64_t pendingRequest{-1};
+    int pendingSubFX{-1};
+    bool pendingUseStreamedValues{false};
+    void requestSubFX(int awfx, bool useStreamedValues);
+    void cancelSubFXRequest();
+    void takeStagedSubFX();
+
+    // What we last handed to airwin->setParameter, so unchanged values aren't pushed every block
+    float lastPushedParam[n_fx_params - 1];
+    void invalidatePushedParams();
+
     void sampleRateReset() override
     {
         if (airwin)
@@ -59,6 +59,7 @@ class ExciterEffect : public Effect
     virtual void init() override;
     virtual void process(float *dataL, float *dataR) override;
     virtual void suspend() override;
+    virtual bool allowsConcurrentProcessing() override { return true; }
 
     virtual void init_ctrltypes() override;
     virtual void init_default_values() override;
@@ -71,6 +71,7 @@ class SpringReverbEffect : public Effect
     void init() override;
     void process(float *dataL, float *dataR) override;
     void suspend() override;
+    bool allowsConcurrentProcessing() override { return true; }
 
     void init_ctrltypes() override;
     void init_default_values() override;
@@ -77,6 +77,7 @@ class TapeEffect : public Effect
     virtual void sampleRateReset() override;
     virtual void process(float *dataL, float *dataR) override;
     virtual void suspend() override;
+    virtual bool allowsConcurrentProcessing() override { return true; }
     virtual int get_ringout_decay() override { return -1; };
 
     virtual void init_ctrltypes() override;
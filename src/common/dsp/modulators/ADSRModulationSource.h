@@ -459,7 +459,175 @@ class ADSRModulationSource : public ModulationSource
 
     int getEnvState() { return envstate; }
 
+    /*
+    ** Runs process_block for up to four envelopes at once, one per SSE lane, the way
+    ** QuadFilterChainState runs four voices through a filter. The digital attack, linear and
+    ** quadratic decay, release and idle stages use the same float operations as the scalar
+    ** switch above, lane by lane, so the results are bit identical. Analog mode and the cubic
+    ** decay need a per lane powf so those envelopes just run the scalar process_block.
+    */
+    static void processBlockQuad(ADSRModulationSource *const *envs, int n)
+    {
+        assert(n >= 0 && n <= 4);
+
+        ADSRModulationSource *lane[4];
+        // Unused lanes are left in a state which matches no stage and are never written back
+        float ph alignas(16)[4]{}, rt alignas(16)[4]{}, sus alignas(16)[4]{};
+        float dc alignas(16)[4]{}, sc alignas(16)[4]{}, out alignas(16)[4]{};
+        int32_t st alignas(16)[4]{-1, -1, -1, -1};
+        int32_t ash alignas(16)[4]{}, dsh alignas(16)[4]{}, rsh alignas(16)[4]{};
+        int32_t rg alignas(16)[4]{};
+        int nl = 0;
+
+        for (int i = 0; i < n; ++i)
+        {
+            auto *e = envs[i];
+            auto *lc = e->lc;
+
+            if (lc[e->mode].b || (e->envstate == s_decay && lc[e->d_s].i == 2) ||
+                lc[e->r_s].i > 2)
+            {
+                e->process_block();
+                continue;
+            }
+
+            lane[nl] = e;
+            ph[nl] = e->phase;
+            rt[nl] = e->stageRate();
+            sus[nl] = lc[e->s].f;
+            dc[nl] = lc[e->d].f;
+            sc[nl] = e->scalestage;
+            out[nl] = e->output;
+            st[nl] = e->envstate;
+            ash[nl] = lc[e->a_s].i;
+            dsh[nl] = lc[e->d_s].i;
+            rsh[nl] = lc[e->r_s].i;
+            rg[nl] = e->adsr->r.deform_type ? 1 : 0;
+            nl++;
+        }
+
+        if (nl == 0)
+            return;
+
+        const auto vzero = _mm_setzero_ps();
+        const auto vone = _mm_set1_ps(1.f);
+
+        auto sel = [](__m128 m, __m128 a, __m128 b) {
+            return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+        };
+        auto ieq = [](const int32_t *v, int c) {
+            return _mm_castsi128_ps(
+                _mm_cmpeq_epi32(_mm_load_si128((const __m128i *)v), _mm_set1_epi32(c)));
+        };
+        auto igt = [](const int32_t *v, int c) {
+            return _mm_castsi128_ps(
+                _mm_cmpgt_epi32(_mm_load_si128((const __m128i *)v), _mm_set1_epi32(c)));
+        };
+        // limit_range is std::clamp, which returns x when either compare fails (say on a NaN)
+        auto clamp = [&sel](__m128 x, __m128 lo, __m128 hi) {
+            auto below = _mm_cmplt_ps(x, lo);
+            auto above = _mm_andnot_ps(below, _mm_cmplt_ps(hi, x));
+            return sel(below, lo, sel(above, hi, x));
+        };
+
+        auto phase = _mm_load_ps(ph);
+        auto rate = _mm_load_ps(rt);
+        auto S = _mm_load_ps(sus);
+        auto prior = _mm_load_ps(out);
+
+        // Attack
+        auto aph = _mm_add_ps(phase, rate);
+        aph = sel(_mm_cmpge_ps(aph, vone), vone, aph);
+        auto aout = prior;
+        aout = sel(ieq(ash, 0), _mm_sqrt_ps(aph), aout);
+        aout = sel(ieq(ash, 1), aph, aout);
+        aout = sel(ieq(ash, 2), _mm_mul_ps(aph, aph), aout);
+
+        // Decay. phase < 1e-4 and lc[s] < 1e-3 compare in double in the scalar code; for a
+        // float those are exactly phase <= 1e-4f and lc[s] < 1e-3f
+        auto sx2r = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(2.f), _mm_sqrt_ps(phase)), rate);
+        auto rr = _mm_mul_ps(rate, rate);
+        auto qlo = _mm_add_ps(_mm_sub_ps(phase, sx2r), rr);
+        auto qhi = _mm_add_ps(_mm_add_ps(phase, sx2r), rr);
+        auto lowSus = _mm_and_ps(_mm_cmplt_ps(S, _mm_set1_ps(1e-3f)),
+                                 _mm_cmple_ps(phase, _mm_set1_ps(1e-4f)));
+        auto zeroSus = _mm_and_ps(_mm_cmpeq_ps(S, vzero),
+                                  _mm_cmplt_ps(_mm_load_ps(dc), _mm_set1_ps(-7.f)));
+        auto toZero = _mm_or_ps(lowSus, zeroSus);
+        qlo = _mm_andnot_ps(toZero, qlo);
+        qlo = sel(_mm_and_ps(_mm_cmpgt_ps(rate, vone), _mm_cmpgt_ps(qlo, S)), S, qlo);
+        auto isQuad = ieq(dsh, 1);
+        auto dph = clamp(S, sel(isQuad, qlo, _mm_sub_ps(phase, rate)),
+                         sel(isQuad, qhi, _mm_add_ps(phase, rate)));
+
+        // Release and uber release
+        auto rph = _mm_sub_ps(phase, rate);
+        auto rout = rph;
+        rout = sel(igt(rsh, 0), _mm_mul_ps(rout, rph), rout);
+        rout = sel(igt(rsh, 1), _mm_mul_ps(rout, rph), rout);
+        rout = _mm_mul_ps(rout, _mm_load_ps(sc));
+        rout = sel(igt(rg, 0), prior, rout);
+        rout = _mm_andnot_ps(_mm_cmplt_ps(rph, vzero), rout);
+
+        auto isA = ieq(st, s_attack);
+        auto isD = ieq(st, s_decay);
+        auto isR = _mm_or_ps(ieq(st, s_release), ieq(st, s_uberrelease));
+
+        phase = sel(isA, aph, sel(isD, dph, sel(isR, rph, phase)));
+        prior = sel(isA, aout, sel(isD, dph, sel(isR, rout, prior)));
+        prior = clamp(prior, vzero, vone);
+
+        _mm_store_ps(ph, phase);
+        _mm_store_ps(out, prior);
+
+        for (int i = 0; i < nl; ++i)
+        {
+            auto *e = lane[i];
+            e->phase = ph[i];
+            e->output = out[i];
+
+            switch (e->envstate)
+            {
+            case s_attack:
+                if (ph[i] >= 1)
+                {
+                    e->envstate = s_decay;
+                    e->sustain = sus[i];
+                }
+                break;
+            case s_release:
+            case s_uberrelease:
+                if (ph[i] < 0)
+                    e->envstate = s_idle;
+                break;
+            case s_idle:
+                e->idlecount++;
+                break;
+            }
+        }
+    }
+
   private:
+    // The per block phase increment of the current digital stage, as process_block computes it
+    float stageRate() const
+    {
+        switch (envstate)
+        {
+        case s_attack:
+            return storage->envelope_rate_linear_nowrap(lc[a].f) *
+                   (adsr->a.temposync ? storage->temposyncratio : 1.f);
+        case s_decay:
+            return storage->envelope_rate_linear_nowrap(lc[d].f) *
+                   (adsr->d.temposync ? storage->temposyncratio : 1.f);
+        case s_release:
+            return storage->envelope_rate_linear_nowrap(lc[r].f) *
+                   (adsr->r.temposync ? storage->temposyncratio : 1.f);
+        case s_uberrelease:
+            return storage->envelope_rate_linear_nowrap(-6.5);
+        }
+        return 0.f;
+    }
+
     ADSRStorage *adsr = nullptr;
     SurgeVoiceState *state = nullptr;
     SurgeStorage *storage = nullptr;
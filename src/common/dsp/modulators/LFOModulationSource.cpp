@@ -1184,6 +1184,7 @@ void LFOModulationSource::process_block()
     case lt_mseg:
     {
         msegstate.released = (env_state == lfoeg_release || env_state == lfoeg_msegrelease);
+        msegstate.allowBakedLookup = storage->msegBakedLookup;
 
         iout = Surge::MSEG::valueAt(unwrappedphase_intpart, phase, localcopy[ideform].f, ms,
                                     &msegstate);
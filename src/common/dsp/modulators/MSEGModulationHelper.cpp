@@ -21,6 +21,7 @@
  */
 
 #include "MSEGModulationHelper.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include "DebugHelpers.h"
@@ -32,7 +33,99 @@ namespace Surge
 namespace MSEG
 {
 
-void rebuildCache(MSEGStorage *ms)
+/*
+ * The first active segment holding t, where closedEnd also counts t == segmentEnd. When the
+ * segments are ordered the answer for forward playback is at the cursor or just after it and
+ * anything else is a binary search on the segment ends; otherwise this is a plain scan.
+ */
+static int findSegment(MSEGStorage *ms, double t, bool closedEnd, int &cursor)
+{
+    int n = ms->n_activeSegments;
+
+    auto holds = [ms, t, closedEnd](int i) {
+        return t >= ms->segmentStart[i] &&
+               (closedEnd ? t <= ms->segmentEnd[i] : t < ms->segmentEnd[i]);
+    };
+
+    if (!ms->segmentsOrdered)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            if (holds(i))
+            {
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+    // Once t is past the end of i - 1, no earlier segment can hold it
+    auto firstHolding = [ms, t, n, &holds](int i) {
+        return i >= 0 && i < n && holds(i) && (i == 0 || t > ms->segmentEnd[i - 1]);
+    };
+
+    if (firstHolding(cursor))
+    {
+        return cursor;
+    }
+
+    if (firstHolding(cursor + 1))
+    {
+        return ++cursor;
+    }
+
+    auto b = ms->segmentEnd.begin(), e = b + n;
+    auto it = closedEnd ? std::lower_bound(b, e, t, [](float se, double v) { return se < v; })
+                        : std::upper_bound(b, e, t, [](double v, float se) { return v < se; });
+    int idx = (int)(it - b);
+
+    if (idx < n && holds(idx))
+    {
+        cursor = idx;
+        return idx;
+    }
+
+    return -1;
+}
+
+static void bakeLookup(MSEGStorage *ms, bool bake)
+{
+    ms->bakedLookupValid = false;
+    ms->bakedLookupUsesDeform = false;
+
+    if (!bake || ms->editMode != MSEGStorage::LFO || ms->n_activeSegments <= 0)
+    {
+        return;
+    }
+
+    for (int i = 0; i < ms->n_activeSegments; ++i)
+    {
+        auto &seg = ms->segments[i];
+
+        if (seg.type == MSEGStorage::segment::BROWNIAN || seg.retriggerAEG || seg.retriggerFEG)
+        {
+            return;
+        }
+
+        ms->bakedLookupUsesDeform = ms->bakedLookupUsesDeform || seg.useDeform;
+    }
+
+    static constexpr int n = MSEGStorage::bakedLookupSize;
+    EvaluatorState es(0);
+
+    for (int i = 0; i < n; ++i)
+    {
+        ms->bakedLookup[i] = valueAt(0, (float)i / n, 0.f, ms, &es);
+    }
+
+    // The last point is the end of the cycle, not the start of the next one
+    ms->bakedLookup[n] = valueAt(0, std::nextafter(1.f, 0.f), 0.f, ms, &es);
+
+    ms->bakedLookupValid = true;
+}
+
+void rebuildCache(MSEGStorage *ms, bool bake)
 {
     forceToConstrainedNormalForm(ms);
 
@@ -114,6 +207,19 @@ void rebuildCache(MSEGStorage *ms)
             ms->segmentEnd[(ms->loop_end >= 0 ? ms->loop_end : ms->n_activeSegments - 1)] -
             ms->segmentStart[(ms->loop_start >= 0 ? ms->loop_start : 0)];
     }
+
+    ms->segmentsOrdered = true;
+
+    for (int i = 0; i < ms->n_activeSegments; ++i)
+    {
+        if (ms->segmentEnd[i] < ms->segmentStart[i] ||
+            (i > 0 && ms->segmentStart[i] < ms->segmentEnd[i - 1]))
+        {
+            ms->segmentsOrdered = false;
+        }
+    }
+
+    bakeLookup(ms, bake);
 }
 
 float valueAt(int ip, float fup, float df, MSEGStorage *ms, EvaluatorState *es, bool forceOneShot)
@@ -149,6 +255,20 @@ float valueAt(int ip, float fup, float df, MSEGStorage *ms, EvaluatorState *es,
         es->loopState = EvaluatorState::RELEASING;
     }
 
+    if (es->allowBakedLookup && ms->bakedLookupValid && (df == 0 || !ms->bakedLookupUsesDeform) &&
+        (es->loopState == EvaluatorState::PLAYING ||
+         ms->loopMode != MSEGStorage::LoopMode::GATED_LOOP))
+    {
+        static constexpr int n = MSEGStorage::bakedLookupSize;
+        float x = (float)((up - std::floor(up)) * n);
+        int i = std::min((int)x, n - 1);
+        float frac = x - i;
+
+        es->lastOutput = ms->bakedLookup[i] + frac * (ms->bakedLookup[i + 1] - ms->bakedLookup[i]);
+
+        return es->lastOutput;
+    }
+
     int idx = -1;
 
     if (es->loopState == EvaluatorState::PLAYING ||
@@ -157,7 +277,7 @@ float valueAt(int ip, float fup, float df, MSEGStorage *ms, EvaluatorState *es,
         idx = timeToSegment(ms, up,
                             forceOneShot || ms->loopMode == MSEGStorage::ONESHOT ||
                                 ms->editMode == MSEGStorage::LFO,
-                            timeAlongSegment);
+                            timeAlongSegment, es->segmentCursor);
 
         if (idx < 0 || idx >= ms->n_activeSegments)
         {
@@ -182,15 +302,7 @@ float valueAt(int ip, float fup, float df, MSEGStorage *ms, EvaluatorState *es,
             double adjustedPhase = up - es->releaseStartPhase + ms->segmentEnd[ms->loop_end];
 
             // so now find the index
-            idx = -1;
-
-            for (int ai = 0; ai < ms->n_activeSegments && idx < 0; ai++)
-            {
-                if (ms->segmentStart[ai] <= adjustedPhase && ms->segmentEnd[ai] > adjustedPhase)
-                {
-                    idx = ai;
-                }
-            }
+            idx = findSegment(ms, adjustedPhase, false, es->segmentCursor);
 
             if (idx < 0)
             {
@@ -729,6 +841,13 @@ int timeToSegment(MSEGStorage *ms, double t)
 }
 
 int timeToSegment(MSEGStorage *ms, double t, bool ignoreLoops, float &amountAlongSegment)
+{
+    int cursor = 0;
+    return timeToSegment(ms, t, ignoreLoops, amountAlongSegment, cursor);
+}
+
+int timeToSegment(MSEGStorage *ms, double t, bool ignoreLoops, float &amountAlongSegment,
+                  int &cursor)
 {
     if (ms->totalDuration < MSEGStorage::minimumDuration)
     {
@@ -749,17 +868,11 @@ int timeToSegment(MSEGStorage *ms, double t, bool ignoreLoops, float &amountAlon
             }
         }
 
-        int idx = -1;
+        int idx = findSegment(ms, t, false, cursor);
 
-        for (int i = 0; i < ms->n_activeSegments; ++i)
+        if (idx >= 0)
         {
-            if (t >= ms->segmentStart[i] && t < ms->segmentEnd[i])
-            {
-                idx = i;
-                amountAlongSegment = t - ms->segmentStart[i];
-
-                break;
-            }
+            amountAlongSegment = t - ms->segmentStart[idx];
         }
 
         return idx;
@@ -773,13 +886,14 @@ int timeToSegment(MSEGStorage *ms, double t, bool ignoreLoops, float &amountAlon
         // So are we before the first loop end point
         if (t <= ms->durationToLoopEnd)
         {
-            for (int i = 0; i < ms->n_activeSegments; ++i)
-                if (t >= ms->segmentStart[i] && t <= ms->segmentEnd[i])
-                {
-                    amountAlongSegment = t - ms->segmentStart[i];
+            int idx = findSegment(ms, t, true, cursor);
 
-                    return i;
-                }
+            if (idx >= 0)
+            {
+                amountAlongSegment = t - ms->segmentStart[idx];
+
+                return idx;
+            }
         }
         else if (ms->loop_start > ms->loop_end && ms->loop_start >= 0 && ms->loop_end >= 0)
         {
@@ -807,13 +921,14 @@ int timeToSegment(MSEGStorage *ms, double t, bool ignoreLoops, float &amountAlon
             // and we need to offset it by the starting point
             nt += ms->segmentStart[ls];
 
-            for (int i = 0; i < ms->n_activeSegments; ++i)
-                if (nt >= ms->segmentStart[i] && nt <= ms->segmentEnd[i])
-                {
-                    amountAlongSegment = nt - ms->segmentStart[i];
+            int idx = findSegment(ms, nt, true, cursor);
 
-                    return i;
-                }
+            if (idx >= 0)
+            {
+                amountAlongSegment = nt - ms->segmentStart[idx];
+
+                return idx;
+            }
         }
 
         return 0;
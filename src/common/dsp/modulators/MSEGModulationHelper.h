@@ -29,7 +29,11 @@ namespace Surge
 {
 namespace MSEG
 {
-void rebuildCache(MSEGStorage *ms);
+/*
+ * bake fills MSEGStorage::bakedLookup when the shape allows it. Pass
+ * SurgeStorage::msegBakedLookup, since nothing reads the table while that is off.
+ */
+void rebuildCache(MSEGStorage *ms, bool bake = false);
 
 struct EvaluatorState
 {
@@ -39,7 +43,13 @@ struct EvaluatorState
         gen = std::minstd_rand(rd());
         urd = std::uniform_real_distribution<float>(-1.0, 1.0);
     }
+    // Skips the random device, for evaluators which never reach a Brownian segment
+    explicit EvaluatorState(long seedWith) : gen(seedWith), urd(-1.0, 1.0) {}
     int lastEval = -1;
+    // Where the last segment lookup landed; forward playback finds its segment here or just after
+    int segmentCursor = 0;
+    // Read MSEGStorage::bakedLookup when it applies, set from SurgeStorage::msegBakedLookup
+    bool allowBakedLookup = false;
     float lastOutput = 0;
     // 6 is NOT the number of LFOs, but number of MSEG state elements!
     // TODO: replace 6 with a constexpr!
@@ -66,6 +76,8 @@ float valueAt(int phaseIntPart, float phaseFracPart, float deform, MSEGStorage *
 */
 int timeToSegment(MSEGStorage *ms, double t); // these are double to deal with very long phases
 int timeToSegment(MSEGStorage *ms, double t, bool ignoreLoops, float &timeAlongSegment);
+int timeToSegment(MSEGStorage *ms, double t, bool ignoreLoops, float &timeAlongSegment,
+                  int &cursor);
 void changeTypeAt(MSEGStorage *ms, float t, MSEGStorage::segment::Type type);
 void insertAfter(MSEGStorage *ms, float t);
 void insertBefore(MSEGStorage *ms, float t);
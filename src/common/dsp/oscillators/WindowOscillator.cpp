@@ -89,12 +89,12 @@ void WindowOscillator::init(float pitch, bool is_display, bool nonzero_init_drif
 
         if (oscdata->retrigger.val.b || is_display)
         {
-            Window.Pos[0] = (storage->WindowWT.size + storage->WindowWT.size) << 16;
+            Window.Pos[0] = (storage->WindowWT->size + storage->WindowWT->size) << 16;
         }
         else
         {
             Window.Pos[0] =
-                (storage->WindowWT.size + (storage->rand() & (storage->WindowWT.size - 1))) << 16;
+                (storage->WindowWT->size + (storage->rand() & (storage->WindowWT->size - 1))) << 16;
         }
 
         Window.driftLFO[0].init(nonzero_init_drift);
@@ -123,12 +123,12 @@ void WindowOscillator::init(float pitch, bool is_display, bool nonzero_init_drif
             if (oscdata->retrigger.val.b)
             {
                 Window.Pos[i] =
-                    (storage->WindowWT.size + ((storage->WindowWT.size * i) / NumUnison)) << 16;
+                    (storage->WindowWT->size + ((storage->WindowWT->size * i) / NumUnison)) << 16;
             }
             else
             {
                 Window.Pos[i] =
-                    (storage->WindowWT.size + (storage->rand() & (storage->WindowWT.size - 1)))
+                    (storage->WindowWT->size + (storage->rand() & (storage->WindowWT->size - 1)))
                     << 16;
             }
 
@@ -200,7 +200,7 @@ template <bool FM, bool Full16> void WindowOscillator::ProcessWindowOscs(bool st
 {
     const unsigned int M0Mask = 0x07f8;
     unsigned int SizeMask = (oscdata->wt.size << 16) - 1;
-    unsigned int SizeMaskWin = (storage->WindowWT.size << 16) - 1;
+    unsigned int SizeMaskWin = (storage->WindowWT->size << 16) - 1;
 
     unsigned char SelWindow = limit_range(oscdata->p[win_window].val.i, 0, 8);
 
@@ -221,7 +221,7 @@ template <bool FM, bool Full16> void WindowOscillator::ProcessWindowOscs(bool st
                                    localcopy[oscdata->p[win_formant].param_id_in_scene].f));
 
     // We can actually get input tables bigger than the convolution table
-    int WindowVsWavePO2 = storage->WindowWT.size_po2 - oscdata->wt.size_po2;
+    int WindowVsWavePO2 = storage->WindowWT->size_po2 - oscdata->wt.size_po2;
 
     if (WindowVsWavePO2 < 0)
     {
@@ -262,11 +262,11 @@ template <bool FM, bool Full16> void WindowOscillator::ProcessWindowOscs(bool st
                 MipMapB = limit_range((int)MSBpos - 17, 0, oscdata->wt.size_po2 - 1);
 
             if (_BitScanReverse(&MSBpos, 3 * RatioA))
-                MipMapA = limit_range((int)MSBpos - 17, 0, storage->WindowWT.size_po2 - 1);
+                MipMapA = limit_range((int)MSBpos - 17, 0, storage->WindowWT->size_po2 - 1);
 
             short *WaveAdr = oscdata->wt.TableI16WeakPointers[MipMapB][Window.Table[0][so]];
             short *WaveAdrP1 = oscdata->wt.TableI16WeakPointers[MipMapB][Window.Table[1][so]];
-            short *WinAdr = storage->WindowWT.TableI16WeakPointers[MipMapA][SelWindow];
+            short *WinAdr = storage->WindowWT->TableI16WeakPointers[MipMapA][SelWindow];
 
             for (int i = 0; i < BLOCK_SIZE_OS; i++)
             {
@@ -391,7 +391,7 @@ void WindowOscillator::process_block(float pitch, float drift, bool stereo, bool
 
         float f = storage->note_to_pitch(pitch + drift * Window.driftLFO[l].val() +
                                          Detune * (DetuneOffset + DetuneBias * (float)l));
-        int Ratio = Float2Int(8.175798915f * 32768.f * f * (float)(storage->WindowWT.size) *
+        int Ratio = Float2Int(8.175798915f * 32768.f * f * (float)(storage->WindowWT->size) *
                               storage->samplerate_inv); // (65536.f*0.5f), 0.5 for oversampling
 
         Window.Ratio[l] = Ratio;
@@ -405,9 +405,9 @@ void WindowOscillator::process_block(float pitch, float drift, bool stereo, bool
                 float fmadj = (1.0 + FMdepth[l].v * master_osc[i]);
                 float f = storage->note_to_pitch(pitch + drift * Window.driftLFO[l].val() +
                                                  Detune * (DetuneOffset + DetuneBias * (float)l));
-                int Ratio =
-                    Float2Int(8.175798915f * 32768.f * f * fmadj * (float)(storage->WindowWT.size) *
-                              storage->samplerate_inv); // (65536.f*0.5f), 0.5 for oversampling
+                // (65536.f*0.5f), 0.5 for oversampling
+                int Ratio = Float2Int(8.175798915f * 32768.f * f * fmadj *
+                                      (float)(storage->WindowWT->size) * storage->samplerate_inv);
 
                 Window.FMRatio[l][i] = Ratio;
                 FMdepth[l].process();
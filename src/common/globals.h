@@ -79,6 +79,9 @@ const int BASE_WINDOW_SIZE_X = 913;
 const int BASE_WINDOW_SIZE_Y = 569;
 const int NAMECHARS = 64;
 const int BLOCK_SIZE = SURGE_COMPILE_BLOCK_SIZE;
+// Block positions wrap with & (BLOCK_SIZE - 1) and Airwindows splits a block into 8 sub blocks
+static_assert(BLOCK_SIZE >= 8 && (BLOCK_SIZE & (BLOCK_SIZE - 1)) == 0,
+              "SURGE_COMPILE_BLOCK_SIZE must be a power of two and at least 8");
 const int OSC_OVERSAMPLING = 2;
 const int BLOCK_SIZE_OS = OSC_OVERSAMPLING * BLOCK_SIZE;
 const int BLOCK_SIZE_QUAD = BLOCK_SIZE >> 2;
@@ -99,4 +102,6 @@ const int DEFAULT_POLYLIMIT = 16;
 const int DEFAULT_OSC_PORT_IN = 53280;
 const int DEFAULT_OSC_PORT_OUT = 53281;
 const std::string DEFAULT_OSC_IPADDR_OUT = "127.0.0.1";
+// Timestamped OSC bundles are scheduled this far behind their timetag to absorb network jitter
+const int DEFAULT_OSC_SCHEDULING_LATENCY_MS = 10;
 #endif // SURGE_SRC_COMMON_GLOBALS_H
@@ -150,7 +150,9 @@ void FXOpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
     std::string throwaway;
     std::getline(split, throwaway, '/');
 
-    // The only message accepted here is "/fx/param/<n>", where n >= 1 and n <= 12
+    // Messages accepted here are "/fx/param/<n>", where n >= 1 and n <= 12, and the chain
+    // messages "/fx/chain/mode", "/fx/chain/<s>/type", "/fx/chain/<s>/bypass" and
+    // "/fx/chain/<s>/param/<n>", where s >= 1 and s <= the number of chain slots
     std::string addr_part = "";
     std::getline(split, addr_part, '/');
 
@@ -187,6 +189,91 @@ void FXOpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
             sfxPtr->oscRingBuf.push(SurgefxAudioProcessor::oscToAudio(
                 SurgefxAudioProcessor::FX_PARAM, newval, index - 1));
         }
+        else if (addr_part == "chain")
+        {
+            chainMessageReceived(split, message);
+        }
+    }
+}
+
+void FXOpenSoundControl::chainMessageReceived(std::istringstream &split,
+                                              const juce::OSCMessage &message)
+{
+    if (message.size() < 1 || !(message[0].isFloat32() || message[0].isInt32()))
+    {
+        storage->reportError("Expected a numeric value.", "OSC input error");
+        return;
+    }
+
+    float val = message[0].isFloat32() ? message[0].getFloat32() : message[0].getInt32();
+
+    std::string addr_part = "";
+    std::getline(split, addr_part, '/');
+
+    // Chain changes are made on the message thread; we are called on the OSC thread
+    auto sfx = sfxPtr;
+
+    if (addr_part == "mode")
+    {
+        juce::MessageManager::callAsync([sfx, val]() { sfx->chainMode = val > 0.5f; });
+        return;
+    }
+
+    int slot = 0;
+    try
+    {
+        slot = std::stoi(addr_part);
+    }
+    catch (const std::exception &e)
+    {
+        storage->reportError("Bad format for FX chain slot.", "OSC input error");
+        return;
+    }
+
+    if (slot < 1 || slot > SurgefxAudioProcessor::n_chain_slots)
+    {
+        storage->reportError(fmt::format("Bad FX chain slot. Must be 1-{:d}.",
+                                         SurgefxAudioProcessor::n_chain_slots),
+                             "OSC input error");
+        return;
+    }
+    slot--;
+
+    std::getline(split, addr_part, '/');
+
+    if (addr_part == "type")
+    {
+        int type = (int)std::round(val);
+        juce::MessageManager::callAsync([sfx, slot, type]() { sfx->setChainSlotType(slot, type); });
+    }
+    else if (addr_part == "bypass")
+    {
+        juce::MessageManager::callAsync(
+            [sfx, slot, val]() { sfx->setChainSlotBypass(slot, val > 0.5f); });
+    }
+    else if (addr_part == "param")
+    {
+        std::getline(split, addr_part, '/');
+
+        int index = 0;
+        try
+        {
+            index = std::stoi(addr_part);
+        }
+        catch (const std::exception &e)
+        {
+            storage->reportError("Bad format for FX parameter index.", "OSC input error");
+            return;
+        }
+
+        if (index < 1 || index > n_fx_params)
+        {
+            storage->reportError("Bad FX parameter index. Must be 1-12.", "OSC input error");
+            return;
+        }
+
+        juce::MessageManager::callAsync(
+            [sfx, slot, index, val]() { sfx->setChainSlotParam01(slot, index - 1, val); });
     }
 }
 
@@ -27,6 +27,7 @@
 #include "SurgeStorage.h"
 #include <fmt/core.h>
 #include <fmt/format.h>
+#include <sstream>
 
 class SurgefxAudioProcessor;
 
@@ -65,6 +66,7 @@ class FXOpenSoundControl : public juce::OSCReceiver,
     SurgeStorage *storage{nullptr};
     SurgefxAudioProcessor *sfxPtr{nullptr};
     std::string getWholeString(const juce::OSCMessage &message);
+    void chainMessageReceived(std::istringstream &split, const juce::OSCMessage &message);
     // juce::OSCSender juceOSCSender;
     // void sendError(std::string errorMsg);
     // void sendNotFloatError(std::string addr, std::string msg);
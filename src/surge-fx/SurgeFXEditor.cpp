@@ -335,7 +335,7 @@ void SurgefxAudioProcessorEditor::resetLabels()
 
 void SurgefxAudioProcessorEditor::setEffectType(int i)
 {
-    processor.resetFxType(i);
+    processor.requestFxType(i);
     blastToggleState(i - 1);
     resetLabels();
     picker->repaint();
@@ -525,6 +525,8 @@ void SurgefxAudioProcessorEditor::showMenu()
 
     p.addSeparator();
 
+    p.addSubMenu("Chain", makeChainMenu());
+
     auto sm = juce::PopupMenu();
     sm.addItem(Surge::GUI::toOSCase("Zero Latency Mode"), true, processor.nonLatentBlockMode,
                [this]() { toggleLatencyMode(); });
@@ -585,6 +587,53 @@ void SurgefxAudioProcessorEditor::showMenu()
     p.showMenuAsync(o);
 }
 
+juce::PopupMenu SurgefxAudioProcessorEditor::makeChainMenu()
+{
+    auto chainMenu = juce::PopupMenu();
+
+    chainMenu.addItem(Surge::GUI::toOSCase("Enable Chain Mode"), true, processor.chainMode,
+                      [this]() { processor.chainMode = !processor.chainMode; });
+    chainMenu.addSeparator();
+
+    for (int s = 0; s < SurgefxAudioProcessor::n_chain_slots; ++s)
+    {
+        auto slotMenu = juce::PopupMenu();
+        auto type = processor.getChainSlotType(s);
+
+        slotMenu.addItem("Off", true, type == fxt_off,
+                         [this, s]() { processor.setChainSlotType(s, fxt_off); });
+        slotMenu.addItem("Bypass", type != fxt_off, processor.getChainSlotBypass(s), [this, s]() {
+            processor.setChainSlotBypass(s, !processor.getChainSlotBypass(s));
+        });
+        slotMenu.addSeparator();
+
+        for (const auto &m : menu)
+        {
+            if (m.isBreak)
+                slotMenu.addColumnBreak();
+
+            if (m.type == FxMenu::SECTION)
+                slotMenu.addSectionHeader(m.name);
+
+            if (m.type == FxMenu::FX && m.fxtype > 0)
+            {
+                slotMenu.addItem(m.name, true, m.fxtype == type,
+                                 [this, s, t = m.fxtype]() { processor.setChainSlotType(s, t); });
+            }
+        }
+
+        std::string lab = fmt::format("Slot {:d}: {}", s + 1, fx_type_names[type]);
+        if (type != fxt_off && processor.getChainSlotBypass(s))
+            lab += " (Bypassed)";
+        else if (type != fxt_off && processor.chainMode && !processor.isChainSlotRinging(s))
+            lab += " (Idle)";
+
+        chainMenu.addSubMenu(lab, slotMenu);
+    }
+
+    return chainMenu;
+}
+
 juce::PopupMenu SurgefxAudioProcessorEditor::makeOSCMenu()
 {
     auto oscSubMenu = juce::PopupMenu();
@@ -660,7 +709,11 @@ juce::PopupMenu SurgefxAudioProcessorEditor::makeOSCMenu()
                 return;
 
             std::string form_str =
-                "'/fx/param/<n> <val>'; replace <n> with 1 - 12 and <val> with 0.0 - 1.0 ";
+                "'/fx/param/<n> <val>'; replace <n> with 1 - 12 and <val> with 0.0 - 1.0\n"
+                "'/fx/chain/mode <0|1>', '/fx/chain/<s>/type <fx type>', "
+                "'/fx/chain/<s>/bypass <0|1>' and '/fx/chain/<s>/param/<n> <val>' control "
+                "chain slots 1 - " +
+                std::to_string(SurgefxAudioProcessor::n_chain_slots);
             w->processor.storage->reportError(form_str, "OSC Message Format:");
         });
 
@@ -170,6 +170,7 @@ class SurgefxAudioProcessorEditor : public juce::AudioProcessorEditor,
     void resetLabels();
 
     juce::PopupMenu makeOSCMenu();
+    juce::PopupMenu makeChainMenu();
 
     std::unique_ptr<SurgeLookAndFeel> surgeLookFeel;
     std::unique_ptr<juce::Label> fxNameLabel;
@@ -25,8 +25,11 @@
 #include "SurgeFXEditor.h"
 #include "DebugHelpers.h"
 #include "UserDefaults.h"
+#include "sst/basic-blocks/mechanics/block-ops.h"
 #include <fmt/core.h>
 
+namespace mech = sst::basic_blocks::mechanics;
+
 #if LINUX
 // getCurrentPosition is deprecated in J7
 #pragma GCC diagnostic push
@@ -55,11 +58,35 @@ SurgefxAudioProcessor::SurgefxAudioProcessor()
 
     effectNum = fxt_off;
 
-    fxstorage = &(storage->getPatch().fx[0]);
+    // Slots 0 and 1 take turns holding the running effect; see requestFxType
+    for (int s = 0; s < 2; ++s)
+    {
+        auto &fxs = storage->getPatch().fx[s];
+        fxs.return_level.id = -1;
+        setupStorageRanges(&(fxs.type), &(fxs.p[n_fx_params - 1]));
+        slotIdStart[s] = storage_id_start;
+        slotIdEnd[s] = storage_id_end;
+    }
+
+    static_assert(2 + n_chain_slots <= n_fx_slots, "Chain slots need their own fx storage");
+    for (int s = 0; s < n_chain_slots; ++s)
+    {
+        auto &cs = chain[s];
+        cs.fxs = &(storage->getPatch().fx[2 + s]);
+        cs.fxs->return_level.id = -1;
+        setupStorageRanges(&(cs.fxs->type), &(cs.fxs->p[n_fx_params - 1]));
+        cs.idStart = storage_id_start;
+        cs.idEnd = storage_id_end;
+
+        for (int i = 0; i < n_fx_params; ++i)
+            cs.remap[i] = i;
+    }
+
+    fxstorage = &(storage->getPatch().fx[activeSlot]);
+    storage_id_start = slotIdStart[activeSlot];
+    storage_id_end = slotIdEnd[activeSlot];
     audio_thread_surge_effect.reset();
     resetFxType(effectNum, false);
-    fxstorage->return_level.id = -1;
-    setupStorageRanges(&(fxstorage->type), &(fxstorage->p[n_fx_params - 1]));
 
     for (int i = 0; i < n_fx_params; ++i)
     {
@@ -214,6 +241,28 @@ void SurgefxAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+
+    // From here on type switches take the synchronous path, so reclaim an effect we had staged
+    // for the audio thread unless it has already taken it
+    audioRunning = false;
+
+    int expected = STAGING_READY;
+    if (stagingState.compare_exchange_strong(expected, STAGING_IDLE))
+        stagedEffect.reset();
+
+    // Nothing is left to acknowledge a pause, so do it here and let the rebuild go ahead
+    bool acknowledged{false};
+    for (auto &cs : chain)
+    {
+        int st = CHAIN_SLOT_PAUSE_REQUESTED;
+        if (cs.state.compare_exchange_strong(st, CHAIN_SLOT_PAUSED))
+        {
+            cs.ringing = false;
+            acknowledged = true;
+        }
+    }
+    if (acknowledged)
+        triggerAsyncUpdate();
 }
 
 bool SurgefxAudioProcessor::isBusesLayoutSupported(const BusesLayout &layouts) const
@@ -264,7 +313,8 @@ void SurgefxAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
         storage->temposyncratio_inv = 1.f / storage->temposyncratio;
     }
 
-    if (surge_effect->checkHasInvalidatedUI())
+    if (!juceParamsStale && audio_thread_surge_effect &&
+        audio_thread_surge_effect->checkHasInvalidatedUI())
     {
         resetFxParams(true);
     }
@@ -322,16 +372,28 @@ void SurgefxAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
     auto mainOutput = getBusBuffer(buffer, false, 0);
     auto sideChainInput = getBusBuffer(buffer, true, 1);
 
-    // FIXME: Check: has type changed?
     int pt = *fxType;
 
     if (effectNum != pt)
     {
-        effectNum = pt;
-        resetFxType(effectNum);
+        if (isNonRealtime())
+        {
+            // Offline we can afford to block, and should not wait on the message thread
+            effectNum = pt;
+            resetFxType(effectNum);
+        }
+        else if (claimStagedEffect(pt))
+        {
+            swapInStagedEffect();
+        }
+        else if (pendingFxType != pt)
+        {
+            pendingFxType = pt;
+            triggerAsyncUpdate();
+        }
     }
 
-    if (audio_thread_surge_effect.get() != surge_effect.get())
+    if (!juceParamsStale && audio_thread_surge_effect.get() != surge_effect.get())
     {
         audio_thread_surge_effect = surge_effect;
     }
@@ -345,8 +407,8 @@ void SurgefxAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
             auto outL = mainOutput.getWritePointer(0, outPos);
             auto outR = mainOutput.getWritePointer(1, outPos);
 
-            if ((effectNum == fxt_vocoder || effectNum == fxt_ringmod) && sideChainBus &&
-                sideChainBus->isEnabled())
+            if ((effectTypeIsRunning(fxt_vocoder) || effectTypeIsRunning(fxt_ringmod)) &&
+                sideChainBus && sideChainBus->isEnabled())
             {
                 auto sideL = sideChainInput.getReadPointer(0, outPos);
                 auto sideR = sideChainInput.getReadPointer(1, outPos);
@@ -354,7 +416,7 @@ void SurgefxAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
                 memcpy(storage->audio_in_nonOS[0], sideL, BLOCK_SIZE * sizeof(float));
                 memcpy(storage->audio_in_nonOS[1], sideR, BLOCK_SIZE * sizeof(float));
 
-                if (effectNum == fxt_ringmod)
+                if (effectTypeIsRunning(fxt_ringmod))
                 {
                     halfbandIN.process_block_U2(storage->audio_in_nonOS[0],
                                                 storage->audio_in_nonOS[1], storage->audio_in[0],
@@ -362,19 +424,14 @@ void SurgefxAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
                 }
             }
 
-            for (int i = 0; i < n_fx_params; ++i)
-            {
-                fxstorage->p[fx_param_remap[i]].set_value_f01(*fxParams[i]);
-                paramFeatureOntoParam(&(fxstorage->p[fx_param_remap[i]]), paramFeatures[i]);
-            }
-            copyGlobaldataSubset(storage_id_start, storage_id_end);
+            applyParamsToStorage();
 
             auto inL = mainInput.getReadPointer(inChanL, outPos);
             auto inR = mainInput.getReadPointer(inChanR, outPos);
 
             if (is_aligned(outL, 16) && is_aligned(outR, 16) && inL == outL && inR == outR)
             {
-                audio_thread_surge_effect->process_ringout(outL, outR, true);
+                processEffectBlock(outL, outR);
             }
             else
             {
@@ -383,7 +440,7 @@ void SurgefxAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
                 memcpy(bufferL, inL, BLOCK_SIZE * sizeof(float));
                 memcpy(bufferR, inR, BLOCK_SIZE * sizeof(float));
 
-                audio_thread_surge_effect->process_ringout(bufferL, bufferR, true);
+                processEffectBlock(bufferL, bufferR);
 
                 memcpy(outL, bufferL, BLOCK_SIZE * sizeof(float));
                 memcpy(outR, bufferR, BLOCK_SIZE * sizeof(float));
@@ -402,7 +459,7 @@ void SurgefxAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
 
         auto sideChainBus = getBus(true, 1);
 
-        if (effectNum == fxt_vocoder && sideChainBus && sideChainBus->isEnabled())
+        if (effectTypeIsRunning(fxt_vocoder) && sideChainBus && sideChainBus->isEnabled())
         {
             sideL = sideChainInput.getReadPointer(0, 0);
             sideR = sideChainInput.getReadPointer(1, 0);
@@ -412,7 +469,7 @@ void SurgefxAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
         {
             input_buffer[0][input_position] = inL[smp];
             input_buffer[1][input_position] = inR[smp];
-            if (effectNum == fxt_vocoder && sideL && sideR)
+            if (sideL && sideR)
             {
                 sidechain_buffer[0][input_position] = sideL[smp];
                 sidechain_buffer[1][input_position] = sideR[smp];
@@ -429,14 +486,9 @@ void SurgefxAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
                 memcpy(storage->audio_in_nonOS[0], sidechain_buffer[0], BLOCK_SIZE * sizeof(float));
                 memcpy(storage->audio_in_nonOS[1], sidechain_buffer[1], BLOCK_SIZE * sizeof(float));
 
-                for (int i = 0; i < n_fx_params; ++i)
-                {
-                    fxstorage->p[fx_param_remap[i]].set_value_f01(*fxParams[i]);
-                    paramFeatureOntoParam(&(fxstorage->p[fx_param_remap[i]]), paramFeatures[i]);
-                }
-                copyGlobaldataSubset(storage_id_start, storage_id_end);
+                applyParamsToStorage();
 
-                audio_thread_surge_effect->process_ringout(input_buffer[0], input_buffer[1], true);
+                processEffectBlock(input_buffer[0], input_buffer[1]);
                 memcpy(output_buffer, input_buffer, 2 * BLOCK_SIZE * sizeof(float));
                 input_position = 0;
                 output_position = 0;
@@ -560,6 +612,52 @@ void SurgefxAudioProcessor::getStateInformation(juce::MemoryBlock &destData)
     xml->setAttribute("oscpin", oscPortIn);
     xml->setAttribute("oscin", oscStartIn);
 
+    xml->setAttribute("chainMode", chainMode.load());
+
+    std::lock_guard<std::mutex> g(chainRestoreMutex);
+
+    for (int s = 0; s < n_chain_slots; ++s)
+    {
+        auto &cs = chain[s];
+        int type = cs.pendingType >= 0 ? (int)cs.pendingType : (int)cs.type;
+
+        if (cs.restorePending)
+        {
+            // Not rebuilt yet, so what we were given is still the state of this slot
+            auto prefix = fmt::format("chain_{:d}_", s);
+            for (int a = 0; a < pendingChainState->getNumAttributes(); ++a)
+            {
+                auto nm = pendingChainState->getAttributeName(a);
+                if (nm.startsWith(prefix))
+                    xml->setAttribute(nm, pendingChainState->getAttributeValue(a));
+            }
+            continue;
+        }
+
+        xml->setAttribute(fmt::format("chain_{:d}_fxt", s), type);
+        xml->setAttribute(fmt::format("chain_{:d}_bypass", s), cs.bypass.load());
+
+        if (type != cs.type || !cs.fx)
+            continue;
+
+        for (int i = 0; i < n_fx_params; ++i)
+        {
+            auto &spar = cs.fxs->p[i];
+            auto nm = fmt::format("chain_{:d}_surgeval_{:d}", s, i);
+
+            if (spar.ctrltype == ct_none)
+                continue;
+
+            if (spar.valtype == vt_int)
+                xml->setAttribute(nm, spar.val.i);
+            else
+                xml->setAttribute(nm, spar.get_value_f01());
+
+            xml->setAttribute(fmt::format("chain_{:d}_param_features_{:d}", s, i),
+                              paramFeatureFromParam(&spar));
+        }
+    }
+
     copyXmlToBinary(*xml, destData);
 }
 
@@ -647,23 +745,61 @@ void SurgefxAudioProcessor::setStateInformation(const void *data, int sizeInByte
             }
 
             updateJuceParamsFromStorage();
+
+            /*
+             * Running chain slots go through the same pause handshake as setChainSlotType, and
+             * pick up their streamed values when handleChainSlotChanges rebuilds them. Slots
+             * the audio thread is not touching are rebuilt here.
+             */
+            chainMode = xmlState->getBoolAttribute("chainMode", false);
+
+            std::lock_guard<std::mutex> g(chainRestoreMutex);
+            pendingChainState = std::move(xmlState);
+
+            for (int s = 0; s < n_chain_slots; ++s)
+            {
+                auto &cs = chain[s];
+                int type =
+                    pendingChainState->getIntAttribute(fmt::format("chain_{:d}_fxt", s), fxt_off);
+                if (type < 0 || type >= n_fx_types)
+                    type = fxt_off;
+
+                int st = cs.state;
+                if (!audioRunning || st == CHAIN_SLOT_EMPTY || st == CHAIN_SLOT_PAUSED)
+                {
+                    buildChainSlot(s, type, pendingChainState.get());
+                    continue;
+                }
+
+                cs.restorePending = true;
+                cs.pendingType = type;
+                cs.state = CHAIN_SLOT_PAUSE_REQUESTED;
+            }
+
+            releaseRestoredChainState();
         }
     }
 }
 
 void SurgefxAudioProcessor::reorderSurgeParams()
 {
-    if (surge_effect.get())
+    reorderSurgeParams(surge_effect.get(), fxstorage, fx_param_remap, group_names);
+}
+
+void SurgefxAudioProcessor::reorderSurgeParams(Effect *fx, FxStorage *fxs, int *remap,
+                                               std::string *groups)
+{
+    if (fx)
     {
         for (auto i = 0; i < n_fx_params; ++i)
-            fx_param_remap[i] = i;
+            remap[i] = i;
 
         std::vector<std::pair<int, int>> orderTrack;
         for (auto i = 0; i < n_fx_params; ++i)
         {
-            if (fxstorage->p[i].posy_offset && fxstorage->p[i].ctrltype != ct_none)
+            if (fxs->p[i].posy_offset && fxs->p[i].ctrltype != ct_none)
             {
-                orderTrack.push_back(std::pair<int, int>(i, i * 2 + fxstorage->p[i].posy_offset));
+                orderTrack.push_back(std::pair<int, int>(i, i * 2 + fxs->p[i].posy_offset));
             }
             else
             {
@@ -678,35 +814,34 @@ void SurgefxAudioProcessor::reorderSurgeParams()
         int idx = 0;
         for (auto a : orderTrack)
         {
-            fx_param_remap[idx++] = a.first;
+            remap[idx++] = a.first;
         }
     }
     else
     {
         for (int i = 0; i < n_fx_params; ++i)
         {
-            fx_param_remap[i] = i;
+            remap[i] = i;
         }
     }
 
     // I hate having to use this API so much...
     for (auto i = 0; i < n_fx_params; ++i)
     {
-        if (fxstorage->p[fx_param_remap[i]].ctrltype == ct_none)
+        if (fxs->p[remap[i]].ctrltype == ct_none)
         {
-            group_names[i] = "-";
+            groups[i] = "-";
         }
         else
         {
-            int fpos = fxstorage->p[fx_param_remap[i]].posy / 10 +
-                       fxstorage->p[fx_param_remap[i]].posy_offset;
-            for (auto j = 0; j < n_fx_params && surge_effect->group_label(j); ++j)
+            int fpos = fxs->p[remap[i]].posy / 10 + fxs->p[remap[i]].posy_offset;
+            for (auto j = 0; j < n_fx_params && fx->group_label(j); ++j)
             {
-                if (surge_effect->group_label(j) &&
-                    surge_effect->group_label_ypos(j) <= fpos // constants for SurgeGUIEditor. Sigh.
+                if (fx->group_label(j) &&
+                    fx->group_label_ypos(j) <= fpos // constants for SurgeGUIEditor. Sigh.
                 )
                 {
-                    group_names[i] = surge_effect->group_label(j);
+                    groups[i] = fx->group_label(j);
                 }
             }
         }
@@ -716,6 +851,15 @@ void SurgefxAudioProcessor::reorderSurgeParams()
 void SurgefxAudioProcessor::resetFxType(int type, bool updateJuceParams)
 {
     resettingFx = true;
+
+    // A synchronous reset supersedes any asynchronous switch which is in flight
+    pendingFxType = -1;
+    if (juceParamsStale)
+    {
+        stagedEffect.reset();
+        juceParamsStale = false;
+    }
+
     input_position = 0;
     output_position = -1;
     effectNum = type;
@@ -724,8 +868,8 @@ void SurgefxAudioProcessor::resetFxType(int type, bool updateJuceParams)
     for (int i = 0; i < n_fx_params; ++i)
         fxstorage->p[i].set_type(ct_none);
 
-    surge_effect.reset(spawn_effect(effectNum, storage.get(), &(storage->getPatch().fx[0]),
-                                    storage->getPatch().globaldata));
+    surge_effect.reset(
+        spawn_effect(effectNum, storage.get(), fxstorage, storage->getPatch().globaldata));
     if (surge_effect)
     {
         copyGlobaldataSubset(storage_id_start, storage_id_end);
@@ -756,6 +900,345 @@ void SurgefxAudioProcessor::resetFxParams(bool updateJuceParams)
     resettingFx = false;
 }
 
+void SurgefxAudioProcessor::requestFxType(int type)
+{
+    if (!audioRunning || isNonRealtime())
+    {
+        resetFxType(type);
+        return;
+    }
+
+    // Setting the host parameter records the change; processBlock picks up the effect we stage
+    *(fxType) = type;
+    pendingFxType = type;
+    handleFxTypeSwitching();
+}
+
+void SurgefxAudioProcessor::handleFxTypeSwitching()
+{
+    if (juceParamsStale)
+    {
+        // The audio thread has swapped to the staged effect; bring everything else up to date
+        surge_effect = stagedEffect;
+        stagedEffect.reset();
+
+        for (int i = 0; i < n_fx_params; ++i)
+            group_names[i] = stagedGroupNames[i];
+
+        updateJuceParamsFromStorage();
+        updateHostDisplay();
+        juceParamsStale = false;
+    }
+
+    if (effectRetired)
+    {
+        retiredEffect.reset();
+        effectRetired = false;
+        stagingState = STAGING_IDLE;
+    }
+
+    int want = pendingFxType;
+    if (want < 0 || want == effectNum)
+        return;
+
+    int expected = STAGING_IDLE;
+    if (stagingState.compare_exchange_strong(expected, STAGING_BUILDING))
+    {
+        buildStagedEffect(want);
+    }
+    else if (expected == STAGING_READY && stagedFxType != want)
+    {
+        // Rebuild unless the audio thread took the stale one in the meantime, in which case
+        // it will ask again once that swap retires
+        if (stagingState.compare_exchange_strong(expected, STAGING_BUILDING))
+            buildStagedEffect(want);
+    }
+}
+
+void SurgefxAudioProcessor::buildStagedEffect(int type)
+{
+    int slot = 1 - activeSlot;
+    auto *fxs = &(storage->getPatch().fx[slot]);
+
+    fxs->type.val.i = type;
+
+    for (int i = 0; i < n_fx_params; ++i)
+        fxs->p[i].set_type(ct_none);
+
+    stagedEffect.reset(spawn_effect(type, storage.get(), fxs, storage->getPatch().globaldata));
+    if (stagedEffect)
+    {
+        copyGlobaldataSubset(slotIdStart[slot], slotIdEnd[slot]);
+
+        stagedEffect->init();
+        stagedEffect->init_ctrltypes();
+        stagedEffect->init_default_values();
+    }
+
+    reorderSurgeParams(stagedEffect.get(), fxs, stagedParamRemap, stagedGroupNames);
+
+    for (int i = 0; i < n_fx_params; ++i)
+        paramFeatureOntoParam(&(fxs->p[i]), 0);
+
+    stagedFxType = type;
+    stagingState = stagedEffect ? STAGING_READY : STAGING_IDLE;
+}
+
+bool SurgefxAudioProcessor::claimStagedEffect(int type)
+{
+    int expected = STAGING_READY;
+    if (!stagingState.compare_exchange_strong(expected, STAGING_IN_USE))
+        return false;
+
+    // The message thread never rebuilds out of IN_USE, so stagedFxType is settled now
+    if (stagedFxType == type)
+        return true;
+
+    stagingState = STAGING_READY;
+    return false;
+}
+
+void SurgefxAudioProcessor::swapInStagedEffect()
+{
+    fadingEffect = std::move(audio_thread_surge_effect);
+    audio_thread_surge_effect = stagedEffect;
+
+    activeSlot = 1 - activeSlot;
+    fxstorage = &(storage->getPatch().fx[activeSlot]);
+    storage_id_start = slotIdStart[activeSlot];
+    storage_id_end = slotIdEnd[activeSlot];
+
+    for (int i = 0; i < n_fx_params; ++i)
+        fx_param_remap[i] = stagedParamRemap[i];
+
+    effectNum = stagedFxType;
+    crossfadePosition = 0;
+    juceParamsStale = true;
+
+    triggerAsyncUpdate();
+}
+
+void SurgefxAudioProcessor::processEffectBlock(float *dataL, float *dataR)
+{
+    if (!fadingEffect)
+    {
+        audio_thread_surge_effect->process_ringout(dataL, dataR, true);
+    }
+    else
+    {
+        float oldL alignas(16)[BLOCK_SIZE], oldR alignas(16)[BLOCK_SIZE];
+        memcpy(oldL, dataL, BLOCK_SIZE * sizeof(float));
+        memcpy(oldR, dataR, BLOCK_SIZE * sizeof(float));
+
+        fadingEffect->process_ringout(oldL, oldR, true);
+        audio_thread_surge_effect->process_ringout(dataL, dataR, true);
+
+        const float dt = 1.f / (fxCrossfadeBlocks * BLOCK_SIZE);
+        float t = crossfadePosition * BLOCK_SIZE * dt;
+
+        for (int i = 0; i < BLOCK_SIZE; ++i)
+        {
+            t += dt;
+            dataL[i] = oldL[i] + t * (dataL[i] - oldL[i]);
+            dataR[i] = oldR[i] + t * (dataR[i] - oldR[i]);
+        }
+
+        if (++crossfadePosition >= fxCrossfadeBlocks)
+        {
+            // Hand the old effect back to the message thread to be freed
+            retiredEffect = std::move(fadingEffect);
+            effectRetired = true;
+            triggerAsyncUpdate();
+        }
+    }
+
+    processChain(dataL, dataR);
+}
+
+void SurgefxAudioProcessor::setChainSlotType(int slot, int type)
+{
+    if (slot < 0 || slot >= n_chain_slots || type < 0 || type >= n_fx_types)
+        return;
+
+    auto &cs = chain[slot];
+    int st = cs.state;
+
+    // An explicit type wins over values still waiting from setStateInformation
+    std::lock_guard<std::mutex> g(chainRestoreMutex);
+    cs.restorePending = false;
+
+    if (!audioRunning || st == CHAIN_SLOT_EMPTY || st == CHAIN_SLOT_PAUSED)
+    {
+        buildChainSlot(slot, type);
+        releaseRestoredChainState();
+        return;
+    }
+
+    // The audio thread acknowledges the pause and handleChainSlotChanges does the rebuild
+    cs.pendingType = type;
+    cs.state = CHAIN_SLOT_PAUSE_REQUESTED;
+}
+
+void SurgefxAudioProcessor::setChainSlotParam01(int slot, int param, float f)
+{
+    if (slot < 0 || slot >= n_chain_slots || param < 0 || param >= n_fx_params)
+        return;
+
+    auto &cs = chain[slot];
+    if (!cs.fx)
+        return;
+
+    cs.fxs->p[cs.remap[param]].set_value_f01(f);
+}
+
+void SurgefxAudioProcessor::buildChainSlot(int slot, int type,
+                                           const juce::XmlElement *restoreFrom)
+{
+    auto &cs = chain[slot];
+
+    cs.fx.reset();
+    cs.fxs->type.val.i = type;
+
+    for (int i = 0; i < n_fx_params; ++i)
+        cs.fxs->p[i].set_type(ct_none);
+
+    cs.fx.reset(spawn_effect(type, storage.get(), cs.fxs, storage->getPatch().globaldata));
+    if (cs.fx)
+    {
+        copyGlobaldataSubset(cs.idStart, cs.idEnd);
+
+        cs.fx->init();
+        cs.fx->init_ctrltypes();
+        cs.fx->init_default_values();
+    }
+
+    std::string groups[n_fx_params];
+    reorderSurgeParams(cs.fx.get(), cs.fxs, cs.remap, groups);
+
+    for (int i = 0; i < n_fx_params; ++i)
+        paramFeatureOntoParam(&(cs.fxs->p[i]), 0);
+
+    if (restoreFrom)
+    {
+        auto &xml = *restoreFrom;
+        cs.bypass = xml.getBoolAttribute(fmt::format("chain_{:d}_bypass", slot), false);
+
+        for (int i = 0; cs.fx && i < n_fx_params; ++i)
+        {
+            auto &spar = cs.fxs->p[i];
+            auto nm = fmt::format("chain_{:d}_surgeval_{:d}", slot, i);
+
+            if (!xml.hasAttribute(nm))
+                continue;
+
+            if (spar.valtype == vt_int)
+                spar.val.i = xml.getIntAttribute(nm, spar.val.i);
+            else
+                spar.set_value_f01(xml.getDoubleAttribute(nm, 0.0));
+
+            paramFeatureOntoParam(
+                &spar,
+                xml.getIntAttribute(fmt::format("chain_{:d}_param_features_{:d}", slot, i), 0));
+        }
+    }
+
+    cs.restorePending = false;
+    cs.type = cs.fx ? type : (int)fxt_off;
+    cs.pendingType = -1;
+    cs.ringing = false;
+    cs.state = cs.fx ? CHAIN_SLOT_RUNNING : CHAIN_SLOT_EMPTY;
+}
+
+void SurgefxAudioProcessor::handleChainSlotChanges()
+{
+    std::lock_guard<std::mutex> g(chainRestoreMutex);
+
+    for (int s = 0; s < n_chain_slots; ++s)
+    {
+        auto &cs = chain[s];
+        if (cs.state == CHAIN_SLOT_PAUSED && cs.pendingType >= 0)
+            buildChainSlot(s, cs.pendingType,
+                           cs.restorePending ? pendingChainState.get() : nullptr);
+    }
+
+    releaseRestoredChainState();
+}
+
+void SurgefxAudioProcessor::releaseRestoredChainState()
+{
+    for (const auto &cs : chain)
+        if (cs.restorePending)
+            return;
+
+    pendingChainState.reset();
+}
+
+void SurgefxAudioProcessor::processChain(float *dataL, float *dataR)
+{
+    // About -120dB. Below this a slot's input counts as silence for ring-out purposes
+    static constexpr float silenceThreshold = 1e-6f;
+
+    bool active = chainMode;
+
+    for (int s = 0; s < n_chain_slots; ++s)
+    {
+        auto &cs = chain[s];
+        int st = cs.state;
+
+        if (st == CHAIN_SLOT_PAUSE_REQUESTED)
+        {
+            cs.state = CHAIN_SLOT_PAUSED;
+            cs.ringing = false;
+            triggerAsyncUpdate();
+            continue;
+        }
+
+        if (!active || st != CHAIN_SLOT_RUNNING || cs.bypass)
+        {
+            cs.ringing = false;
+            continue;
+        }
+
+        copyGlobaldataSubset(cs.idStart, cs.idEnd);
+
+        bool inputPresent = std::max(mech::blockAbsMax<BLOCK_SIZE>(dataL),
+                                     mech::blockAbsMax<BLOCK_SIZE>(dataR)) > silenceThreshold;
+        cs.ringing = cs.fx->process_ringout(dataL, dataR, inputPresent);
+    }
+}
+
+bool SurgefxAudioProcessor::effectTypeIsRunning(int type) const
+{
+    if (effectNum == type)
+        return true;
+
+    if (!chainMode)
+        return false;
+
+    for (const auto &cs : chain)
+    {
+        if (cs.state == CHAIN_SLOT_RUNNING && !cs.bypass && cs.type == type)
+            return true;
+    }
+
+    return false;
+}
+
+void SurgefxAudioProcessor::applyParamsToStorage()
+{
+    // Right after a swap the JUCE parameters still hold the previous effect's values, so
+    // leave the new effect on its defaults until the message thread has caught up
+    if (!juceParamsStale)
+    {
+        for (int i = 0; i < n_fx_params; ++i)
+        {
+            fxstorage->p[fx_param_remap[i]].set_value_f01(*fxParams[i]);
+            paramFeatureOntoParam(&(fxstorage->p[fx_param_remap[i]]), paramFeatures[i]);
+        }
+    }
+    copyGlobaldataSubset(storage_id_start, storage_id_end);
+}
+
 void SurgefxAudioProcessor::updateJuceParamsFromStorage()
 {
     SupressGuard sg(&supressParameterUpdates);
@@ -31,6 +31,8 @@
 
 #include "juce_audio_processors/juce_audio_processors.h"
 
+#include <mutex>
+
 #if MAC
 #include <execinfo.h>
 #endif
@@ -205,6 +207,8 @@ class SurgefxAudioProcessor : public juce::AudioProcessor,
 
     virtual void handleAsyncUpdate() override
     {
+        handleFxTypeSwitching();
+        handleChainSlotChanges();
         paramChangeListener();
         for (int i = 0; i < n_fx_params; ++i)
             if (wasParamFeatureChanged[i])
@@ -315,6 +319,26 @@ class SurgefxAudioProcessor : public juce::AudioProcessor,
     void resetFxType(int t, bool updateJuceParams = true);
     void resetFxParams(bool updateJuceParams = true);
 
+    // Switch effect type without stalling audio. Call this from the UI thread
+    void requestFxType(int t);
+
+    /*
+     * Chain mode. After the main effect, up to n_chain_slots further effects run in series on
+     * the same block buffers and sidechain input. Each slot can be bypassed, and each tracks
+     * its own ring-out, so a slot fed silence stops processing once its tail has decayed.
+     * Chain slot parameters are not host parameters; they are set from the UI or OSC and
+     * streamed with the plugin state. All of these are called from the UI thread.
+     */
+    static constexpr int n_chain_slots = 4;
+    std::atomic<bool> chainMode{false};
+
+    void setChainSlotType(int slot, int type);
+    int getChainSlotType(int slot) const { return chain[slot].type; }
+    void setChainSlotBypass(int slot, bool b) { chain[slot].bypass = b; }
+    bool getChainSlotBypass(int slot) const { return chain[slot].bypass; }
+    bool isChainSlotRinging(int slot) const { return chain[slot].ringing; }
+    void setChainSlotParam01(int slot, int param, float f);
+
     // Members for the FX. If this looks a lot like surge-rack/SurgeFX.hpp that's not a coincidence
     std::unique_ptr<SurgeStorage> storage;
 
@@ -400,8 +424,81 @@ class SurgefxAudioProcessor : public juce::AudioProcessor,
     std::string group_names[n_fx_params];
 
     void reorderSurgeParams();
+    void reorderSurgeParams(Effect *fx, FxStorage *fxs, int *remap, std::string *groups);
     void copyGlobaldataSubset(int start, int end);
     void setupStorageRanges(Parameter *start, Parameter *endIncluding);
+    void applyParamsToStorage();
+
+    /*
+     * Asynchronous effect switching. The running effect lives in fx slot activeSlot of our
+     * storage. A new one is spawned and initialised on the message thread in the other slot,
+     * then handed to the audio thread, which crossfades to it over fxCrossfadeBlocks blocks.
+     * The outgoing effect is handed back to the message thread to be destroyed, so the audio
+     * thread never allocates or frees an effect.
+     */
+    enum StagingState
+    {
+        STAGING_IDLE,     // the spare slot is free
+        STAGING_BUILDING, // the message thread is building into the spare slot
+        STAGING_READY,    // stagedEffect can be taken by the audio thread
+        STAGING_IN_USE    // the audio thread has swapped; the spare slot holds the fading effect
+    };
+    std::atomic<int> stagingState{STAGING_IDLE};
+    std::atomic<int> pendingFxType{-1};
+    std::atomic<bool> juceParamsStale{false}, effectRetired{false};
+
+    std::shared_ptr<Effect> stagedEffect, fadingEffect, retiredEffect;
+    std::atomic<int> stagedFxType{-1};
+    int stagedParamRemap[n_fx_params];
+    std::string stagedGroupNames[n_fx_params];
+
+    int activeSlot{0};
+    int slotIdStart[2], slotIdEnd[2];
+
+    static constexpr int fxCrossfadeBlocks = 8;
+    int crossfadePosition{0};
+
+    void handleFxTypeSwitching();
+    void buildStagedEffect(int type);
+    // Audio thread. Takes ownership of the staged effect if it is READY and of this type
+    bool claimStagedEffect(int type);
+    void swapInStagedEffect();
+    void processEffectBlock(float *dataL, float *dataR);
+
+    /*
+     * Chain slots use fx slots 2 and up. A running slot is only rebuilt once the audio thread
+     * has acknowledged a pause request, so the effect is always created and destroyed on the
+     * message thread.
+     */
+    enum ChainSlotState
+    {
+        CHAIN_SLOT_EMPTY,
+        CHAIN_SLOT_RUNNING,
+        CHAIN_SLOT_PAUSE_REQUESTED,
+        CHAIN_SLOT_PAUSED
+    };
+    struct ChainSlot
+    {
+        std::unique_ptr<Effect> fx;
+        FxStorage *fxs{nullptr};
+        int idStart{0}, idEnd{0};
+        int remap[n_fx_params];
+        std::atomic<int> type{fxt_off}, pendingType{-1};
+        std::atomic<int> state{CHAIN_SLOT_EMPTY};
+        std::atomic<bool> bypass{false}, ringing{false};
+        bool restorePending{false}; // guarded by chainRestoreMutex
+    } chain[n_chain_slots];
+
+    // The state from setStateInformation, kept until every slot waiting on it has been rebuilt
+    std::mutex chainRestoreMutex;
+    std::unique_ptr<juce::XmlElement> pendingChainState;
+
+    // restoreFrom, if given, supplies the streamed bypass and values for the slot
+    void buildChainSlot(int slot, int type, const juce::XmlElement *restoreFrom = nullptr);
+    void handleChainSlotChanges();
+    void releaseRestoredChainState();
+    void processChain(float *dataL, float *dataR);
+    bool effectTypeIsRunning(int type) const;
 
     std::atomic<bool> audioRunning{false};
 
@@ -0,0 +1,224 @@
+/*
+ * Surge XT - a free and open source hybrid synthesizer,
+ * built by Surge Synth Team
+ *
+ * Learn more at https://surge-synthesizer.github.io/
+ *
+ * Copyright 2018-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * Surge XT is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Surge was a commercial product from 2004-2018, copyright and ownership
+ * held by Claes Johanson at Vember Audio during that period.
+ * Claes made Surge open source in September 2018.
+ *
+ * All source for Surge XT is available at
+ * https://github.com/surge-synthesizer/surge
+ */
+
+#include "catch2/catch_amalgamated.hpp"
+#include "SurgeFXProcessor.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+// Main input and sidechain in, stereo out
+constexpr int bufferChannels = 4, bufferSamples = 512;
+
+void runBlocks(SurgefxAudioProcessor &p, int blocks, std::vector<float> *out = nullptr)
+{
+    int64_t phase{0};
+    auto buffer = juce::AudioBuffer<float>(bufferChannels, bufferSamples);
+    auto midi = juce::MidiBuffer();
+
+    for (int b = 0; b < blocks; ++b)
+    {
+        buffer.clear();
+        for (int i = 0; i < bufferSamples; ++i)
+        {
+            auto ph = juce::MathConstants<double>::twoPi * 220.0 * (phase++) / 48000.0;
+            auto v = 0.5f * (float)std::sin(ph);
+            buffer.setSample(0, i, v);
+            buffer.setSample(1, i, v);
+        }
+
+        p.processBlock(buffer, midi);
+
+        if (out)
+            for (int i = 0; i < bufferSamples; ++i)
+                out->push_back(buffer.getSample(0, i));
+    }
+}
+
+std::unique_ptr<juce::XmlElement> stateOf(SurgefxAudioProcessor &p)
+{
+    juce::MemoryBlock mb;
+    p.getStateInformation(mb);
+    return juce::AudioProcessor::getXmlFromBinary(mb.getData(), (int)mb.getSize());
+}
+
+void setState(SurgefxAudioProcessor &p, const juce::XmlElement &xml)
+{
+    juce::MemoryBlock mb;
+    juce::AudioProcessor::copyXmlToBinary(xml, mb);
+    p.setStateInformation(mb.getData(), (int)mb.getSize());
+}
+
+void startAudio(SurgefxAudioProcessor &p)
+{
+    p.setParameterChangeListener([]() {});
+    p.prepareToPlay(48000, bufferSamples);
+    runBlocks(p, 1);
+}
+
+std::vector<float> renderChain(int first, int second)
+{
+    auto p = SurgefxAudioProcessor();
+    p.setParameterChangeListener([]() {});
+    p.chainMode = true;
+    p.setChainSlotType(0, first);
+    p.setChainSlotType(1, second);
+    p.prepareToPlay(48000, bufferSamples);
+
+    std::vector<float> out;
+    runBlocks(p, 40, &out);
+    return out;
+}
+} // namespace
+
+TEST_CASE("Chain Slots Run In Slot Order", "[fx-chain]")
+{
+    juce::MessageManager::getInstance();
+
+    // Distortion is non linear, so it does not commute with the delay's dry and wet mix
+    auto a = renderChain(fxt_distortion, fxt_delay);
+    auto b = renderChain(fxt_delay, fxt_distortion);
+    auto again = renderChain(fxt_distortion, fxt_delay);
+
+    REQUIRE(a.size() == b.size());
+    REQUIRE(a == again);
+    REQUIRE(a != b);
+
+    juce::MessageManager::deleteInstance();
+}
+
+TEST_CASE("Chain Slot Type Changes Wait For The Audio Thread", "[fx-chain]")
+{
+    juce::MessageManager::getInstance();
+
+    auto p = SurgefxAudioProcessor();
+    p.chainMode = true;
+    p.setChainSlotType(0, fxt_delay);
+    startAudio(p);
+
+    p.setChainSlotType(0, fxt_reverb);
+    REQUIRE(p.getChainSlotType(0) == fxt_delay);
+
+    // Nothing is rebuilt until the audio thread has acknowledged the pause
+    p.handleAsyncUpdate();
+    REQUIRE(p.getChainSlotType(0) == fxt_delay);
+
+    runBlocks(p, 1);
+    p.handleAsyncUpdate();
+    REQUIRE(p.getChainSlotType(0) == fxt_reverb);
+
+    runBlocks(p, 4);
+    REQUIRE(p.getChainSlotType(0) == fxt_reverb);
+
+    juce::MessageManager::deleteInstance();
+}
+
+TEST_CASE("Chain State Round Trips", "[fx-chain]")
+{
+    juce::MessageManager::getInstance();
+
+    auto src = SurgefxAudioProcessor();
+    src.setParameterChangeListener([]() {});
+    src.chainMode = true;
+    src.setChainSlotType(0, fxt_distortion);
+    src.setChainSlotType(2, fxt_reverb);
+    src.setChainSlotBypass(2, true);
+    src.setChainSlotParam01(0, 0, 0.25f);
+    src.setChainSlotParam01(2, 1, 0.75f);
+
+    auto saved = stateOf(src);
+
+    auto chainAttributesMatch = [&saved](const juce::XmlElement &x) {
+        int n = 0;
+        for (int a = 0; a < saved->getNumAttributes(); ++a)
+        {
+            auto nm = saved->getAttributeName(a);
+            if (!nm.startsWith("chain"))
+                continue;
+
+            n++;
+            if (x.getStringAttribute(nm) != saved->getAttributeValue(a))
+            {
+                UNSCOPED_INFO(nm << " " << x.getStringAttribute(nm) << " "
+                                 << saved->getAttributeValue(a));
+                return false;
+            }
+        }
+        return n > 0;
+    };
+
+    SECTION("Without Audio")
+    {
+        auto p = SurgefxAudioProcessor();
+        setState(p, *saved);
+
+        REQUIRE(p.chainMode);
+        REQUIRE(p.getChainSlotType(0) == fxt_distortion);
+        REQUIRE(p.getChainSlotType(2) == fxt_reverb);
+        REQUIRE(p.getChainSlotBypass(2));
+        REQUIRE(chainAttributesMatch(*stateOf(p)));
+    }
+
+    SECTION("While Audio Runs")
+    {
+        auto p = SurgefxAudioProcessor();
+        p.chainMode = true;
+        p.setChainSlotType(0, fxt_delay);
+        startAudio(p);
+
+        setState(p, *saved);
+
+        // Slot 0 is running so it waits for the handshake; the empty slot 2 is built at once
+        REQUIRE(p.getChainSlotType(0) == fxt_delay);
+        REQUIRE(p.getChainSlotType(2) == fxt_reverb);
+
+        // Streaming before the rebuild still gives back what we were given
+        REQUIRE(chainAttributesMatch(*stateOf(p)));
+
+        runBlocks(p, 1);
+        p.handleAsyncUpdate();
+
+        REQUIRE(p.getChainSlotType(0) == fxt_distortion);
+        REQUIRE(chainAttributesMatch(*stateOf(p)));
+    }
+
+    SECTION("Audio Stops Before The Handshake")
+    {
+        auto p = SurgefxAudioProcessor();
+        p.chainMode = true;
+        p.setChainSlotType(0, fxt_delay);
+        startAudio(p);
+
+        setState(p, *saved);
+        REQUIRE(p.getChainSlotType(0) == fxt_delay);
+
+        p.releaseResources();
+        p.handleAsyncUpdate();
+
+        REQUIRE(p.getChainSlotType(0) == fxt_distortion);
+        REQUIRE(chainAttributesMatch(*stateOf(p)));
+    }
+
+    juce::MessageManager::deleteInstance();
+}
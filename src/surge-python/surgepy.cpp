@@ -699,6 +699,20 @@ class SurgeSynthesizerWithPythonExtensions : public SurgeSynthesizer
         return isBipolarModulation((modsources)from.getModSource());
     }
 
+    float getModSourceOutputPy(const SurgePyModSource &from, int scene, int index, bool voice)
+    {
+        if (scene < 0 || scene >= n_scenes)
+            throw std::out_of_range("getModSourceOutput called with invalid scene");
+        if (index < 0 || index >= max_lfo_indices)
+            throw std::out_of_range("getModSourceOutput called with invalid index");
+
+        SurgeSynthesizer::ModulationSnapshot snap;
+        getModulationSnapshot(snap);
+
+        auto ms = from.getModSource();
+        return voice ? snap.voice[scene][ms][index] : snap.scene[scene][ms][index];
+    }
+
     py::array_t<float> createMultiBlock(int nBlocks)
     {
         auto res = py::array_t<float>({2, nBlocks * BLOCK_SIZE},
@@ -1032,6 +1046,13 @@ class SurgeSynthesizerWithPythonExtensions : public SurgeSynthesizer
         return storage.tuningApplicationMode;
     }
 
+    void setDecimationQuality(SurgeStorage::DecimationQuality q) { storage.decimationQuality = q; }
+
+    SurgeStorage::DecimationQuality getDecimationQuality() const
+    {
+        return storage.decimationQuality;
+    }
+
     void setMPEEnabled(bool m) { storage.mpeEnabled = m; }
 
     bool getMPEEnabled() const { return storage.mpeEnabled; }
@@ -1154,6 +1175,11 @@ PYBIND11_MODULE(surgepy, m)
              py::arg("index") = 0)
         .def("isBipolarModulation", &SurgeSynthesizerWithPythonExtensions::isBipolarModulationPy,
              "Is the given modulation source bipolar?", py::arg("modulationSource"))
+        .def("getModSourceOutput", &SurgeSynthesizerWithPythonExtensions::getModSourceOutputPy,
+             "The output of a modulation source as of the end of the last processed block. Voice "
+             "level sources are read from the most recently started voice if voice is True.",
+             py::arg("modulationSource"), py::arg("scene") = 0, py::arg("index") = 0,
+             py::arg("voice") = false)
 
         .def("getAllModRoutings", &SurgeSynthesizerWithPythonExtensions::getAllModRoutings,
              "Get the entire modulation matrix for this instance.")
@@ -1201,7 +1227,10 @@ PYBIND11_MODULE(surgepy, m)
                       &SurgeSynthesizerWithPythonExtensions::setMPEEnabled)
         .def_property("tuningApplicationMode",
                       &SurgeSynthesizerWithPythonExtensions::getTuningApplicationMode,
-                      &SurgeSynthesizerWithPythonExtensions::setTuningApplicationMode);
+                      &SurgeSynthesizerWithPythonExtensions::setTuningApplicationMode)
+        .def_property("decimationQuality",
+                      &SurgeSynthesizerWithPythonExtensions::getDecimationQuality,
+                      &SurgeSynthesizerWithPythonExtensions::setDecimationQuality);
 
     py::class_<SurgePyControlGroup>(m, "SurgeControlGroup")
         .def("getId", &SurgePyControlGroup::getControlGroupId)
@@ -1417,4 +1446,8 @@ PYBIND11_MODULE(surgepy, m)
     py::enum_<SurgeStorage::TuningApplicationMode>(m, "TuningApplicationMode")
         .value("RETUNE_ALL", SurgeStorage::TuningApplicationMode::RETUNE_ALL)
         .value("RETUNE_MIDI_ONLY", SurgeStorage::TuningApplicationMode::RETUNE_MIDI_ONLY);
+
+    py::enum_<SurgeStorage::DecimationQuality>(m, "DecimationQuality")
+        .value("DECIMATION_ECO", SurgeStorage::DecimationQuality::DECIMATION_ECO)
+        .value("DECIMATION_STANDARD", SurgeStorage::DecimationQuality::DECIMATION_STANDARD);
 }
@@ -67,3 +67,27 @@ def test_set_tuningApplicationMode():
     s = surgepy.createSurge(44100)
     s.tuningApplicationMode = surgepy.TuningApplicationMode.RETUNE_ALL
     assert s.tuningApplicationMode == surgepy.TuningApplicationMode.RETUNE_ALL
+
+
+def test_default_decimationQuality():
+    s = surgepy.createSurge(44100)
+    assert s.decimationQuality == surgepy.DecimationQuality.DECIMATION_STANDARD
+
+
+def test_set_decimationQuality():
+    s = surgepy.createSurge(44100)
+    s.decimationQuality = surgepy.DecimationQuality.DECIMATION_ECO
+    assert s.decimationQuality == surgepy.DecimationQuality.DECIMATION_ECO
+    s.process()
+
+
+def test_getModSourceOutput():
+    s = surgepy.createSurge(44100)
+    ampeg = s.getModSource(surgepy.constants.ms_ampeg)
+    s.process()
+    assert s.getModSourceOutput(ampeg, voice=True) == 0.0
+
+    s.playNote(0, 60, 127, 0)
+    for _ in range(20):
+        s.process()
+    assert s.getModSourceOutput(ampeg, voice=True) > 0.0
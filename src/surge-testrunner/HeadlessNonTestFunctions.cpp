@@ -21,11 +21,20 @@
  */
 #include "HeadlessUtils.h"
 #include "Player.h"
+#include "OfflineRenderer.h"
+#include "SurgeMemoryPools.h"
 #include "filesystem/import.h"
 #include <iostream>
 #include <sstream>
 #include <chrono>
+#include <algorithm>
+#include <array>
+#include <cctype>
 #include <deque>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <vector>
 
 namespace Surge
 {
@@ -743,6 +752,529 @@ void generateNLFeedbackNorms()
               << "      if (useNormalization) normNumerator = lpNormTable[subtype];\n";
 }
 
+namespace
+{
+/*
+ * The regression suite times each scenario many times over and keeps the distribution, so a
+ * run can be compared to an earlier one by median (for drift) and p99 (for spikes). x realtime
+ * is the length of one run in real time over the median, so it moves with the median.
+ * The memory scenarios report a size in bytes instead, which is what they are compared by.
+ */
+struct SuiteResult
+{
+    std::string scenario;
+    double medianNs{0}, p99Ns{0}, xRealtime{0};
+    size_t bytes{0};
+};
+
+SuiteResult memoryResult(const std::string &scenario, size_t bytes)
+{
+    SuiteResult res;
+    res.scenario = scenario;
+    res.bytes = bytes;
+    return res;
+}
+
+SuiteResult summarize(const std::string &scenario, std::vector<int64_t> ns, double realNsPerRun)
+{
+    SuiteResult res;
+    res.scenario = scenario;
+    if (ns.empty())
+        return res;
+
+    std::sort(ns.begin(), ns.end());
+    res.medianNs = ns[ns.size() / 2];
+    res.p99Ns = ns[std::min(ns.size() - 1, ns.size() * 99 / 100)];
+    res.xRealtime = realNsPerRun > 0 ? realNsPerRun / res.medianNs : 0;
+    return res;
+}
+
+// "Vintage Ladder" -> "vintage-ladder", so scenario names are stable CSV keys
+std::string scenarioKey(const std::string &s)
+{
+    std::string res;
+    for (auto c : s)
+    {
+        if (std::isalnum((unsigned char)c))
+            res += (char)std::tolower((unsigned char)c);
+        else if (!res.empty() && res.back() != '-')
+            res += '-';
+    }
+    while (!res.empty() && res.back() == '-')
+        res.pop_back();
+    return res;
+}
+
+constexpr int suiteSampleRate = 48000;
+constexpr int suiteWarmupBlocks = 100;
+constexpr int suiteMeasuredBlocks = 2000;
+
+double blockRealNs(const std::shared_ptr<SurgeSynthesizer> &surge)
+{
+    return BLOCK_SIZE * 1.0e9 / surge->storage.samplerate;
+}
+
+/*
+ * Runs suiteWarmupBlocks untimed blocks and then times suiteMeasuredBlocks. A block just
+ * processes the synth unless the scenario passes its own, which is handed a running block index
+ * and has to process (or render) the block itself.
+ */
+std::vector<int64_t> timeBlocks(const std::shared_ptr<SurgeSynthesizer> &surge,
+                                const std::function<void(int)> &block = {})
+{
+    int b = 0;
+    auto step = [&]() {
+        if (block)
+            block(b);
+        else
+            surge->process();
+        b++;
+    };
+
+    for (int i = 0; i < suiteWarmupBlocks; ++i)
+        step();
+
+    std::vector<int64_t> ns(suiteMeasuredBlocks);
+    for (auto &n : ns)
+    {
+        auto st = std::chrono::high_resolution_clock::now();
+        step();
+        auto et = std::chrono::high_resolution_clock::now();
+        n = std::chrono::duration_cast<std::chrono::nanoseconds>(et - st).count();
+    }
+    return ns;
+}
+
+SuiteResult timeAudioScenario(const std::string &scenario,
+                              const std::shared_ptr<SurgeSynthesizer> &surge, int voices)
+{
+    for (int i = 0; i < 10; ++i)
+        surge->process();
+    for (int v = 0; v < voices; ++v)
+        surge->playNote(0, 24 + v, 100, 0);
+
+    return summarize(scenario, timeBlocks(surge), blockRealNs(surge));
+}
+
+void setOscillators(const std::shared_ptr<SurgeSynthesizer> &surge, int ot, int voices)
+{
+    auto &patch = surge->storage.getPatch();
+    for (int o = 0; o < n_oscs; ++o)
+        patch.scene[0].osc[o].type.val.i = ot;
+    patch.polylimit.val.i = std::max(voices, 2);
+    patch.update_controls(true);
+    surge->storage.memoryPools->resetAllPools(&surge->storage);
+}
+
+void runSuiteScenarios(const std::function<void(const SuiteResult &)> &report)
+{
+    {
+        // What a voice and its oscillators cost. The oscillators used to be inline in every voice
+        // at the worst case size; now they sit in slots sized for their type
+        report(memoryResult("memory/sizeof/voice", sizeof(SurgeVoice)));
+        report(memoryResult("memory/sizeof/storage", sizeof(SurgeStorage)));
+        report(memoryResult("memory/sizeof/synth", sizeof(SurgeSynthesizer)));
+        report(memoryResult("memory/inline-oscillators",
+                            (size_t)n_scenes * MAX_VOICES * n_oscs * oscillator_buffer_size));
+
+        for (int ot = 0; ot < n_osc_types; ++ot)
+            report(memoryResult("memory/osc-slot/" + scenarioKey(osc_type_names[ot]),
+                                Surge::Memory::OscillatorSlotPool::slotSize(ot)));
+
+        auto surge = createSurge(suiteSampleRate);
+        auto &pools = *surge->storage.memoryPools;
+        report(memoryResult("memory/pools/init-patch",
+                            pools.oscillatorSlots.bytesAllocated() +
+                                pools.stringDelayLines.position *
+                                    sizeof(*pools.stringDelayLines.pool[0])));
+    }
+
+    for (int ot = 0; ot < n_osc_types; ++ot)
+    {
+        for (auto nv : {1, 16, 64})
+        {
+            auto surge = createSurge(suiteSampleRate);
+            setOscillators(surge, ot, nv);
+            auto name = "osc/" + scenarioKey(osc_type_names[ot]) + "/" + std::to_string(nv);
+            report(timeAudioScenario(name, surge, nv));
+        }
+    }
+
+    for (int ft = 0; ft < sst::filters::num_filter_types; ++ft)
+    {
+        if (ft == sst::filters::fut_none)
+            continue;
+
+        auto surge = createSurge(suiteSampleRate);
+        setOscillators(surge, ot_classic, 16);
+        auto &fu = surge->storage.getPatch().scene[0].filterunit[0];
+        fu.type.val.i = ft;
+        fu.subtype.val.i = 0;
+
+        char fn[TXT_SIZE];
+        fu.type.get_display(fn);
+        report(timeAudioScenario("filter/" + scenarioKey(fn), surge, 16));
+    }
+
+    for (int fxt = 1; fxt < n_fx_types; ++fxt)
+    {
+        auto surge = createSurge(suiteSampleRate);
+        setOscillators(surge, ot_classic, 4);
+
+        auto *pt = &(surge->storage.getPatch().fx[0].type);
+        surge->setParameter01(surge->idForParameter(pt),
+                              1.f * fxt / (pt->val_max.i - pt->val_min.i), false);
+
+        report(timeAudioScenario("fx/" + scenarioKey(fx_type_names[fxt]), surge, 4));
+    }
+
+    /*
+     * Every voice and scene LFO running the shape, each on its own destination, so the
+     * modulators dominate the block
+     */
+    for (auto shape : {lt_mseg, lt_formula})
+    {
+        auto surge = createSurge(suiteSampleRate);
+        setOscillators(surge, ot_classic, 16);
+
+        auto &patch = surge->storage.getPatch();
+        auto &sc = patch.scene[0];
+        std::array<Parameter *, n_lfos> dests = {
+            &sc.filterunit[0].cutoff, &sc.filterunit[0].resonance, &sc.filterunit[1].cutoff,
+            &sc.filterunit[1].resonance, &sc.osc[0].pitch,         &sc.osc[1].pitch,
+            &sc.osc[2].pitch,           &sc.level_o1,              &sc.level_o2,
+            &sc.level_o3,               &sc.pan,                   &sc.width};
+
+        for (int l = 0; l < n_lfos; ++l)
+        {
+            sc.lfo[l].shape.val.i = shape;
+            surge->setModDepth01(dests[l]->id, (modsources)(ms_lfo1 + l), 0, 0, 0.1f);
+        }
+        patch.update_controls(true);
+
+        report(timeAudioScenario(shape == lt_mseg ? "mod/mseg" : "mod/formula", surge, 16));
+    }
+
+    /*
+     * The amp and filter envelopes are only batched when no voice LFO can retrigger them, so
+     * the scalar runs make LFO 6 an unrouted step sequencer with a retrigger step. Being
+     * unrouted it is never processed, so only the envelope path changes.
+     */
+    for (auto nv : {16, 64})
+    {
+        for (auto batched : {false, true})
+        {
+            auto surge = createSurge(suiteSampleRate);
+            setOscillators(surge, ot_classic, nv);
+            if (!batched)
+            {
+                auto &patch = surge->storage.getPatch();
+                patch.scene[0].lfo[n_lfos_voice - 1].shape.val.i = lt_stepseq;
+                patch.stepsequences[0][n_lfos_voice - 1].trigmask = 1;
+            }
+
+            auto name = std::string("mod/envelopes/") + (batched ? "batched/" : "scalar/") +
+                        std::to_string(nv);
+            report(timeAudioScenario(name, surge, nv));
+        }
+    }
+
+    // One sine voice with the filters and waveshaper off, so the decimator is most of the block
+    for (auto sr : {44100, 48000})
+    {
+        for (auto q : {SurgeStorage::DECIMATION_ECO, SurgeStorage::DECIMATION_STANDARD})
+        {
+            auto surge = createSurge(sr);
+            surge->storage.decimationQuality = q;
+            auto &sc = surge->storage.getPatch().scene[0];
+            sc.filterunit[0].type.val.i = sst::filters::fut_none;
+            sc.filterunit[1].type.val.i = sst::filters::fut_none;
+            sc.wsunit.type.val.i = (int)sst::waveshapers::WaveshaperType::wst_none;
+            setOscillators(surge, ot_sine, 1);
+
+            auto name = "decimation/" + std::to_string(sr) + "/" +
+                        (q == SurgeStorage::DECIMATION_ECO ? "eco" : "standard");
+            report(timeAudioScenario(name, surge, 1));
+        }
+    }
+
+    // A block with nothing to do, which is the overhead smaller block sizes pay more often
+    {
+        auto surge = createSurge(suiteSampleRate);
+        surge->storage.getPatch().fx_bypass.val.i = fxb_no_fx;
+        report(timeAudioScenario("engine/idle", surge, 0));
+    }
+
+    /*
+     * A 16 note chord every 64 blocks, released halfway, for the oscillators with the heaviest
+     * init, with and without a voice start budget. The chord blocks are what the p99 sees.
+     */
+    for (auto ot : {ot_classic, ot_twist, ot_string, ot_window})
+    {
+        for (int budgetUs : {0, 50})
+        {
+            auto surge = createSurge(suiteSampleRate);
+            setOscillators(surge, ot, 32);
+            surge->storage.voiceStartBudgetNs = budgetUs * 1000;
+
+            auto ns = timeBlocks(surge, [&surge](int b) {
+                for (int v = 0; v < 16; ++v)
+                {
+                    if (b % 64 == 0)
+                        surge->playNote(0, 36 + 3 * v, 120, 0);
+                    else if (b % 64 == 32)
+                        surge->releaseNote(0, 36 + 3 * v, 0);
+                }
+                surge->process();
+            });
+
+            auto name = "voice-start/" + scenarioKey(osc_type_names[ot]) + "/" +
+                        (budgetUs ? "budget-" + std::to_string(budgetUs) + "us" : "no-budget");
+            report(summarize(name, ns, blockRealNs(surge)));
+        }
+    }
+
+    /*
+     * Eight note chords fed block by block and through the offline renderer. The chords start
+     * with the measured blocks; the renderer's prepare() runs before and is not timed.
+     */
+    {
+        int64_t start = suiteWarmupBlocks * BLOCK_SIZE;
+        int64_t end = (suiteWarmupBlocks + suiteMeasuredBlocks) * BLOCK_SIZE;
+
+        std::vector<Surge::Offline::Event> events;
+        for (int64_t t = start, c = 0; t < end; t += suiteSampleRate / 8, ++c)
+        {
+            for (int n = 0; n < 8; ++n)
+            {
+                Surge::Offline::Event e;
+                e.atSample = t + n;
+                e.key = (char)(36 + c % 12 + 5 * n);
+                e.velocity = 100;
+                events.push_back(e);
+
+                e.type = Surge::Offline::Event::NOTE_OFF;
+                e.atSample = t + suiteSampleRate / 10;
+                e.velocity = 0;
+                events.push_back(e);
+            }
+        }
+
+        // An empty callback at the end, so the plan covers every block timeBlocks runs
+        Surge::Offline::Event last;
+        last.type = Surge::Offline::Event::CALLBACK;
+        last.atSample = end;
+        events.push_back(last);
+
+        std::stable_sort(events.begin(), events.end(),
+                         [](auto &a, auto &b) { return a.atSample < b.atSample; });
+
+        for (auto ot : {ot_classic, ot_wavetable, ot_twist, ot_string})
+        {
+            for (auto useRenderer : {false, true})
+            {
+                auto surge = createSurge(suiteSampleRate);
+                setOscillators(surge, ot, 16);
+
+                Surge::Offline::Renderer renderer(surge.get());
+                renderer.setEvents(events);
+                if (useRenderer)
+                    renderer.prepare();
+
+                float out[BLOCK_SIZE * 2];
+                size_t ei = 0;
+                auto ns = timeBlocks(surge, [&](int b) {
+                    if (useRenderer)
+                    {
+                        renderer.render(out, b, 1);
+                        return;
+                    }
+
+                    while (ei < events.size() && events[ei].atSample < (b + 1) * BLOCK_SIZE)
+                    {
+                        auto &e = events[ei++];
+                        if (e.type == Surge::Offline::Event::NOTE_ON)
+                            surge->playNote(0, e.key, e.velocity, 0);
+                        else if (e.type == Surge::Offline::Event::NOTE_OFF)
+                            surge->releaseNote(0, e.key, e.velocity);
+                    }
+                    surge->process();
+                });
+
+                auto name = "offline/" + scenarioKey(osc_type_names[ot]) + "/" +
+                            (useRenderer ? "renderer" : "block-loop");
+                report(summarize(name, ns, blockRealNs(surge)));
+            }
+        }
+    }
+
+    /*
+     * Dense host automation: every block sets a spread of float parameters, a quarter of them
+     * directly and the rest smoothed, the way a DAW plays back a lane dump
+     */
+    for (auto perBlock : {16, 256, 1024})
+    {
+        auto surge = createSurge(suiteSampleRate);
+        setOscillators(surge, ot_classic, 1);
+
+        std::vector<int> ids;
+        for (auto *p : surge->storage.getPatch().param_ptr)
+            if (p->valtype == vt_float && !p->affect_other_parameters)
+                ids.push_back(p->id);
+
+        surge->playNote(0, 60, 100, 0);
+
+        size_t next = 0;
+        auto ns = timeBlocks(surge, [&](int b) {
+            for (int i = 0; i < perBlock; ++i)
+            {
+                auto id = ids[next++ % ids.size()];
+                float v = 0.5f + 0.4f * std::sin(0.01f * (b + i));
+
+                if (i % 4 == 0)
+                {
+                    SurgeSynthesizer::ID rid;
+                    surge->fromSynthSideId(id, rid);
+                    surge->setParameter01(rid, v);
+                }
+                else
+                {
+                    surge->setParameterSmoothed(id, v);
+                }
+            }
+            surge->process();
+        });
+        report(summarize("automation/" + std::to_string(perBlock), ns, blockRealNs(surge)));
+    }
+
+    {
+        auto surge = createSurge(suiteSampleRate, true);
+        // Up to 200 patches spread evenly through the library
+        auto nPatches = surge->storage.patchOrdering.size();
+        auto stride = std::max(nPatches / 200, (size_t)1);
+        std::vector<int64_t> ns;
+        for (size_t i = 0; i < nPatches && ns.size() < 200; i += stride)
+        {
+            auto st = std::chrono::high_resolution_clock::now();
+            surge->loadPatch(surge->storage.patchOrdering[i]);
+            auto et = std::chrono::high_resolution_clock::now();
+            ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(et - st).count());
+        }
+
+        if (ns.empty())
+            std::cerr << "No patches found; skipping patch/load" << std::endl;
+        else
+            report(summarize("patch/load", ns, 0));
+    }
+
+    {
+        auto surge = createSurge(suiteSampleRate, true);
+        surge->storage.initializePatchDb();
+        surge->storage.patchDB->waitForJobsOutstandingComplete(60000);
+
+        std::vector<std::string> queries = {"init", "bass", "pad", "lead OR keys",
+                                            "\"init sine\"", "(pluck) OR fm"};
+        std::vector<int64_t> ns;
+        for (int i = 0; i < 300; ++i)
+        {
+            auto st = std::chrono::high_resolution_clock::now();
+            auto res = surge->storage.patchDB->queryFromQueryString(queries[i % queries.size()]);
+            auto et = std::chrono::high_resolution_clock::now();
+            ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(et - st).count());
+        }
+        report(summarize("patchdb/query", ns, 0));
+    }
+}
+} // namespace
+
+bool benchmarkSuite(const std::string &resultsPath, const std::string &baselinePath,
+                    double tolerancePct)
+{
+    // The baseline is the results file of an earlier run; only the medians (and sizes) are
+    // compared
+    std::map<std::string, double> baseline;
+    if (!baselinePath.empty())
+    {
+        std::ifstream bf(string_to_path(baselinePath));
+        if (!bf.is_open())
+        {
+            std::cerr << "Unable to open baseline '" << baselinePath << "'" << std::endl;
+            return false;
+        }
+
+        std::string line;
+        while (std::getline(bf, line))
+        {
+            // Skip the header and the '#' lines the runner prints if stdout was captured
+            if (line.empty() || line[0] == '#' || line.rfind("scenario,", 0) == 0)
+                continue;
+
+            std::istringstream ls(line);
+            std::string scenario, median, p99, xrt, bytes;
+            if (!std::getline(ls, scenario, ',') || !std::getline(ls, median, ','))
+                continue;
+            if (std::getline(ls, p99, ',') && std::getline(ls, xrt, ',') &&
+                std::getline(ls, bytes, ',') && !bytes.empty())
+                baseline[scenario] = std::atof(bytes.c_str());
+            else
+                baseline[scenario] = std::atof(median.c_str());
+        }
+    }
+
+    std::ofstream rf;
+    if (!resultsPath.empty() && resultsPath != "-")
+        rf.open(string_to_path(resultsPath));
+    std::ostream &out = rf.is_open() ? rf : std::cout;
+
+    out << "scenario,median_ns,p99_ns,x_realtime,bytes,baseline,change_pct,status\n";
+
+    int regressions = 0;
+    runSuiteScenarios([&](const SuiteResult &r) {
+        out << r.scenario << ",";
+        if (!r.bytes)
+            out << r.medianNs << "," << r.p99Ns;
+        else
+            out << ",";
+        out << ",";
+        if (r.xRealtime > 0)
+            out << r.xRealtime;
+        out << ",";
+        if (r.bytes)
+            out << r.bytes;
+        out << ",";
+
+        // The baseline column is a median in ns, or bytes for the memory scenarios
+        double value = r.bytes ? (double)r.bytes : r.medianNs;
+        auto b = baseline.find(r.scenario);
+        if (b == baseline.end() || b->second <= 0)
+        {
+            out << ",," << (baseline.empty() ? "" : "new");
+        }
+        else
+        {
+            auto change = (value - b->second) / b->second * 100.0;
+            const char *status = "ok";
+            if (change > tolerancePct)
+            {
+                status = "regressed";
+                regressions++;
+            }
+            else if (change < -tolerancePct)
+            {
+                status = "improved";
+            }
+            out << b->second << "," << change << "," << status;
+        }
+        out << std::endl;
+    });
+
+    if (!baseline.empty())
+        std::cerr << regressions << " scenarios regressed by more than " << tolerancePct
+                  << "% against " << baselinePath << std::endl;
+
+    return regressions == 0;
+}
+
 } // namespace NonTest
 } // namespace Headless
 } // namespace Surge
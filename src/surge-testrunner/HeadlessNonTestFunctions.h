@@ -22,6 +22,7 @@
 #ifndef SURGE_SRC_SURGE_TESTRUNNER_HEADLESSNONTESTFUNCTIONS_H
 #define SURGE_SRC_SURGE_TESTRUNNER_HEADLESSNONTESTFUNCTIONS_H
 #include <iostream>
+#include <string>
 
 namespace Surge
 {
@@ -34,6 +35,16 @@ void restreamTemplatesWithModifications();
 void statsFromPlayingEveryPatch();
 void filterAnalyzer(int ft, int fst, std::ostream &os);
 void generateNLFeedbackNorms();
+/*
+ * Times a fixed set of scenarios (oscillators, filters, effects, modulators, decimation, voice
+ * starts, offline rendering, automation and patch loading) and writes a CSV of median, p99 and
+ * x realtime per scenario to resultsPath (or stdout for "" or "-"). The memory scenarios (struct
+ * sizes, oscillator slots and pools) write bytes instead. Given the results file of an earlier
+ * run as a baseline, returns false if any scenario's median or size has grown by more than
+ * tolerancePct.
+ */
+bool benchmarkSuite(const std::string &resultsPath, const std::string &baselinePath,
+                    double tolerancePct);
 [[noreturn]] void performancePlay(const std::string &patchName, int mode);
 } // namespace NonTest
 } // namespace Headless
@@ -24,6 +24,7 @@
 
 #include <iostream>
 #include <iomanip>
+#include <cmath>
 
 namespace Surge
 {
@@ -58,6 +59,39 @@ std::shared_ptr<SurgeSynthesizer> createSurge(int sr, bool loadAllPatches)
     return surge;
 }
 
+float sineThroughDecimatorRMS(int sr, SurgeStorage::DecimationQuality q, int note, int nBlocks)
+{
+    auto surge = createSurge(sr);
+    auto &sc = surge->storage.getPatch().scene[0];
+
+    surge->storage.decimationQuality = q;
+    sc.osc[0].type.val.i = ot_sine;
+    sc.octave.val.i = 3;
+    sc.filterunit[0].type.val.i = sst::filters::fut_none;
+    sc.filterunit[1].type.val.i = sst::filters::fut_none;
+    sc.wsunit.type.val.i = (int)sst::waveshapers::WaveshaperType::wst_none;
+    sc.lowcut.deactivated = true;
+
+    for (int i = 0; i < 10; ++i)
+        surge->process();
+
+    surge->playNote(0, note, 127, 0);
+
+    // Past the attack
+    for (int i = 0; i < 50; ++i)
+        surge->process();
+
+    double sumsq = 0;
+    for (int b = 0; b < nBlocks; ++b)
+    {
+        surge->process();
+        for (int i = 0; i < BLOCK_SIZE; ++i)
+            sumsq += surge->output[0][i] * surge->output[0][i];
+    }
+
+    return (float)sqrt(sumsq / (nBlocks * BLOCK_SIZE));
+}
+
 void writeToStream(const float *data, int nSamples, int nChannels, std::ostream &str)
 {
     int overSample = 8;
@@ -33,6 +33,13 @@ std::shared_ptr<SurgeSynthesizer> createSurge(int sr, bool loadAllPatches = fals
 
 void writeToStream(const float *data, int nSamples, int nChannels, std::ostream &str);
 
+/*
+** Render nBlocks of a single sine voice through scene A, three octaves above the MIDI note,
+** with filters, waveshaper and lowcut off so only the oscillator and the halfband decimator
+** touch it, and return the output RMS.
+*/
+float sineThroughDecimatorRMS(int sr, SurgeStorage::DecimationQuality q, int note, int nBlocks);
+
 /*
 ** One imagines expansions along these lines:
 
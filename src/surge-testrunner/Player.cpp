@@ -20,6 +20,7 @@
  * https://github.com/surge-synthesizer/surge
  */
 #include "Player.h"
+#include "OfflineRenderer.h"
 
 namespace Surge
 {
@@ -93,54 +94,49 @@ void playAsConfigured(std::shared_ptr<SurgeSynthesizer> surge, const playerEvent
     if (events.size() == 0)
         return;
 
-    int desiredSamples = events.back().atSample;
-    int blockCount = desiredSamples / BLOCK_SIZE + 1;
-    int currEvt = 0;
+    std::vector<Surge::Offline::Event> offlineEvents;
+    offlineEvents.reserve(events.size());
+    for (const auto &e : events)
+    {
+        Surge::Offline::Event oe;
+        oe.atSample = e.atSample;
+        oe.channel = e.channel;
+        oe.key = e.data1;
+        oe.velocity = e.data2;
+
+        switch (e.type)
+        {
+        case Event::NOTE_ON:
+            oe.type = Surge::Offline::Event::NOTE_ON;
+            break;
+        case Event::NOTE_OFF:
+            oe.type = Surge::Offline::Event::NOTE_OFF;
+            break;
+        case Event::LAMBDA_EVENT:
+            oe.type = Surge::Offline::Event::CALLBACK;
+            oe.callback = [surge, f = e.surgeLambda](SurgeSynthesizer *) { f(surge); };
+            break;
+        case Event::NO_EVENT:
+            oe.type = Surge::Offline::Event::CALLBACK;
+            break;
+        }
+        offlineEvents.push_back(std::move(oe));
+    }
+
+    surge->process();
+
+    Surge::Offline::Renderer renderer(surge.get());
+    renderer.setEvents(std::move(offlineEvents));
+    auto blockCount = renderer.prepare().blocks;
 
     *nChannels = 2;
     *nSamples = blockCount * BLOCK_SIZE;
     size_t dataSize = *nChannels * *nSamples;
     float *ldata = new float[dataSize];
-    memset(ldata, 0, dataSize);
+    memset(ldata, 0, dataSize * sizeof(float));
     *data = ldata;
 
-    size_t flidx = 0;
-
-    surge->process();
-
-    for (auto i = 0; i < blockCount; ++i)
-    {
-        int cs = i * BLOCK_SIZE;
-        while (currEvt < events.size() && events[currEvt].atSample <= cs + BLOCK_SIZE - 1)
-        {
-            Event e = events[currEvt];
-            switch (e.type)
-            {
-            case Event::NOTE_ON:
-                surge->playNote(e.channel, e.data1, e.data2, 0);
-                break;
-            case Event::NOTE_OFF:
-                surge->releaseNote(e.channel, e.data1, e.data2);
-                break;
-            case Event::LAMBDA_EVENT:
-                e.surgeLambda(surge);
-                break;
-            case Event::NO_EVENT:
-                break;
-            }
-
-            currEvt++;
-        }
-
-        surge->process();
-        for (int sm = 0; sm < BLOCK_SIZE; ++sm)
-        {
-            for (int oi = 0; oi < surge->getNumOutputs(); ++oi)
-            {
-                ldata[flidx++] = surge->output[oi][sm];
-            }
-        }
-    }
+    renderer.render(ldata, 0, blockCount);
 }
 
 void playOnPatch(std::shared_ptr<SurgeSynthesizer> surge, int patch, const playerEvents_t &events,
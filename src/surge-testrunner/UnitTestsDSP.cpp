@@ -746,4 +746,82 @@ TEST_CASE("Oscillator Onset", "[dsp]") // See issue 7570
                       << std::endl;*/
         }
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Decimation Quality Modes", "[dsp]")
+{
+    /*
+     * At 48k the voice path runs at 96k. Three octaves above MIDI 72 is about 4.2k, comfortably in
+     * the passband; three above 108 is about 33.5k, which the decimator has to remove or it
+     * folds back to 14.5k.
+     */
+    for (auto q : {SurgeStorage::DECIMATION_ECO, SurgeStorage::DECIMATION_STANDARD})
+    {
+        DYNAMIC_SECTION("Quality " << q)
+        {
+            auto pass = Surge::Headless::sineThroughDecimatorRMS(48000, q, 72, 500);
+            auto stop = Surge::Headless::sineThroughDecimatorRMS(48000, q, 108, 500);
+
+            REQUIRE(pass > 0.1);
+            auto rejectionDB = 20 * log10(pass / std::max(stop, 1e-9f));
+            INFO("Rejection " << rejectionDB << " dB");
+            REQUIRE(rejectionDB > (q == SurgeStorage::DECIMATION_ECO ? 12 : 40));
+        }
+    }
+
+    SECTION("Quality Can Change While Running")
+    {
+        auto surge = Surge::Headless::createSurge(48000);
+        surge->playNote(0, 60, 127, 0);
+        for (int i = 0; i < 100; ++i)
+        {
+            surge->storage.decimationQuality =
+                (i / 10) % 2 ? SurgeStorage::DECIMATION_ECO : SurgeStorage::DECIMATION_STANDARD;
+            surge->process();
+            for (int s = 0; s < BLOCK_SIZE; ++s)
+                REQUIRE(std::isfinite(surge->output[0][s]));
+        }
+    }
+
+    SECTION("Quality Changes Crossfade")
+    {
+        /*
+         * A swap of a warm filter for a cold one steps the output. With the crossfade the
+         * sample to sample change around the switch stays close to the steady state one.
+         */
+        auto surge = Surge::Headless::createSurge(48000);
+        auto &sc = surge->storage.getPatch().scene[0];
+        sc.osc[0].type.val.i = ot_sine;
+        sc.filterunit[0].type.val.i = sst::filters::fut_none;
+        sc.filterunit[1].type.val.i = sst::filters::fut_none;
+
+        surge->playNote(0, 60, 127, 0);
+        for (int i = 0; i < 200; ++i)
+            surge->process();
+
+        float prior = surge->output[0][BLOCK_SIZE - 1];
+        auto maxStep = [&surge, &prior](int blocks) {
+            float m = 0;
+            for (int b = 0; b < blocks; ++b)
+            {
+                surge->process();
+                for (int s = 0; s < BLOCK_SIZE; ++s)
+                {
+                    m = std::max(m, std::fabs(surge->output[0][s] - prior));
+                    prior = surge->output[0][s];
+                }
+            }
+            return m;
+        };
+
+        auto steady = maxStep(50);
+        REQUIRE(steady > 0);
+
+        for (auto q : {SurgeStorage::DECIMATION_ECO, SurgeStorage::DECIMATION_STANDARD})
+        {
+            surge->storage.decimationQuality = q;
+            auto across = maxStep(20);
+            INFO("Quality " << q << " steady " << steady << " across " << across);
+            REQUIRE(across < steady * 1.25f);
+        }
+    }
+}
@@ -23,6 +23,8 @@
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
+#include <chrono>
+#include <thread>
 
 #include "HeadlessUtils.h"
 #include "Player.h"
@@ -32,6 +34,7 @@
 
 #include "UnitTestUtilities.h"
 #include "AudioInputEffect.h"
+#include "airwindows/AirWindowsEffect.h"
 
 using namespace Surge::Test;
 
@@ -1081,3 +1084,240 @@ TEST_CASE("Audio Input Effect", "[fx]")
         }
     }
 }
+
+TEST_CASE("Parallel FX Matches Serial FX", "[fx]")
+{
+    auto setFX = [](std::shared_ptr<SurgeSynthesizer> surge, int slot, int type) {
+        auto *pt = &(surge->storage.getPatch().fx[slot].type);
+        auto awv = 1.f * type / (pt->val_max.i - pt->val_min.i);
+        surge->setParameter01(surge->idForParameter(pt), awv, false);
+    };
+
+    auto makeSurge = [&setFX](int workers) {
+        auto surge = Surge::Headless::createSurge(48000);
+        REQUIRE(surge);
+        surge->storage.rngGen.g.seed(8675309);
+        surge->setFXWorkerThreads(workers);
+
+        auto &patch = surge->storage.getPatch();
+        patch.scenemode.val.i = sm_dual;
+
+        setFX(surge, fxslot_ains1, fxt_chorus4);
+        setFX(surge, fxslot_ains2, fxt_waveshaper);
+        setFX(surge, fxslot_bins1, fxt_distortion);
+        setFX(surge, fxslot_bins2, fxt_freqshift);
+        setFX(surge, fxslot_send1, fxt_ensemble);
+        setFX(surge, fxslot_send2, fxt_ringmod);
+        // Combulator draws from the storage RNG and the delay is an sst effect, so these two stay
+        // on the audio thread
+        setFX(surge, fxslot_send3, fxt_combulator);
+        setFX(surge, fxslot_send4, fxt_delay);
+
+        for (int sc = 0; sc < n_scenes; ++sc)
+            for (int s = 0; s < n_send_slots; ++s)
+                patch.scene[sc].send_level[s].val.f = 0.5f;
+
+        for (int i = 0; i < 10; ++i)
+            surge->process();
+
+        return surge;
+    };
+
+    auto serial = makeSurge(0);
+    auto parallel = makeSurge(3);
+    REQUIRE(serial->getFXWorkerThreads() == 0);
+    REQUIRE(parallel->getFXWorkerThreads() == 3);
+
+    REQUIRE(parallel->fx[fxslot_ains1]->allowsConcurrentProcessing());
+    REQUIRE(parallel->fx[fxslot_send1]->allowsConcurrentProcessing());
+    REQUIRE_FALSE(parallel->fx[fxslot_send3]->allowsConcurrentProcessing());
+    REQUIRE_FALSE(parallel->fx[fxslot_send4]->allowsConcurrentProcessing());
+
+    for (auto s : {serial, parallel})
+    {
+        s->playNote(0, 48, 120, 0, -1);
+        s->playNote(0, 55, 120, 0, -1);
+    }
+
+    for (int blk = 0; blk < 2000; ++blk)
+    {
+        if (blk == 500)
+        {
+            // A disabled send is not handed to the pool and must not feed the global ring out
+            for (auto s : {serial, parallel})
+                s->storage.getPatch().fx_disable.val.i |= 1 << fxslot_send2;
+        }
+
+        if (blk == 1000)
+        {
+            for (auto s : {serial, parallel})
+            {
+                s->releaseNote(0, 48, 0);
+                s->releaseNote(0, 55, 0);
+            }
+        }
+
+        serial->process();
+        parallel->process();
+
+        INFO("Block " << blk);
+        for (int c = 0; c < N_OUTPUTS; ++c)
+            for (int i = 0; i < BLOCK_SIZE; ++i)
+                REQUIRE(serial->output[c][i] == parallel->output[c][i]);
+    }
+}
+
+TEST_CASE("Measured Tail Idles FX Early", "[fx]")
+{
+    auto blocksUntilDormant = [](bool measured) {
+        auto surge = Surge::Headless::createSurge(48000);
+        REQUIRE(surge);
+        surge->storage.fxMeasuredTail = measured;
+
+        auto *pt = &(surge->storage.getPatch().fx[fxslot_ains1].type);
+        auto awv = 1.f * float(fxt_reverb2) / (pt->val_max.i - pt->val_min.i);
+        surge->setParameter01(surge->idForParameter(pt), awv, false);
+
+        for (int i = 0; i < 10; ++i)
+            surge->process();
+
+        surge->playNote(0, 60, 127, 0);
+        for (int i = 0; i < 100; ++i)
+            surge->process();
+        REQUIRE(!(surge->fxDormantMask & (1 << fxslot_ains1)));
+
+        surge->releaseNote(0, 60, 0);
+
+        int blocks = 0;
+        while (!(surge->fxDormantMask & (1 << fxslot_ains1)) && blocks < 100000)
+        {
+            surge->process();
+            blocks++;
+        }
+
+        // Any input wakes it straight back up
+        surge->playNote(0, 60, 127, 0);
+        for (int i = 0; i < 2; ++i)
+            surge->process();
+        REQUIRE(!(surge->fxDormantMask & (1 << fxslot_ains1)));
+
+        return blocks;
+    };
+
+    auto fixed = blocksUntilDormant(false);
+    auto measured = blocksUntilDormant(true);
+
+    REQUIRE(fixed < 100000);
+    REQUIRE(measured < fixed);
+}
+
+TEST_CASE("Airwindows Type Change Is Built Off The Audio Thread", "[fx]")
+{
+    auto surge = Surge::Headless::createSurge(44100);
+    REQUIRE(surge);
+
+    // No builder thread until something asks for one
+    for (int i = 0; i < 10; ++i)
+        surge->process();
+    REQUIRE_FALSE(surge->storage.airWindowsBuilder);
+
+    auto *pt = &(surge->storage.getPatch().fx[0].type);
+    auto awv = 1.f * float(fxt_airwindows) / (pt->val_max.i - pt->val_min.i);
+    surge->setParameter01(surge->idForParameter(pt), awv, false);
+
+    for (int i = 0; i < 10; ++i)
+        surge->process();
+
+    auto *aw = dynamic_cast<AirWindowsEffect *>(surge->fx[0].get());
+    REQUIRE(aw);
+    REQUIRE(surge->storage.airWindowsBuilder);
+
+    // Even the first processor is built off the audio thread; the slot passes audio until then
+    for (int blocks = 0; !aw->airwin && blocks < 2000; ++blocks)
+    {
+        surge->process();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(aw->airwin);
+    auto *first = aw->airwin.get();
+
+    auto *pawt = &(surge->storage.getPatch().fx[0].p[0]);
+    auto target = (aw->lastSelected + 7) % (int)AirWindowsEffect::fxreg.size();
+    pawt->val.i = target;
+
+    // The previous processor keeps running until the builder hands the new one over
+    int blocks = 0;
+    while (aw->lastSelected != target && blocks < 2000)
+    {
+        surge->process();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        blocks++;
+    }
+
+    REQUIRE(aw->lastSelected == target);
+    REQUIRE(aw->airwin);
+    REQUIRE(aw->airwin.get() != first);
+    REQUIRE(pawt->user_data != nullptr);
+}
+
+TEST_CASE("Airwindows Drops Builds Overtaken By Later Requests", "[fx]")
+{
+    auto surge = Surge::Headless::createSurge(44100);
+    REQUIRE(surge);
+
+    auto *pt = &(surge->storage.getPatch().fx[0].type);
+    auto awv = 1.f * float(fxt_airwindows) / (pt->val_max.i - pt->val_min.i);
+    surge->setParameter01(surge->idForParameter(pt), awv, false);
+
+    for (int i = 0; i < 10; ++i)
+        surge->process();
+
+    auto *aw = dynamic_cast<AirWindowsEffect *>(surge->fx[0].get());
+    REQUIRE(aw);
+    for (int blocks = 0; !aw->airwin && blocks < 2000; ++blocks)
+    {
+        surge->process();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(aw->airwin);
+
+    auto *pawt = &(surge->storage.getPatch().fx[0].p[0]);
+    auto n = (int)AirWindowsEffect::fxreg.size();
+    auto a = aw->lastSelected;
+    auto b = (a + 7) % n;
+    auto c = (a + 11) % n;
+
+    auto settle = [&]() {
+        for (int i = 0; i < 200; ++i)
+        {
+            surge->process();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    };
+
+    SECTION("A to B and back to A keeps A")
+    {
+        auto *first = aw->airwin.get();
+
+        pawt->val.i = b;
+        surge->process();
+        pawt->val.i = a;
+        settle();
+
+        REQUIRE(aw->lastSelected == a);
+        REQUIRE(aw->airwin.get() == first);
+    }
+
+    SECTION("B to C and back to B ends on B")
+    {
+        pawt->val.i = b;
+        surge->process();
+        pawt->val.i = c;
+        surge->process();
+        pawt->val.i = b;
+        settle();
+
+        REQUIRE(aw->lastSelected == b);
+        REQUIRE(aw->airwin);
+    }
+}
@@ -21,10 +21,15 @@
  */
 #include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <thread>
 
 #include "HeadlessUtils.h"
 #include "BiquadFilter.h"
 #include "MemoryPool.h"
+#include "OfflineRenderer.h"
+#include "SurgeMemoryPools.h"
+#include "ParameterRefreshQueue.h"
 
 #include "sst/plugininfra/strnatcmp.h"
 
@@ -182,6 +187,243 @@ TEST_CASE("Memory Pool Works", "[infra]")
     }
 }
 
+TEST_CASE("Parameter Refresh Queue", "[infra]")
+{
+    SECTION("Ring Delivers Each Id Once In Order")
+    {
+        Surge::ParameterRefreshQueue<200, 8> q;
+        q.push(5);
+        q.push(7);
+        q.push(5);
+
+        std::vector<int> ids;
+        q.drain(ids);
+        REQUIRE(ids == std::vector<int>{5, 7});
+        REQUIRE(q.overflowCount == 0);
+
+        ids.clear();
+        q.drain(ids);
+        REQUIRE(ids.empty());
+    }
+
+    SECTION("Overflow Falls Back To The Dirty Bitset")
+    {
+        Surge::ParameterRefreshQueue<200, 8> q;
+        for (int i = 0; i < 100; ++i)
+            q.push(i);
+        q.push(3);
+        q.push(-1);
+        q.push(200);
+
+        REQUIRE(q.overflowCount == 93);
+
+        std::vector<int> ids;
+        q.drain(ids);
+        REQUIRE(ids.size() == 100);
+        std::sort(ids.begin(), ids.end());
+        for (int i = 0; i < 100; ++i)
+            REQUIRE(ids[i] == i);
+
+        // and the ring is usable again afterwards
+        ids.clear();
+        q.push(150);
+        q.drain(ids);
+        REQUIRE(ids == std::vector<int>{150});
+    }
+
+    SECTION("Two Producers Lose Nothing")
+    {
+        // Each thread owns half the ids; whatever the interleaving every id must come out
+        static constexpr int nIds = 2048;
+        Surge::ParameterRefreshQueue<nIds, 64> q;
+        std::vector<int> seen(nIds, 0);
+        std::atomic<int> done{0};
+
+        auto producer = [&q, &done](int first) {
+            for (int rep = 0; rep < 20; ++rep)
+                for (int i = first; i < nIds; i += 2)
+                    q.push(i);
+            done++;
+        };
+
+        std::thread a(producer, 0), b(producer, 1);
+
+        std::vector<int> ids;
+        while (done < 2)
+        {
+            ids.clear();
+            q.drain(ids);
+            for (auto id : ids)
+                seen[id]++;
+        }
+        a.join();
+        b.join();
+
+        ids.clear();
+        q.drain(ids);
+        for (auto id : ids)
+            seen[id]++;
+
+        for (int i = 0; i < nIds; ++i)
+        {
+            INFO("id " << i);
+            REQUIRE(seen[i] > 0);
+        }
+    }
+
+    SECTION("External Parameter Sets Reach The Queue Without A Full Refresh")
+    {
+        auto surge = Surge::Headless::createSurge(44100);
+        REQUIRE(surge);
+
+        std::vector<int> ids;
+        surge->refreshParameterQueue.drain(ids);
+        ids.clear();
+        surge->refresh_editor = false;
+
+        auto &patch = surge->storage.getPatch();
+        auto cutoff = patch.scene[0].filterunit[0].cutoff.id;
+        auto reso = patch.scene[0].filterunit[0].resonance.id;
+        SurgeSynthesizer::ID cutoffId, resoId;
+        REQUIRE(surge->fromSynthSideId(cutoff, cutoffId));
+        REQUIRE(surge->fromSynthSideId(reso, resoId));
+
+        for (int i = 0; i < 5000; ++i)
+        {
+            surge->setParameter01(cutoffId, (i % 100) / 100.f, true);
+            surge->setParameter01(resoId, (i % 50) / 50.f, true);
+        }
+
+        REQUIRE(!surge->refresh_editor);
+
+        surge->refreshParameterQueue.drain(ids);
+        std::sort(ids.begin(), ids.end());
+        REQUIRE(ids == std::vector<int>{std::min(cutoff, reso), std::max(cutoff, reso)});
+    }
+}
+
+TEST_CASE("Storages Share Immutable Tables", "[infra]")
+{
+    auto a = Surge::Headless::createSurge(44100);
+    auto b = Surge::Headless::createSurge(48000);
+    REQUIRE(a);
+    REQUIRE(b);
+
+    REQUIRE(a->storage.sincTableProvider == b->storage.sincTableProvider);
+    REQUIRE(a->storage.sinctable == b->storage.sinctable);
+    REQUIRE(a->storage.sinctableI16 == b->storage.sinctableI16);
+    REQUIRE(a->storage.WindowWT);
+    REQUIRE(a->storage.WindowWT == b->storage.WindowWT);
+}
+
+TEST_CASE("Offline Renderer Matches The Block Loop", "[infra]")
+{
+    std::vector<Surge::Offline::Event> events;
+    for (int c = 0; c < 12; ++c)
+    {
+        for (int n = 0; n < 6; ++n)
+        {
+            Surge::Offline::Event e;
+            e.atSample = c * 4000 + n * 5;
+            e.key = 48 + c + 4 * n;
+            e.velocity = 90;
+            events.push_back(e);
+
+            e.type = Surge::Offline::Event::NOTE_OFF;
+            e.atSample = c * 4000 + 3000;
+            events.push_back(e);
+        }
+    }
+
+    Surge::Offline::Event cb;
+    cb.type = Surge::Offline::Event::CALLBACK;
+    cb.atSample = 20000;
+    cb.callback = [](SurgeSynthesizer *s) {
+        SurgeSynthesizer::ID rid;
+        REQUIRE(s->fromSynthSideId(s->storage.getPatch().scene[0].filterunit[0].cutoff.id, rid));
+        s->setParameter01(rid, 0.3f);
+    };
+    events.push_back(cb);
+    cb.callback = nullptr;
+    cb.atSample = 60000;
+    events.push_back(cb);
+
+    std::stable_sort(events.begin(), events.end(),
+                     [](auto &a, auto &b) { return a.atSample < b.atSample; });
+
+    for (auto ot : {ot_classic, ot_string})
+    {
+        DYNAMIC_SECTION("Osc Type " << osc_type_names[ot])
+        {
+            auto make = [ot]() {
+                auto surge = Surge::Headless::createSurge(44100);
+                for (int o = 0; o < n_oscs; ++o)
+                    surge->storage.getPatch().scene[0].osc[o].type.val.i = ot;
+                surge->storage.getPatch().update_controls(true);
+                surge->storage.memoryPools->resetAllPools(&surge->storage);
+                surge->storage.rngGen.g.seed(1234);
+                surge->process();
+                return surge;
+            };
+
+            auto blocks = events.back().atSample / BLOCK_SIZE + 1;
+
+            auto looped = make();
+            std::vector<float> loopOut(blocks * BLOCK_SIZE * 2);
+            size_t ei = 0;
+            for (int64_t b = 0; b < blocks; ++b)
+            {
+                while (ei < events.size() && events[ei].atSample < (b + 1) * BLOCK_SIZE)
+                {
+                    auto &e = events[ei++];
+                    if (e.type == Surge::Offline::Event::NOTE_ON)
+                        looped->playNote(e.channel, e.key, e.velocity, 0);
+                    else if (e.type == Surge::Offline::Event::NOTE_OFF)
+                        looped->releaseNote(e.channel, e.key, e.velocity);
+                    else if (e.callback)
+                        e.callback(looped.get());
+                }
+                looped->process();
+                for (int i = 0; i < BLOCK_SIZE; ++i)
+                {
+                    loopOut[(b * BLOCK_SIZE + i) * 2] = looped->output[0][i];
+                    loopOut[(b * BLOCK_SIZE + i) * 2 + 1] = looped->output[1][i];
+                }
+            }
+
+            auto rendered = make();
+            rendered->storage.voiceStartBudgetNs = 1;
+            Surge::Offline::Renderer renderer(rendered.get());
+            renderer.setEvents(events);
+            auto &plan = renderer.prepare();
+            REQUIRE(plan.blocks == blocks);
+            REQUIRE(plan.peakNoteOnsInBlock == 6);
+            REQUIRE(plan.peakVoices >= 6);
+
+            // Every voice the plan can have sounding finds its slots and delay lines waiting
+            auto &pools = *rendered->storage.memoryPools;
+            auto voices = (size_t)std::min(plan.peakVoices, MAX_VOICES);
+            REQUIRE(pools.oscillatorSlots.slotsFree(ot) >= n_oscs * voices);
+            if (ot == ot_string)
+                REQUIRE(pools.stringDelayLines.position >= n_oscs * 2 * voices);
+
+            std::vector<float> renderOut(blocks * BLOCK_SIZE * 2);
+            auto half = blocks / 2;
+            REQUIRE(renderer.render(renderOut.data(), 0, half) == half);
+            REQUIRE(renderer.render(renderOut.data() + half * BLOCK_SIZE * 2, half, blocks) ==
+                    blocks - half);
+            REQUIRE(rendered->storage.voiceStartBudgetNs == 1);
+            REQUIRE(rendered->voiceStartStats.deferred == 0);
+
+            for (size_t i = 0; i < loopOut.size(); ++i)
+            {
+                INFO("Sample " << i / 2);
+                REQUIRE(renderOut[i] == loopOut[i]);
+            }
+        }
+    }
+}
+
 TEST_CASE("strnatcmp With Spaces", "[infra]")
 {
     SECTION("Basic Comparison")
@@ -1592,6 +1592,57 @@ TEST_CASE("MIDI Learn", "[midi]")
     REQUIRE(pd == Approx(-7).margin(.1));
 }
 
+TEST_CASE("Smoothed Parameters Reach Their Targets", "[midi]")
+{
+    auto surge = Surge::Headless::createSurge(44100);
+    REQUIRE(surge);
+
+    auto &patch = surge->storage.getPatch();
+    std::vector<int> ids;
+
+    for (auto *p : patch.param_ptr)
+    {
+        if (p->valtype == vt_float && !p->affect_other_parameters)
+            ids.push_back(p->id);
+        if (ids.size() == 100)
+            break;
+    }
+    REQUIRE(ids.size() == 100);
+
+    auto target = [](int i) { return (i % 2) ? 0.2f : 0.8f; };
+
+    for (int i = 0; i < ids.size(); ++i)
+        surge->setParameterSmoothed(ids[i], target(i));
+
+    // A direct set takes a parameter out of smoothing
+    SurgeSynthesizer::ID rid;
+    REQUIRE(surge->fromSynthSideId(ids[7], rid));
+    surge->setParameter01(rid, 0.5f);
+
+    for (int i = 0; i < 1000; ++i)
+        surge->process();
+
+    for (int i = 0; i < ids.size(); ++i)
+    {
+        INFO("Parameter " << ids[i]);
+        auto expected = (i == 7) ? 0.5f : target(i);
+        REQUIRE(patch.param_ptr[ids[i]]->get_value_f01() == Approx(expected).margin(1e-2));
+    }
+
+    // Every interpolator has settled and been released, so a second wave can use them all
+    for (int i = 0; i < ids.size(); ++i)
+        surge->setParameterSmoothed(ids[i], 1.f - target(i));
+
+    for (int i = 0; i < 1000; ++i)
+        surge->process();
+
+    for (int i = 0; i < ids.size(); ++i)
+    {
+        INFO("Parameter " << ids[i]);
+        REQUIRE(patch.param_ptr[ids[i]]->get_value_f01() == Approx(1.f - target(i)).margin(1e-2));
+    }
+}
+
 TEST_CASE("Poly Chords Blow Through Limit", "[midi]")
 {
     INFO("See Issue #6221");
@@ -1432,4 +1432,238 @@ TEST_CASE("Mod LFO Is Well Behaved", "[mod]")
             }
         }
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Modulation Snapshot Follows The Engine", "[mod]")
+{
+    auto surge = Surge::Headless::createSurge(44100);
+    REQUIRE(surge);
+
+    SurgeSynthesizer::ModulationSnapshot snap;
+
+    surge->setMacroParameter01(2, 0.7);
+    for (int i = 0; i < 10; ++i)
+        surge->process();
+
+    surge->getModulationSnapshot(snap);
+    REQUIRE(snap.blockCount > 0);
+    REQUIRE(snap.macroTarget01[2] == Approx(0.7));
+    REQUIRE(snap.voiceKey[0] == -1);
+    REQUIRE(snap.voice[0][ms_ampeg][0] == 0.f);
+
+    auto lastBlock = snap.blockCount;
+    surge->playNote(0, 64, 127, 0);
+    for (int i = 0; i < 50; ++i)
+        surge->process();
+
+    surge->getModulationSnapshot(snap);
+    REQUIRE(snap.blockCount == lastBlock + 50);
+    REQUIRE(snap.voiceKey[0] == 64);
+    REQUIRE(snap.voice[0][ms_ampeg][0] > 0.f);
+    REQUIRE(snap.scene[0][ms_ctrl3][0] == Approx(0.7).margin(1e-3));
+
+    // A snapshot taken without the engine moving is the same snapshot
+    SurgeSynthesizer::ModulationSnapshot again;
+    surge->getModulationSnapshot(again);
+    REQUIRE(again.blockCount == snap.blockCount);
+    REQUIRE(again.voice[0][ms_ampeg][0] == snap.voice[0][ms_ampeg][0]);
+
+    // Only flagged changes count as ones the editor should follow
+    auto engineChanges = snap.macroChangeCount[2];
+    REQUIRE(engineChanges > 0);
+
+    auto cms =
+        (ControllerModulationSource *)surge->storage.getPatch().scene[0].modsources[ms_ctrl3];
+    cms->set_target01(0.2, false);
+    for (int i = 0; i < 4; ++i)
+        surge->process();
+    surge->getModulationSnapshot(snap);
+    REQUIRE(snap.macroChangeCount[2] == engineChanges);
+    REQUIRE(snap.macroTarget01[2] == Approx(0.2));
+
+    surge->setMacroParameter01(2, 0.4);
+    for (int i = 0; i < 4; ++i)
+        surge->process();
+    surge->getModulationSnapshot(snap);
+    REQUIRE(snap.macroChangeCount[2] == engineChanges + 1);
+}
+
+TEST_CASE("Batched ADSR Matches Scalar ADSR", "[mod]")
+{
+    auto surge = Surge::Headless::createSurge(48000);
+    REQUIRE(surge);
+
+    auto *adsrstorage = &(surge->storage.getPatch().scene[0].adsr[0]);
+    auto &sd = surge->storage.getPatch().scenedata[0];
+    srand(42);
+
+    auto rnd = [](float lo, float hi) { return lo + (hi - lo) * (float)rand() / (float)RAND_MAX; };
+
+    for (int gated = 0; gated < 2; ++gated)
+    {
+        adsrstorage->r.deform_type = gated;
+
+        for (int trial = 0; trial < 50; ++trial)
+        {
+            INFO("Trial " << trial << " gated release " << gated);
+
+            constexpr int nenv = 4;
+            pdata lcS[nenv][n_scene_params], lcQ[nenv][n_scene_params];
+            ADSRModulationSource scalar[nenv], batched[nenv];
+            ADSRModulationSource *lanes[nenv];
+            int releaseAt[nenv];
+
+            for (int i = 0; i < nenv; ++i)
+            {
+                memcpy(lcS[i], sd, sizeof(lcS[i]));
+
+                // Include sustains and decays around the special cases in the quadratic decay
+                lcS[i][adsrstorage->a.param_id_in_scene].f = rnd(-8, 2);
+                lcS[i][adsrstorage->d.param_id_in_scene].f = rnd(-9, 2);
+                lcS[i][adsrstorage->s.param_id_in_scene].f = (trial % 3 == 0) ? 0.f : rnd(0, 1);
+                lcS[i][adsrstorage->r.param_id_in_scene].f = rnd(-8, 2);
+                lcS[i][adsrstorage->a_s.param_id_in_scene].i = rand() % 3;
+                lcS[i][adsrstorage->d_s.param_id_in_scene].i = rand() % 3;
+                lcS[i][adsrstorage->r_s.param_id_in_scene].i = rand() % 3;
+                // One lane in analog mode now and then, which takes the scalar path
+                lcS[i][adsrstorage->mode.param_id_in_scene].b = (trial % 7 == 0 && i == 2);
+
+                memcpy(lcQ[i], lcS[i], sizeof(lcQ[i]));
+
+                scalar[i].init(&(surge->storage), adsrstorage, lcS[i], nullptr);
+                batched[i].init(&(surge->storage), adsrstorage, lcQ[i], nullptr);
+                scalar[i].attack();
+                batched[i].attack();
+                lanes[i] = &batched[i];
+                releaseAt[i] = 10 + rand() % 400;
+            }
+
+            for (int b = 0; b < 1000; ++b)
+            {
+                for (int i = 0; i < nenv; ++i)
+                {
+                    if (b == releaseAt[i])
+                    {
+                        if (i == 3)
+                        {
+                            scalar[i].uber_release();
+                            batched[i].uber_release();
+                        }
+                        else
+                        {
+                            scalar[i].release();
+                            batched[i].release();
+                        }
+                    }
+                    scalar[i].process_block();
+                }
+
+                ADSRModulationSource::processBlockQuad(lanes, nenv);
+
+                for (int i = 0; i < nenv; ++i)
+                {
+                    INFO("Block " << b << " lane " << i);
+                    REQUIRE(batched[i].getEnvState() == scalar[i].getEnvState());
+                    REQUIRE(batched[i].get_output(0) == scalar[i].get_output(0));
+                    REQUIRE(batched[i].is_idle() == scalar[i].is_idle());
+                }
+            }
+        }
+    }
+
+    adsrstorage->r.deform_type = 0;
+}
+
+TEST_CASE("Delta Parameter Copy Matches A Full Copy", "[mod]")
+{
+    auto surge = Surge::Headless::createSurge(44100);
+    REQUIRE(surge);
+
+    auto &patch = surge->storage.getPatch();
+    surge->storage.deltaParamCopy = true;
+
+    auto &sc = patch.scene[0];
+    surge->setModDepth01(sc.volume.id, ms_slfo1, 0, 0, 0.3);
+    surge->setModDepth01(patch.volume.id, ms_slfo2, 0, 0, 0.2);
+    surge->applyParameterMonophonicModulation(&sc.pan, 0.25);
+
+    auto requireFullCopyMatches = [&]() {
+        pdata full[n_scene_params], fullOrig[n_scene_params], fullGlobal[n_global_params];
+
+        patch.copy_globaldata(patch.globaldata);
+        patch.copy_scenedata(patch.scenedata[0], patch.scenedataOrig[0], 0);
+        surge->storage.deltaParamCopy = false;
+        patch.copy_globaldata(fullGlobal);
+        patch.copy_scenedata(full, fullOrig, 0);
+        surge->storage.deltaParamCopy = true;
+
+        for (int i = 0; i < n_global_params; ++i)
+            REQUIRE(patch.globaldata[i].i == fullGlobal[i].i);
+        for (int i = 0; i < n_scene_params; ++i)
+        {
+            INFO("Scene param " << i);
+            REQUIRE(patch.scenedata[0][i].i == full[i].i);
+            if (patch.param_ptr[i + patch.scene_start[0]]->ctrlgroup == cg_OSC)
+                REQUIRE(patch.scenedataOrig[0][i].i == fullOrig[i].i);
+        }
+    };
+
+    auto setParam = [&](int id, float v) {
+        SurgeSynthesizer::ID rid;
+        REQUIRE(surge->fromSynthSideId(id, rid));
+        surge->setParameter01(rid, v);
+    };
+
+    surge->playNote(0, 60, 100, 0);
+
+    for (int b = 0; b < 200; ++b)
+    {
+        if (b % 7 == 0)
+        {
+            setParam(sc.filterunit[0].cutoff.id, (b % 13) / 13.f);
+            setParam(patch.fx[0].p[0].id, (b % 5) / 5.f);
+        }
+        if (b == 100)
+        {
+            surge->clearModulation(sc.volume.id, ms_slfo1, 0, 0);
+            surge->applyParameterMonophonicModulation(&sc.pan, 0.f);
+        }
+
+        surge->process();
+        requireFullCopyMatches();
+    }
+
+    SECTION("A Full Copy Request Picks Up Direct Writes")
+    {
+        // Write straight into val, the way loads and pastes do, then ask for a full copy
+        sc.osc[0].pitch.val.f = 3.5f;
+        patch.fx[0].p[1].val.f = 0.25f;
+        patch.markAllParametersChanged();
+
+        surge->process();
+        requireFullCopyMatches();
+    }
+
+    SECTION("Monophonic Modulation Is Only Reapplied Where It Changed")
+    {
+        auto isRefreshed = [&](int id) {
+            return (patch.refreshedParams[id >> 6] & ((uint64_t)1 << (id & 63))) != 0;
+        };
+        auto panOffset = sc.pan.id - patch.scene_start[0];
+
+        surge->applyParameterMonophonicModulation(&sc.pan, 0.1);
+        surge->process();
+        REQUIRE(isRefreshed(sc.pan.id));
+
+        auto modulated = patch.scenedata[0][panOffset].f;
+        REQUIRE(modulated == Approx(sc.pan.val.f + 0.1 * (sc.pan.val_max.f - sc.pan.val_min.f)));
+
+        for (int b = 0; b < 10; ++b)
+        {
+            surge->process();
+            REQUIRE(!isRefreshed(sc.pan.id));
+            REQUIRE(patch.scenedata[0][panOffset].f == modulated);
+        }
+
+        requireFullCopyMatches();
+    }
+}
@@ -542,6 +542,129 @@ TEST_CASE("Zero Size Loops", "[mseg]")
     }
 }
 
+TEST_CASE("Segment Lookup Matches A Linear Scan", "[mseg]")
+{
+    srand(2112);
+    auto rnd = []() { return (float)rand() / (float)RAND_MAX; };
+
+    for (int trial = 0; trial < 100; ++trial)
+    {
+        INFO("Trial " << trial);
+        MSEGStorage ms;
+        ms.n_activeSegments = 1 + rand() % max_msegs;
+
+        for (int i = 0; i < ms.n_activeSegments; ++i)
+        {
+            ms.segments[i].duration = (rand() % 8 == 0) ? 0.f : rnd() * 0.2f;
+            ms.segments[i].type = MSEGStorage::segment::LINEAR;
+            ms.segments[i].v0 = rnd() * 2 - 1;
+        }
+
+        resetCP(&ms);
+        Surge::MSEG::rebuildCache(&ms);
+        REQUIRE(ms.segmentsOrdered);
+
+        // The first segment holding t, the way the lookup used to find it
+        auto scan = [&ms](double t, bool closedEnd) {
+            for (int i = 0; i < ms.n_activeSegments; ++i)
+                if (t >= ms.segmentStart[i] &&
+                    (closedEnd ? t <= ms.segmentEnd[i] : t < ms.segmentEnd[i]))
+                    return i;
+            return -1;
+        };
+
+        int cursor = 0;
+        double t = 0;
+
+        // Forward playback, then random jumps, both through one cursor
+        for (int step = 0; step < 2000; ++step)
+        {
+            t = (step < 1000) ? t + rnd() * 0.01 : rnd() * ms.totalDuration * 0.999;
+
+            if (t >= ms.totalDuration)
+                t = 0;
+
+            float along = 0, alongNoCursor = 0;
+            auto idx = Surge::MSEG::timeToSegment(&ms, t, true, along, cursor);
+            auto idxNoCursor = Surge::MSEG::timeToSegment(&ms, t, true, alongNoCursor);
+
+            REQUIRE(idx == scan(t, false));
+            REQUIRE(idxNoCursor == idx);
+            REQUIRE(along == alongNoCursor);
+        }
+    }
+}
+
+TEST_CASE("Baked MSEG Lookup", "[mseg]")
+{
+    MSEGStorage ms;
+    ms.editMode = MSEGStorage::LFO;
+    ms.loopMode = MSEGStorage::LoopMode::LOOP;
+    ms.n_activeSegments = 64;
+
+    for (int i = 0; i < ms.n_activeSegments; ++i)
+    {
+        ms.segments[i].duration = 1.f / ms.n_activeSegments;
+        ms.segments[i].type = MSEGStorage::segment::LINEAR;
+        ms.segments[i].v0 = sin(i * 2.0 * M_PI / ms.n_activeSegments);
+    }
+
+    resetCP(&ms);
+    Surge::MSEG::rebuildCache(&ms, true);
+
+    SECTION("Follows The Segments")
+    {
+        REQUIRE(ms.bakedLookupValid);
+
+        Surge::MSEG::EvaluatorState exact, baked;
+        baked.allowBakedLookup = true;
+
+        for (int i = 0; i < 5000; ++i)
+        {
+            float phase = i / 5000.f;
+            INFO("At phase " << phase);
+            REQUIRE(Surge::MSEG::valueAt(3, phase, 0, &ms, &baked) ==
+                    Approx(Surge::MSEG::valueAt(3, phase, 0, &ms, &exact)).margin(1e-4));
+        }
+    }
+
+    SECTION("Deform Falls Back To The Segments")
+    {
+        Surge::MSEG::EvaluatorState exact, baked;
+        baked.allowBakedLookup = true;
+
+        for (int i = 0; i < 100; ++i)
+        {
+            float phase = i / 100.f;
+            REQUIRE(Surge::MSEG::valueAt(0, phase, 0.6, &ms, &baked) ==
+                    Surge::MSEG::valueAt(0, phase, 0.6, &ms, &exact));
+        }
+    }
+
+    SECTION("Not Baked Unless Asked")
+    {
+        Surge::MSEG::rebuildCache(&ms);
+        REQUIRE(!ms.bakedLookupValid);
+    }
+
+    SECTION("Not Baked With Random Or Retriggering Segments")
+    {
+        ms.segments[10].type = MSEGStorage::segment::BROWNIAN;
+        Surge::MSEG::rebuildCache(&ms, true);
+        REQUIRE(!ms.bakedLookupValid);
+
+        ms.segments[10].type = MSEGStorage::segment::LINEAR;
+        ms.segments[20].retriggerAEG = true;
+        Surge::MSEG::rebuildCache(&ms, true);
+        REQUIRE(!ms.bakedLookupValid);
+
+        ms.segments[20].retriggerAEG = false;
+        ms.editMode = MSEGStorage::ENVELOPE;
+        Surge::MSEG::rebuildCache(&ms, true);
+        REQUIRE(!ms.bakedLookupValid);
+    }
+}
+
 /*
  * Tests to add
  * - loop point 0 (start = end + 1)
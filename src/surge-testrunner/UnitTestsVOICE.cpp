@@ -27,6 +27,7 @@
 
 #include "HeadlessUtils.h"
 #include "Player.h"
+#include "SurgeMemoryPools.h"
 
 #include "catch2/catch_amalgamated.hpp"
 
@@ -327,3 +328,200 @@ TEST_CASE("Play and release Frequency and Note ID", "[voice]")
         }
     }
 }
+
+TEST_CASE("Voice Oscillators Come From The Slot Pool", "[voice]")
+{
+    auto surge = Surge::Headless::createSurge(44100);
+    REQUIRE(surge);
+
+    auto &slots = surge->storage.memoryPools->oscillatorSlots;
+    auto &patch = surge->storage.getPatch();
+    auto &sc = patch.scene[0];
+    for (int s = 0; s < n_scenes; ++s)
+        for (int o = 0; o < n_oscs; ++o)
+            patch.scene[s].osc[o].type.val.i = ot_sine;
+    patch.polylimit.val.i = 8;
+    surge->storage.memoryPools->resetAllPools(&surge->storage);
+
+    // A slot for every oscillator of every voice in both scenes, whatever the polyphony
+    REQUIRE(slots.slotsFree(ot_sine) == n_scenes * n_oscs * MAX_VOICES);
+    REQUIRE(slots.slotsFree(ot_classic) == 0);
+
+    auto misses = slots.slotMisses();
+
+    auto settle = [&]() {
+        for (int i = 0; i < 10 * 44100 / BLOCK_SIZE; ++i)
+            surge->process();
+    };
+
+    for (int k = 0; k < 4; ++k)
+        surge->playNote(0, 60 + k, 100, 0);
+    surge->process();
+    REQUIRE(slots.slotsInUse(ot_sine) == 4 * n_oscs);
+    REQUIRE(slots.slotsFree(ot_sine) == n_scenes * n_oscs * MAX_VOICES - 4 * n_oscs);
+
+    SECTION("Slots go back when the voices end")
+    {
+        for (int k = 0; k < 4; ++k)
+            surge->releaseNote(0, 60 + k, 0);
+        settle();
+        REQUIRE(surge->voices[0].empty());
+        REQUIRE(slots.slotsInUse(ot_sine) == 0);
+        REQUIRE(slots.slotsFree(ot_sine) == n_scenes * n_oscs * MAX_VOICES);
+    }
+
+    SECTION("Raising the polyphony never runs short")
+    {
+        auto bytes = slots.bytesAllocated();
+
+        patch.polylimit.val.i = MAX_VOICES;
+        for (int k = 0; k < MAX_VOICES; ++k)
+            surge->playNote(0, 20 + k, 100, 0);
+        surge->process();
+
+        REQUIRE(surge->voices[0].size() > 8);
+        REQUIRE(slots.slotsInUse(ot_sine) == surge->voices[0].size() * n_oscs);
+        REQUIRE(slots.slotMisses() == misses);
+
+        // and the voices never allocate
+        REQUIRE(slots.bytesAllocated() == bytes);
+    }
+
+    SECTION("Changing type sizes the new type before the voices take it")
+    {
+        sc.osc[0].queue_type = ot_classic;
+        surge->process();
+        REQUIRE(slots.slotsInUse(ot_sine) == 4 * (n_oscs - 1));
+        REQUIRE(slots.slotsInUse(ot_classic) == 4);
+        REQUIRE(slots.slotsFree(ot_classic) == MAX_VOICES - 4);
+        REQUIRE(slots.slotMisses() == misses);
+
+        surge->allNotesOff();
+        settle();
+        REQUIRE(slots.slotsInUse(ot_sine) == 0);
+        REQUIRE(slots.slotsInUse(ot_classic) == 0);
+    }
+
+    SECTION("A type written without a queue is picked up a block later")
+    {
+        using pool_t = Surge::Memory::OscillatorSlotPool;
+        int big = 0;
+        for (int t = 0; t < n_osc_types; ++t)
+            if (pool_t::slotSize(t) > pool_t::slotSize(big))
+                big = t;
+        REQUIRE(pool_t::slotSize(ot_sine) < pool_t::slotSize(big));
+
+        // As a paste does. The sine slots are too small, so the voices miss once
+        sc.osc[0].type.val.i = big;
+        surge->switch_toggled_queued = true;
+        surge->process();
+        REQUIRE(slots.slotsInUse(big) == 0);
+        REQUIRE(slots.slotMisses() == misses + 4);
+
+        surge->process();
+        REQUIRE(slots.slotsInUse(big) == 4);
+        REQUIRE(slots.slotsFree(big) == MAX_VOICES - 4);
+        REQUIRE(slots.slotsInUse(ot_sine) == 4 * (n_oscs - 1));
+        REQUIRE(slots.slotMisses() == misses + 4);
+    }
+}
+
+TEST_CASE("Voice Start Budget Spreads A Chord", "[voice]")
+{
+    auto surge = Surge::Headless::createSurge(44100);
+    REQUIRE(surge);
+
+    auto &st = surge->voiceStartStats;
+    int chord = 8;
+
+    SECTION("No Budget Starts Everything At Once")
+    {
+        for (int k = 0; k < chord; ++k)
+            surge->playNote(0, 60 + k, 100, 0);
+
+        REQUIRE(surge->voices[0].size() == chord);
+        REQUIRE(st.notes == chord);
+        REQUIRE(st.deferred == 0);
+        REQUIRE(st.totalNs > 0);
+    }
+
+    SECTION("A Tiny Budget Starts One Voice A Block")
+    {
+        // Any voice start spends a nanosecond
+        surge->storage.voiceStartBudgetNs = 1;
+
+        for (int k = 0; k < chord; ++k)
+            surge->playNote(0, 60 + k, 100, 0);
+
+        REQUIRE(surge->voices[0].size() == 1);
+        REQUIRE(surge->deferredNoteCount == chord - 1);
+
+        // Let go of the last key before it has started
+        surge->releaseNote(0, 60 + chord - 1, 0);
+
+        for (int b = 1; b < chord; ++b)
+        {
+            surge->process();
+            REQUIRE(surge->voices[0].size() == b + 1);
+        }
+
+        REQUIRE(surge->deferredNoteCount == 0);
+        REQUIRE(st.notes == chord);
+        REQUIRE(st.deferred == chord - 1);
+        REQUIRE(surge->getNonReleasedVoices(0) == chord - 1);
+    }
+
+    SECTION("Choking A Waiting Note Drops It")
+    {
+        surge->storage.voiceStartBudgetNs = 1;
+
+        surge->playNote(0, 60, 100, 0);
+        surge->playNote(0, 64, 100, 0);
+        surge->chokeNote(0, 64, 0);
+
+        REQUIRE(surge->deferredNoteCount == 0);
+        surge->process();
+        REQUIRE(surge->voices[0].size() == 1);
+    }
+
+    SECTION("Dropped Waiting Notes Are Reported As Ended")
+    {
+        surge->storage.voiceStartBudgetNs = 1;
+
+        surge->playNote(0, 60, 100, 0, 1);
+        surge->playNote(0, 62, 100, 0, 2);
+        surge->playNote(0, 64, 100, 0, 3);
+        surge->playNote(0, 67, 100, 0, -1);
+        REQUIRE(surge->deferredNoteCount == 3);
+
+        auto ended = surge->hostNoteEndedDuringBlockCount;
+        surge->chokeNote(0, 62, 0, 2);
+        REQUIRE(surge->hostNoteEndedDuringBlockCount == ended + 1);
+        REQUIRE(surge->endedHostNoteIds[ended] == 2);
+
+        // The waiting note without an id has nothing to report
+        surge->allNotesOff();
+        REQUIRE(surge->deferredNoteCount == 0);
+        REQUIRE(surge->hostNoteEndedDuringBlockCount >= ended + 2);
+
+        bool sawThree = false;
+        for (int i = ended + 1; i < surge->hostNoteEndedDuringBlockCount; ++i)
+            sawThree = sawThree || surge->endedHostNoteIds[i] == 3;
+        REQUIRE(sawThree);
+    }
+
+    SECTION("Learning A Split Point Does Not Wait")
+    {
+        surge->storage.voiceStartBudgetNs = 1;
+        auto &patch = surge->storage.getPatch();
+        patch.scenemode.val.i = sm_split;
+
+        surge->playNote(0, 60, 100, 0);
+        surge->learn_param_from_note = patch.splitpoint.id;
+        surge->playNote(0, 72, 100, 0);
+
+        REQUIRE(surge->deferredNoteCount == 0);
+        REQUIRE(surge->learn_param_from_note == -1);
+        REQUIRE(patch.splitpoint.val.i == 72);
+    }
+}
@@ -69,6 +69,13 @@ int main(int argc, char **argv)
             Surge::Headless::NonTest::filterAnalyzer(std::atoi(argv[3]), std::atoi(argv[4]),
                                                      std::cout);
         }
+        if (strcmp(argv[2], "--benchmark-suite") == 0)
+        {
+            auto ok = Surge::Headless::NonTest::benchmarkSuite(
+                argc > 3 ? argv[3] : "", argc > 4 ? argv[4] : "",
+                argc > 5 ? std::atof(argv[5]) : 10.0);
+            return ok ? 0 : 1;
+        }
         if (strcmp(argv[2], "--performance") == 0)
         {
             Surge::Headless::NonTest::performancePlay(argv[3], std::atoi(argv[4]));
@@ -87,6 +94,11 @@ int main(int argc, char **argv)
                 << "   --non-test --stats-from-every-patch    # play every patch and show RMS\n"
                 << "   --non-test --filter-analyzer ft fst    # analyze filter type/subtype for "
                    "response\n"
+                << "   --non-test --benchmark-suite [results.csv] [baseline.csv] [tolerance %]\n"
+                << "                                          # time the fixed CPU regression "
+                   "scenarios and compare\n"
+                << "                                          # medians with an earlier "
+                   "results file\n"
                 << "\n"
                 << "If you exclude the `--non-test` argument, standard catch2 arguments, below, "
                    "apply\n\n";
@@ -307,7 +307,7 @@ void SurgeSynthProcessor::patch_load_to_OSC(fs::path fullPath)
         juce::OSCMessage om =
             juce::OSCMessage(juce::OSCAddressPattern(juce::String("/patch/load")));
         om.addString(pathStr);
-        oscHandler.send(om, true);
+        oscHandler.send(om);
     }
 }
 
@@ -326,7 +326,7 @@ void SurgeSynthProcessor::param_change_to_OSC(std::string paramPath, int numval,
         if (numval > 2)
             om.addFloat32(val2);
         om.addString(valStr);
-        oscHandler.send(om, true);
+        oscHandler.sendValue(om);
     }
 }
 
@@ -487,6 +487,20 @@ void SurgeSynthProcessor::prepareToPlay(double sr, int samplesPerBlock)
         return;
     }
 
+    if (sr != surge->storage.samplerate)
+    {
+        /*
+         * Scheduled OSC sample times are in the old rate's timeline. The host isn't processing
+         * while it prepares us, so restart the timeline, let anything still waiting play in the
+         * first block, and don't place new bundles until the audio thread publishes a clock.
+         */
+        samplesProcessed = 0;
+        oscClockSample = 0;
+        oscClockMillis = 0.0;
+        for (int i = 0; i < oscScheduledCount; ++i)
+            oscScheduled[i].sampleTime = 0;
+    }
+
     surge->setSamplerate(sr);
     oscCheckStartup = true;
 
@@ -682,6 +696,7 @@ void SurgeSynthProcessor::processBlock(juce::AudioBuffer<float> &buffer,
 
         if (blockPos == 0)
         {
+            processBlockScheduledOSC(samplesProcessed + i);
             surge->process();
             surge->time_data.ppqPos +=
                 (double)BLOCK_SIZE * surge->time_data.tempo / (60. * surge->storage.samplerate);
@@ -733,6 +748,8 @@ void SurgeSynthProcessor::processBlock(juce::AudioBuffer<float> &buffer,
         midiIt++;
     }
 
+    samplesProcessed += buffer.getNumSamples();
+
     processBlockPostFunction();
 }
 
@@ -807,232 +824,308 @@ void SurgeSynthProcessor::processBlockMidiFromGUI()
 
 void SurgeSynthProcessor::processBlockOSC()
 {
+    if (surge->audio_processing_active)
+    {
+        // Publish the clock reference which oscSampleTimeFor uses to place timetagged bundles
+        oscClockSample = samplesProcessed;
+        oscClockMillis = juce::Time::getMillisecondCounterHiRes();
+    }
+
     while (true)
     {
         auto om = oscRingBuf.pop();
         if (!om.has_value())
             break; // no data waiting; return
-        switch (om->type)
+
+        if (!om->scheduled || !surge->audio_processing_active)
         {
-        case SurgeSynthProcessor::MNOTE:
+            applyOSCToAudio(*om);
+            continue;
+        }
+
+        if (om->sampleTime < samplesProcessed)
         {
-            if (om->on)
-                surge->playNote(0, om->char0, om->char1, 0, om->noteid);
-            else
-                surge->releaseNoteByHostNoteID(om->noteid, om->char1);
+            oscEventsLate++;
+            applyOSCToAudio(*om);
+            continue;
         }
-        break;
 
-        case SurgeSynthProcessor::FREQNOTE:
+        if (oscScheduledCount == oscScheduledCapacity)
         {
-            if (om->on)
-                surge->playNoteByFrequency(om->fval, om->char1, om->noteid);
-            else
-            {
-                surge->releaseNoteByHostNoteID(om->noteid, om->char1);
-            }
+            oscEventsOverflowed++;
+            applyOSCToAudio(*om);
+            continue;
+        }
+
+        // Insert keeping the queue sorted; equal times keep arrival order
+        int pos = oscScheduledCount;
+        while (pos > 0 && oscScheduled[pos - 1].sampleTime > om->sampleTime)
+        {
+            oscScheduled[pos] = oscScheduled[pos - 1];
+            pos--;
+        }
+        oscScheduled[pos] = *om;
+        oscScheduledCount++;
+        oscEventsScheduled++;
+    }
+}
+
+void SurgeSynthProcessor::processBlockScheduledOSC(int64_t untilSample)
+{
+    int applied = 0;
+    while (applied < oscScheduledCount && oscScheduled[applied].sampleTime <= untilSample)
+    {
+        applyOSCToAudio(oscScheduled[applied]);
+        applied++;
+    }
+
+    if (applied > 0)
+    {
+        std::move(oscScheduled.begin() + applied, oscScheduled.begin() + oscScheduledCount,
+                  oscScheduled.begin());
+        oscScheduledCount -= applied;
+    }
+}
+
+std::optional<int64_t> SurgeSynthProcessor::oscSampleTimeFor(const juce::OSCTimeTag &tt) const
+{
+    auto refMillis = oscClockMillis.load();
+
+    if (tt.isImmediately() || refMillis <= 0.0)
+    {
+        return std::nullopt;
+    }
+
+    // Timetags are wall clock; convert to the hi-res counter the audio thread publishes
+    auto aheadMillis = (double)(tt.toTime().toMilliseconds() - juce::Time::currentTimeMillis());
+    auto targetMillis = juce::Time::getMillisecondCounterHiRes() + aheadMillis +
+                        surge->storage.oscSchedulingLatencyMs;
+
+    return oscClockSample.load() +
+           (int64_t)((targetMillis - refMillis) * surge->storage.samplerate * 0.001);
+}
+
+void SurgeSynthProcessor::applyOSCToAudio(oscToAudio &om)
+{
+    switch (om.type)
+    {
+    case SurgeSynthProcessor::MNOTE:
+    {
+        if (om.on)
+            surge->playNote(0, om.char0, om.char1, 0, om.noteid);
+        else
+            surge->releaseNoteByHostNoteID(om.noteid, om.char1);
+    }
+    break;
+
+    case SurgeSynthProcessor::FREQNOTE:
+    {
+        if (om.on)
+            surge->playNoteByFrequency(om.fval, om.char1, om.noteid);
+        else
+        {
+            surge->releaseNoteByHostNoteID(om.noteid, om.char1);
         }
+    }
+    break;
+
+    case SurgeSynthProcessor::NOTEX_PITCH:
+        surge->setNoteExpression(SurgeVoice::PITCH, om.noteid, -1, -1, om.fval);
         break;
 
-        case SurgeSynthProcessor::NOTEX_PITCH:
-            surge->setNoteExpression(SurgeVoice::PITCH, om->noteid, -1, -1, om->fval);
-            break;
+    case SurgeSynthProcessor::NOTEX_VOL:
+        surge->setNoteExpression(SurgeVoice::VOLUME, om.noteid, -1, -1, om.fval);
+        break;
 
-        case SurgeSynthProcessor::NOTEX_VOL:
-            surge->setNoteExpression(SurgeVoice::VOLUME, om->noteid, -1, -1, om->fval);
-            break;
+    case SurgeSynthProcessor::NOTEX_PAN:
+        surge->setNoteExpression(SurgeVoice::PAN, om.noteid, -1, -1, om.fval);
+        break;
 
-        case SurgeSynthProcessor::NOTEX_PAN:
-            surge->setNoteExpression(SurgeVoice::PAN, om->noteid, -1, -1, om->fval);
-            break;
+    case SurgeSynthProcessor::NOTEX_PRES:
+        surge->setNoteExpression(SurgeVoice::PRESSURE, om.noteid, -1, -1, om.fval);
+        break;
 
-        case SurgeSynthProcessor::NOTEX_PRES:
-            surge->setNoteExpression(SurgeVoice::PRESSURE, om->noteid, -1, -1, om->fval);
-            break;
+    case SurgeSynthProcessor::NOTEX_TIMB:
+        surge->setNoteExpression(SurgeVoice::TIMBRE, om.noteid, -1, -1, om.fval);
+        break;
 
-        case SurgeSynthProcessor::NOTEX_TIMB:
-            surge->setNoteExpression(SurgeVoice::TIMBRE, om->noteid, -1, -1, om->fval);
-            break;
+    case SurgeSynthProcessor::PITCHBEND:
+        surge->pitchBend(om.char0, om.ival);
+        break;
 
-        case SurgeSynthProcessor::PITCHBEND:
-            surge->pitchBend(om->char0, om->ival);
-            break;
+    case SurgeSynthProcessor::CC:
+        surge->channelController(om.char0, om.char1, om.ival);
+        break;
 
-        case SurgeSynthProcessor::CC:
-            surge->channelController(om->char0, om->char1, om->ival);
-            break;
+    case SurgeSynthProcessor::CHAN_ATOUCH:
+        surge->channelAftertouch(om.char0, om.ival);
+        break;
 
-        case SurgeSynthProcessor::CHAN_ATOUCH:
-            surge->channelAftertouch(om->char0, om->ival);
-            break;
+    case SurgeSynthProcessor::POLY_ATOUCH:
+        surge->polyAftertouch(om.char0, (int)om.char1, om.ival);
+        break;
 
-        case SurgeSynthProcessor::POLY_ATOUCH:
-            surge->polyAftertouch(om->char0, (int)om->char1, om->ival);
-            break;
+    case SurgeSynthProcessor::PARAMETER:
+    {
+        float pval = om.fval;
+        if (om.param->valtype == vt_int)
+            pval = Parameter::intScaledToFloat(om.fval, om.param->val_max.i, om.param->val_min.i);
+
+        surge->setParameter01(surge->idForParameter(om.param), pval, true);
+        surge->storage.getPatch().isDirty = true;
+
+        // Special cases: A few control types require a rebuild and
+        // SGE Value Callbacks would do it as would the VST3 param handler
+        // so put them here for now. Bit of a hack...
+        auto ct = om.param->ctrltype;
+        if (ct == ct_bool_solo || ct == ct_bool_mute || ct == ct_scenesel)
+            surge->refresh_editor = true;
+        else
+            surge->queueForRefresh(om.param->id);
+    }
+    break;
+
+    case SurgeSynthProcessor::MACRO:
+    {
+        surge->setMacroParameter01(om.ival, om.fval);
+    }
+    break;
+
+    case SurgeSynthProcessor::ALLNOTESOFF:
+    {
+        surge->allNotesOff();
+    }
+    break;
+
+    case SurgeSynthProcessor::ALLSOUNDOFF:
+    {
+        surge->allSoundOff();
+    }
+    break;
+
+    case SurgeSynthProcessor::MOD:
+    {
+        surge->setModDepth01(om.param->id, (modsources)om.ival, om.scene, om.index, om.fval);
+    }
+    break;
+
+    case SurgeSynthProcessor::MOD_MUTE:
+    {
+        bool mute = om.fval > 0.0;
+        surge->muteModulation(om.param->id, (modsources)om.ival, om.scene, om.index, mute);
+    }
+    break;
 
-        case SurgeSynthProcessor::PARAMETER:
+    case SurgeSynthProcessor::FX_DISABLE:
+    {
+        int selected_mask = om.ival;
+        int curmask = surge->storage.getPatch().fx_disable.val.i;
+        int msk = selected_mask;
+        int newDisabledMask = 0;
+        if (om.on == 0) // set selected bit to zero
         {
-            float pval = om->fval;
-            if (om->param->valtype == vt_int)
-                pval = Parameter::intScaledToFloat(om->fval, om->param->val_max.i,
-                                                   om->param->val_min.i);
+            msk = ~(msk & 0) ^ selected_mask; // all bits to 1 except selected bit
+            newDisabledMask = curmask & msk;
+        }
+        else // set selected bit to one
+            newDisabledMask = curmask | msk;
 
-            surge->setParameter01(surge->idForParameter(om->param), pval, true);
-            surge->storage.getPatch().isDirty = true;
+        surge->storage.getPatch().fx_disable.val.i = newDisabledMask;
+        surge->storage.getPatch().markParameterChanged(surge->storage.getPatch().fx_disable.id);
+        surge->fx_suspend_bitmask = newDisabledMask;
+        surge->storage.getPatch().isDirty = true;
+        surge->refresh_editor = true;
+    }
+    break;
 
-            // Special cases: A few control types require a rebuild and
-            // SGE Value Callbacks would do it as would the VST3 param handler
-            // so put them here for now. Bit of a hack...
-            auto ct = om->param->ctrltype;
-            if (ct == ct_bool_solo || ct == ct_bool_mute || ct == ct_scenesel)
-                surge->refresh_editor = true;
-            else
-                surge->queueForRefresh(om->param->id);
+    case SurgeSynthProcessor::ABSOLUTE_X:
+        if (om.param->absolute != (bool)om.on)
+        {
+            om.param->absolute = om.on;
+            surge->storage.getPatch().isDirty = true;
+            surge->queueForRefresh(om.param->id);
         }
         break;
 
-        case SurgeSynthProcessor::MACRO:
+    case SurgeSynthProcessor::TEMPOSYNC_X:
+        if (om.param->temposync != (bool)om.on)
         {
-            surge->setMacroParameter01(om->ival, om->fval);
+            om.param->temposync = om.on;
+            surge->storage.getPatch().isDirty = true;
+            surge->queueForRefresh(om.param->id);
         }
         break;
 
-        case SurgeSynthProcessor::ALLNOTESOFF:
+    case SurgeSynthProcessor::ENABLE_X:
+    {
+        // This parameter is stored as 'disabled', but UI uses 'enabled',
+        //  so logic is flipped here:
+        bool disabled = !om.on;
+        if (om.param->deactivated != disabled)
         {
-            surge->allNotesOff();
+            om.param->deactivated = disabled;
+            surge->storage.getPatch().isDirty = true;
+            surge->queueForRefresh(om.param->id);
         }
-        break;
+    }
+    break;
 
-        case SurgeSynthProcessor::ALLSOUNDOFF:
+    case SurgeSynthProcessor::EXTEND_X:
+        if (om.param->extend_range != om.on)
         {
-            surge->allSoundOff();
+            om.param->extend_range = om.on;
+            surge->storage.getPatch().isDirty = true;
+            surge->queueForRefresh(om.param->id);
         }
         break;
 
-        case SurgeSynthProcessor::MOD:
+    case SurgeSynthProcessor::DEFORM_X:
+        if (om.param->deform_type != om.ival)
         {
-            surge->setModDepth01(om->param->id, (modsources)om->ival, om->scene, om->index,
-                                 om->fval);
+            om.param->deform_type = om.ival;
+            surge->storage.getPatch().isDirty = true;
+            surge->queueForRefresh(om.param->id);
         }
         break;
 
-        case SurgeSynthProcessor::MOD_MUTE:
+    case SurgeSynthProcessor::PORTA_CONSTRATE_X:
+        if (om.param->porta_constrate != om.on)
         {
-            bool mute = om->fval > 0.0;
-            surge->muteModulation(om->param->id, (modsources)om->ival, om->scene, om->index, mute);
+            om.param->porta_constrate = om.on;
+            surge->storage.getPatch().isDirty = true;
+            surge->queueForRefresh(om.param->id);
         }
         break;
 
-        case SurgeSynthProcessor::FX_DISABLE:
+    case SurgeSynthProcessor::PORTA_GLISS_X:
+        if (om.param->porta_gliss != om.on)
         {
-            int selected_mask = om->ival;
-            int curmask = surge->storage.getPatch().fx_disable.val.i;
-            int msk = selected_mask;
-            int newDisabledMask = 0;
-            if (om->on == 0) // set selected bit to zero
-            {
-                msk = ~(msk & 0) ^ selected_mask; // all bits to 1 except selected bit
-                newDisabledMask = curmask & msk;
-            }
-            else // set selected bit to one
-                newDisabledMask = curmask | msk;
-
-            surge->storage.getPatch().fx_disable.val.i = newDisabledMask;
-            surge->fx_suspend_bitmask = newDisabledMask;
+            om.param->porta_gliss = om.on;
             surge->storage.getPatch().isDirty = true;
-            surge->refresh_editor = true;
+            surge->queueForRefresh(om.param->id);
         }
         break;
 
-        case SurgeSynthProcessor::ABSOLUTE_X:
-            if (om->param->absolute != (bool)om->on)
-            {
-                om->param->absolute = om->on;
-                surge->storage.getPatch().isDirty = true;
-                surge->queueForRefresh(om->param->id);
-            }
-            break;
-
-        case SurgeSynthProcessor::TEMPOSYNC_X:
-            if (om->param->temposync != (bool)om->on)
-            {
-                om->param->temposync = om->on;
-                surge->storage.getPatch().isDirty = true;
-                surge->queueForRefresh(om->param->id);
-            }
-            break;
-
-        case SurgeSynthProcessor::ENABLE_X:
+    case SurgeSynthProcessor::PORTA_RETRIGGER_X:
+        if (om.param->porta_retrigger != om.on)
         {
-            // This parameter is stored as 'disabled', but UI uses 'enabled',
-            //  so logic is flipped here:
-            bool disabled = !om->on;
-            if (om->param->deactivated != disabled)
-            {
-                om->param->deactivated = disabled;
-                surge->storage.getPatch().isDirty = true;
-                surge->queueForRefresh(om->param->id);
-            }
+            om.param->porta_retrigger = om.on;
+            surge->storage.getPatch().isDirty = true;
+            surge->queueForRefresh(om.param->id);
         }
         break;
 
-        case SurgeSynthProcessor::EXTEND_X:
-            if (om->param->extend_range != om->on)
-            {
-                om->param->extend_range = om->on;
-                surge->storage.getPatch().isDirty = true;
-                surge->queueForRefresh(om->param->id);
-            }
-            break;
-
-        case SurgeSynthProcessor::DEFORM_X:
-            if (om->param->deform_type != om->ival)
-            {
-                om->param->deform_type = om->ival;
-                surge->storage.getPatch().isDirty = true;
-                surge->queueForRefresh(om->param->id);
-            }
-            break;
-
-        case SurgeSynthProcessor::PORTA_CONSTRATE_X:
-            if (om->param->porta_constrate != om->on)
-            {
-                om->param->porta_constrate = om->on;
-                surge->storage.getPatch().isDirty = true;
-                surge->queueForRefresh(om->param->id);
-            }
-            break;
-
-        case SurgeSynthProcessor::PORTA_GLISS_X:
-            if (om->param->porta_gliss != om->on)
-            {
-                om->param->porta_gliss = om->on;
-                surge->storage.getPatch().isDirty = true;
-                surge->queueForRefresh(om->param->id);
-            }
-            break;
-
-        case SurgeSynthProcessor::PORTA_RETRIGGER_X:
-            if (om->param->porta_retrigger != om->on)
-            {
-                om->param->porta_retrigger = om->on;
-                surge->storage.getPatch().isDirty = true;
-                surge->queueForRefresh(om->param->id);
-            }
-            break;
-
-        case SurgeSynthProcessor::PORTA_CURVE_X:
-            if (om->param->porta_curve != om->ival)
-            {
-                om->param->porta_curve = om->ival;
-                surge->storage.getPatch().isDirty = true;
-                surge->queueForRefresh(om->param->id);
-            }
-            break;
-
-        default:
-            break;
+    case SurgeSynthProcessor::PORTA_CURVE_X:
+        if (om.param->porta_curve != om.ival)
+        {
+            om.param->porta_curve = om.ival;
+            surge->storage.getPatch().isDirty = true;
+            surge->queueForRefresh(om.param->id);
         }
+        break;
+
+    default:
+        break;
     }
 }
 
@@ -1129,7 +1222,15 @@ clap_process_status SurgeSynthProcessor::clap_direct_process(const clap_process
             {
                 auto evt = ev->get(ev, currev);
 
-                process_clap_event(evt);
+                if (surge->storage.blockEndAutomation && evt->type == CLAP_EVENT_PARAM_VALUE &&
+                    evt->space_id == CLAP_CORE_EVENT_SPACE_ID)
+                {
+                    process_clap_param_at_block_end(ev, currev, evtsz, s + BLOCK_SIZE);
+                }
+                else
+                {
+                    process_clap_event(evt);
+                }
 
                 currev++;
                 if (currev < evtsz)
@@ -1145,6 +1246,8 @@ clap_process_status SurgeSynthProcessor::clap_direct_process(const clap_process
 
         if (blockPos == 0)
         {
+            processBlockScheduledOSC(samplesProcessed + s);
+
             if (inL && inR)
             {
                 memcpy(&(surge->input[0][0]), inL, BLOCK_SIZE * sizeof(float));
@@ -1209,6 +1312,8 @@ clap_process_status SurgeSynthProcessor::clap_direct_process(const clap_process
         currev++;
     }
 
+    samplesProcessed += process->frames_count;
+
     processBlockPostFunction();
     return CLAP_PROCESS_CONTINUE;
 }
@@ -1239,6 +1344,69 @@ void SurgeSynthProcessor::clap_direct_paramsFlush(const clap_input_events *in,
     }
 }
 
+/*
+ * Surge smooths parameter changes across each block, arriving at the new value at the end of the
+ * block. When the host automates a parameter with a stream of timed events, setting it to its
+ * last value in the block lags the automation line by up to a block. Instead, if the event is
+ * followed by one for the same parameter in the next block, set the value where the line
+ * between the two crosses the end of this block, so the smoothers land on the host's curve at
+ * every block boundary. A lone event is applied as is, and with no events nothing changes.
+ *
+ * This is not sample accurate. Between block ends the smoothers still follow a straight line,
+ * so a bend in the host's curve inside a block is cut off, and a lone event still lands at the
+ * end of its block, however early in the block it was sent.
+ *
+ * Only continuous parameters get a value in between. Integer, boolean and discrete float
+ * parameters (types, modes, switches) take exactly the values the host sends, when it sends
+ * them, through process_clap_event.
+ */
+void SurgeSynthProcessor::process_clap_param_at_block_end(const clap_input_events *ev,
+                                                          uint32_t idx, uint32_t evtsz,
+                                                          int blockEnd)
+{
+    auto pevt = reinterpret_cast<const clap_event_param_value *>(ev->get(ev, idx));
+
+    auto jp = static_cast<JUCEParameterVariant *>(pevt->cookie);
+    if (!jp) // unlikely
+        jp = findParameterByParameterId(pevt->param_id);
+
+    // Macros are continuous, so only Surge parameters need checking
+    if (auto sp = dynamic_cast<SurgeParamToJuceParamAdapter *>(jp->processorParam))
+    {
+        if (sp->p->valtype != vt_float || sp->p->is_discrete_selection())
+        {
+            process_clap_event(&pevt->header);
+            return;
+        }
+    }
+
+    auto t0 = (int)pevt->header.time;
+    double value = pevt->value;
+
+    for (auto j = idx + 1; j < evtsz; ++j)
+    {
+        auto nevt = ev->get(ev, j);
+
+        if ((int)nevt->time >= blockEnd + BLOCK_SIZE)
+            break;
+
+        if ((int)nevt->time < blockEnd || nevt->space_id != CLAP_CORE_EVENT_SPACE_ID ||
+            nevt->type != CLAP_EVENT_PARAM_VALUE)
+            continue;
+
+        auto npv = reinterpret_cast<const clap_event_param_value *>(nevt);
+
+        if (npv->param_id != pevt->param_id)
+            continue;
+
+        auto t1 = (int)npv->header.time;
+        value += (npv->value - value) * (double)(blockEnd - t0) / (double)(t1 - t0);
+        break;
+    }
+
+    jp->processorParam->setValue((float)value);
+}
+
 void SurgeSynthProcessor::process_clap_event(const clap_event_header_t *evt)
 {
     if (evt->space_id != CLAP_CORE_EVENT_SPACE_ID)
@@ -35,6 +35,8 @@
 #include "clap-juce-extensions/clap-juce-extensions.h"
 #endif
 
+#include <array>
+#include <optional>
 #include <unordered_map>
 
 #if MAC
@@ -279,6 +281,7 @@ class SurgeSynthProcessor : public juce::AudioProcessor,
     void processBlockPlayhead();
     void processBlockMidiFromGUI();
     void processBlockOSC();
+    void processBlockScheduledOSC(int64_t untilSample);
     void processBlockPostFunction();
 
     void applyMidi(const juce::MidiMessageMetadata &);
@@ -357,6 +360,9 @@ class SurgeSynthProcessor : public juce::AudioProcessor,
         bool on{false};
         int32_t noteid{-1};
         int scene{0}, index{0};
+        // Absolute sample position (see samplesProcessed) at which to apply, if scheduled
+        bool scheduled{false};
+        int64_t sampleTime{0};
 
         oscToAudio() {}
         // Various OSC messages use different subsets of the following fields
@@ -370,6 +376,38 @@ class SurgeSynthProcessor : public juce::AudioProcessor,
         oscToAudio(Parameter *p, float f) : type(PARAMETER), param(p), fval(f) {}
     };
     sst::cpputils::SimpleRingBuffer<oscToAudio, 4096> oscRingBuf;
+    void queueOSCToAudio(oscToAudio om)
+    {
+        if (oscHandler.bundleSampleTime.has_value())
+        {
+            om.scheduled = true;
+            om.sampleTime = *oscHandler.bundleSampleTime;
+        }
+        oscRingBuf.push(om);
+    }
+    void applyOSCToAudio(oscToAudio &om);
+
+    /*
+     * Timetagged OSC bundles are converted to an absolute sample position using a clock
+     * reference published by the audio thread at the top of each host block. Events which
+     * are in the future wait in oscScheduled (sorted by sampleTime) and are applied at the
+     * first internal block boundary at or after that time, in the same way as incoming MIDI.
+     * A bundle tagged 'immediately', or which arrives before the audio thread has published a
+     * clock, has no sample time. A bundle tagged in the past gets one before samplesProcessed
+     * and is applied on arrival and counted as late.
+     */
+    std::optional<int64_t> oscSampleTimeFor(const juce::OSCTimeTag &tt) const;
+    int64_t samplesProcessed{0};
+    std::atomic<int64_t> oscClockSample{0};
+    std::atomic<double> oscClockMillis{0.0};
+
+    static constexpr int oscScheduledCapacity = 1024;
+    std::array<oscToAudio, oscScheduledCapacity> oscScheduled;
+    int oscScheduledCount{0};
+
+    // Counters for scheduled OSC; late events are applied immediately on arrival and
+    // overflowed events are applied immediately when oscScheduled is full
+    std::atomic<uint64_t> oscEventsScheduled{0}, oscEventsLate{0}, oscEventsOverflowed{0};
 
     Surge::OSC::OpenSoundControl oscHandler;
     std::atomic<bool> oscCheckStartup{false};
@@ -415,7 +453,8 @@ class SurgeSynthProcessor : public juce::AudioProcessor,
     // --- 'param change' listener(s) ----
     // Listeners are notified whenever a parameter finishes changing, along with the new value.
     // Listeners should do any significant work on their own thread; for example, the OSC
-    // paramChangeListener calls OSCSender::send(), which runs on a juce::MessageManager thread.
+    // paramChangeListener hands its message to the OSC output queue, which sends from its own
+    // thread.
     //
     // Be sure to delete any added listeners in the destructor of the class that added them.
     std::unordered_map<std::string,
@@ -473,6 +512,8 @@ class SurgeSynthProcessor : public juce::AudioProcessor,
     void clap_direct_paramsFlush(const clap_input_events * /*in*/,
                                  const clap_output_events * /*out*/) noexcept override;
     void process_clap_event(const clap_event_header_t *evt);
+    void process_clap_param_at_block_end(const clap_input_events *ev, uint32_t idx,
+                                         uint32_t evtsz, int blockEnd);
     bool supportsVoiceInfo() override { return true; }
     bool voiceInfoGet(clap_voice_info *info) override
     {
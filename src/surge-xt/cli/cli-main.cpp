@@ -208,6 +208,7 @@ struct SurgePlayback : juce::MidiInputCallback, juce::AudioIODeviceCallback
                     proc->applyMidi(midiBuffer[midiRP]);
                     midiRP = (midiRP + 1) & midiBufferSzMask;
                 }
+                proc->processBlockScheduledOSC(proc->samplesProcessed + i);
                 proc->surge->process();
 
                 pos = 0;
@@ -221,6 +222,8 @@ struct SurgePlayback : juce::MidiInputCallback, juce::AudioIODeviceCallback
             outputChannelData[1][i] = proc->surge->output[1][pos];
             pos++;
         }
+
+        proc->samplesProcessed += numSamples;
     }
 
     void audioDeviceStopped() override { proc->surge->audio_processing_active = false; }
@@ -309,6 +312,11 @@ int main(int argc, char **argv)
     std::string initPatch{};
     app.add_flag("--init-patch", initPatch, "Choose this file path as the initial patch.");
 
+    std::string decimationQuality{};
+    app.add_flag("--decimation-quality", decimationQuality,
+                 "Quality of the filters between the oversampled voice path and the output: "
+                 "'standard' (default) or 'eco', which uses less CPU.");
+
     bool noStdIn{false};
     app.add_flag("--no-stdin", noStdIn,
                  "Do not assume stdin and do not poll keyboard for quit or ctrl-d. Useful for "
@@ -330,6 +338,17 @@ int main(int argc, char **argv)
      * This is the default runloop. Basically this main thread acts as the message queue
      */
     auto engine = std::make_unique<SurgePlayback>();
+
+    if (decimationQuality == "eco")
+    {
+        engine->proc->surge->storage.decimationQuality = SurgeStorage::DECIMATION_ECO;
+        LOG(BASIC, "Decimation quality  : eco");
+    }
+    else if (!decimationQuality.empty() && decimationQuality != "standard")
+    {
+        PRINTERR("Unknown decimation quality '" << decimationQuality << "'; using standard");
+    }
+
     if (!initPatch.empty())
     {
         if (engine->proc->surge->loadPatchByPath(initPatch.c_str(), -1, "Loaded Patch"))
@@ -0,0 +1,124 @@
+/*
+ * Surge XT - a free and open source hybrid synthesizer,
+ * built by Surge Synth Team
+ *
+ * Learn more at https://surge-synthesizer.github.io/
+ *
+ * Copyright 2018-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * Surge XT is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Surge was a commercial product from 2004-2018, copyright and ownership
+ * held by Claes Johanson at Vember Audio during that period.
+ * Claes made Surge open source in September 2018.
+ *
+ * All source for Surge XT is available at
+ * https://github.com/surge-synthesizer/surge
+ */
+
+#ifndef SURGE_SRC_SURGE_XT_GUI_LATESTREQUESTWORKER_H
+#define SURGE_SRC_SURGE_XT_GUI_LATESTREQUESTWORKER_H
+
+#include "juce_gui_basics/juce_gui_basics.h"
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Surge
+{
+namespace GUI
+{
+/*
+ * Runs a slow evaluation for a display (filter response, LFO and oscillator previews) on its
+ * own thread. Only the most recent request matters, so a newer one replaces any still waiting,
+ * and the display is asked to repaint when a result is ready for it to take.
+ *
+ * The evaluation runs on the worker, so it must only use what it is handed in its inputs or
+ * what it captured itself.
+ */
+template <typename Inputs, typename Result> struct LatestRequestWorker
+{
+    using evaluate_t = std::function<std::unique_ptr<Result>(Inputs &)>;
+
+    LatestRequestWorker(juce::Component *toRepaint, evaluate_t evaluateFn)
+        : display(toRepaint), evaluate(std::move(evaluateFn))
+    {
+        workerThread = std::make_unique<std::thread>(callRunThread, this);
+    }
+
+    ~LatestRequestWorker()
+    {
+        {
+            auto lock = std::unique_lock<std::mutex>(dataLock);
+            continueWaiting = false;
+        }
+        cv.notify_one();
+        workerThread->join();
+    }
+
+    void request(std::unique_ptr<Inputs> in)
+    {
+        {
+            auto lock = std::unique_lock<std::mutex>(dataLock);
+            pending = std::move(in);
+        }
+        cv.notify_one();
+    }
+
+    // Returns the newest finished result once, or nullptr if nothing arrived since the last call
+    std::unique_ptr<Result> takeResult()
+    {
+        auto lock = std::unique_lock<std::mutex>(dataLock);
+        return std::move(result);
+    }
+
+  private:
+    static void callRunThread(LatestRequestWorker *that) { that->runThread(); }
+    void runThread()
+    {
+        while (true)
+        {
+            std::unique_ptr<Inputs> work;
+            {
+                auto lock = std::unique_lock<std::mutex>(dataLock);
+                cv.wait(lock, [this]() { return pending || !continueWaiting; });
+                if (!continueWaiting)
+                    return;
+                work = std::move(pending);
+            }
+
+            auto res = evaluate(*work);
+
+            {
+                auto lock = std::unique_lock<std::mutex>(dataLock);
+                result = std::move(res);
+
+                juce::MessageManager::getInstance()->callAsync(
+                    [safethat = juce::Component::SafePointer<juce::Component>(display)] {
+                        if (safethat)
+                            safethat->repaint();
+                    });
+            }
+        }
+    }
+
+    juce::Component *display;
+    evaluate_t evaluate;
+    std::unique_ptr<Inputs> pending;
+    std::unique_ptr<Result> result;
+    std::mutex dataLock;
+    std::condition_variable cv;
+    std::unique_ptr<std::thread> workerThread;
+    bool continueWaiting{true};
+};
+} // namespace GUI
+} // namespace Surge
+
+#endif // SURGE_SRC_SURGE_XT_GUI_LATESTREQUESTWORKER_H
@@ -926,6 +926,16 @@ void SurgeGUIEditor::idle()
             }
         }
 
+        if (effectChooser)
+        {
+            auto dm = (int)synth->fxDormantMask.load(std::memory_order_relaxed);
+            if (dm != effectChooser->getDormantBitmask())
+            {
+                effectChooser->setDormantBitmask(dm);
+                effectChooser->repaint();
+            }
+        }
+
         for (int i = 0; i < n_fx_slots; i++)
         {
             assert(i + 1 < Effect::KNumVuSlots);
@@ -1009,29 +1019,7 @@ void SurgeGUIEditor::idle()
 
         std::vector<int> refreshIndices;
 
-        if (synth->refresh_overflow)
-        {
-            refreshIndices.resize(n_total_params);
-            std::iota(std::begin(refreshIndices), std::end(refreshIndices), 0);
-            frame->repaint();
-        }
-        else
-        {
-            for (int i = 0; i < 8; ++i)
-            {
-                if (synth->refresh_parameter_queue[i] >= 0)
-                {
-                    refreshIndices.push_back(synth->refresh_parameter_queue[i]);
-                }
-            }
-        }
-
-        synth->refresh_overflow = false;
-
-        for (int i = 0; i < 8; ++i)
-        {
-            synth->refresh_parameter_queue[i] = -1;
-        }
+        synth->refreshParameterQueue.drain(refreshIndices);
 
         for (auto j : refreshIndices)
         {
@@ -1227,18 +1215,23 @@ void SurgeGUIEditor::idle()
 #endif
         }
 
-        for (int i = 0; i < n_customcontrollers; i++)
+        // Only follow macros the engine moved since we last looked, so a value the user is
+        // dragging right now isn't pulled back to one from a block ago
+        synth->getModulationSnapshot(modulationSnapshot);
+
+        if (modulationSnapshot.blockCount != lastModulationSnapshotBlock)
         {
-            if (((ControllerModulationSource *)synth->storage.getPatch()
-                     .scene[current_scene]
-                     .modsources[ms_ctrl1 + i])
-                    ->has_changed(0, true))
+            lastModulationSnapshotBlock = modulationSnapshot.blockCount;
+
+            for (int i = 0; i < n_customcontrollers; i++)
             {
-                gui_modsrc[ms_ctrl1 + i]->setValue(
-                    ((ControllerModulationSource *)synth->storage.getPatch()
-                         .scene[current_scene]
-                         .modsources[ms_ctrl1 + i])
-                        ->get_target01(0));
+                auto c = modulationSnapshot.macroChangeCount[i];
+
+                if (c != lastMacroChangeCount[i])
+                {
+                    lastMacroChangeCount[i] = c;
+                    gui_modsrc[ms_ctrl1 + i]->setValue(modulationSnapshot.macroTarget01[i]);
+                }
             }
         }
     }
@@ -2823,6 +2816,7 @@ void SurgeGUIEditor::applyToParamForUndo(int paramId, std::function<void(Paramet
 {
     auto p = synth->storage.getPatch().param_ptr[paramId];
     f(p);
+    synth->storage.getPatch().markParameterChanged(paramId);
     synth->refresh_editor = true;
 }
 
@@ -3415,11 +3409,10 @@ void SurgeGUIEditor::promptForUserValueEntry(Parameter *p, juce::Component *c, i
     {
         int detailedMode = Surge::Storage::getUserDefaultValue(
             &(this->synth->storage), Surge::Storage::HighPrecisionReadouts, 0);
-        auto cms = ((ControllerModulationSource *)synth->storage.getPatch()
-                        .scene[current_scene]
-                        .modsources[ms]);
+        synth->getModulationSnapshot(modulationSnapshot);
 
-        ptxt3 = fmt::format("{:.{}f} %", 100.0 * cms->get_output(0), (detailedMode ? 6 : 2));
+        ptxt3 = fmt::format("{:.{}f} %", 100.0 * modulationSnapshot.scene[0][ms][0],
+                            (detailedMode ? 6 : 2));
         strncpy(txt, ptxt3.c_str(), TXT_SIZE - 1);
         ptxt1 = fmt::format("current: {:s}", txt);
     }
@@ -272,6 +272,10 @@ class SurgeGUIEditor : public Surge::GUI::IComponentTagValue::Listener,
     double lastTempo = 0;
     int lastTSNum = 0, lastTSDen = 0;
     int lastOverlayRefresh = 0;
+    // Modulator state as of the last idle, see SurgeSynthesizer::getModulationSnapshot
+    SurgeSynthesizer::ModulationSnapshot modulationSnapshot;
+    uint64_t lastModulationSnapshotBlock{0};
+    std::array<uint32_t, n_customcontrollers> lastMacroChangeCount{};
     void adjustSize(float &width, float &height) const;
 
     void update_deform_type(Parameter *p, int type);
@@ -413,6 +413,7 @@ void SurgeGUIEditor::changeSelectedScene(int value)
 
     synth->release_if_latched[synth->storage.getPatch().scene_active.val.i] = true;
     synth->storage.getPatch().scene_active.val.i = current_scene;
+    synth->storage.getPatch().markParameterChanged(synth->storage.getPatch().scene_active.id);
 
     bool hasMSEG = isAnyOverlayPresent(MSEG_EDITOR);
     bool hasForm = isAnyOverlayPresent(FORMULA_EDITOR);
@@ -1231,15 +1232,14 @@ int32_t SurgeGUIEditor::controlModifierClicked(Surge::GUI::IComponentTagValue *c
 
                 createMIDILearnMenuEntries(contextMenu, macro_cc, ccid, control);
 
-                auto cms = ((ControllerModulationSource *)synth->storage.getPatch()
-                                .scene[current_scene]
-                                .modsources[modsource]);
+                // The engine is writing the live source, so show its value as of the last block
+                synth->getModulationSnapshot(modulationSnapshot);
 
                 contextMenu.addSeparator();
 
-                std::string vtxt =
-                    fmt::format("{:s}: {:.{}f} %", Surge::GUI::toOSCase("Edit Value"),
-                                100 * cms->get_output(0), (detailedMode ? 6 : 2));
+                std::string vtxt = fmt::format(
+                    "{:s}: {:.{}f} %", Surge::GUI::toOSCase("Edit Value"),
+                    100 * modulationSnapshot.scene[0][modsource][0], (detailedMode ? 6 : 2));
                 contextMenu.addItem(vtxt, [this, bvf, modsource]() {
                     promptForUserValueEntry(nullptr, bvf, modsource,
                                             0,  // controllers aren't per scene
@@ -1264,11 +1264,10 @@ int32_t SurgeGUIEditor::controlModifierClicked(Surge::GUI::IComponentTagValue *c
                             .modsources[ms_ctrl1 + ccid]
                             ->set_bipolar(bp);
 
-                        float f = synth->storage.getPatch()
-                                      .scene[current_scene]
-                                      .modsources[ms_ctrl1 + ccid]
-                                      ->get_output01(0);
-                        control->setValue(f);
+                        // get_output01 of the new mode, from the value as of the last block
+                        synth->getModulationSnapshot(modulationSnapshot);
+                        auto v = modulationSnapshot.scene[0][ms_ctrl1 + ccid][0];
+                        control->setValue(bp ? 0.5f + 0.5f * v : v);
 
                         synth->storage.getPatch().isDirty = true;
 
@@ -1517,6 +1516,7 @@ int32_t SurgeGUIEditor::controlModifierClicked(Surge::GUI::IComponentTagValue *c
                                         [p, i, this]() {
                                             p->val.f = (float)i;
                                             p->bound_value();
+                                            synth->storage.getPatch().markParameterChanged(p->id);
                                             synth->storage.getPatch().isDirty = true;
                                             synth->refresh_editor = true;
                                         });
@@ -1525,6 +1525,7 @@ int32_t SurgeGUIEditor::controlModifierClicked(Surge::GUI::IComponentTagValue *c
                                         [p, i, dotoff, this]() {
                                             p->val.f = (float)i + dotoff;
                                             p->bound_value();
+                                            synth->storage.getPatch().markParameterChanged(p->id);
                                             synth->storage.getPatch().isDirty = true;
                                             synth->refresh_editor = true;
                                         });
@@ -1533,6 +1534,7 @@ int32_t SurgeGUIEditor::controlModifierClicked(Surge::GUI::IComponentTagValue *c
                                         [p, i, tripoff, this]() {
                                             p->val.f = (float)i + tripoff;
                                             p->bound_value();
+                                            synth->storage.getPatch().markParameterChanged(p->id);
                                             synth->storage.getPatch().isDirty = true;
                                             synth->refresh_editor = true;
                                         });
@@ -1641,6 +1643,8 @@ int32_t SurgeGUIEditor::controlModifierClicked(Surge::GUI::IComponentTagValue *c
                                                     juceEditor->processor.paramChangeToListeners(p);
                                                 }
 
+                                                synth->storage.getPatch().markParameterChanged(
+                                                    p->id);
                                                 synth->storage.getPatch().isDirty = true;
                                                 synth->refresh_editor = true;
                                                 juceEditor->processor.paramChangeToListeners(
@@ -1974,6 +1978,7 @@ int32_t SurgeGUIEditor::controlModifierClicked(Surge::GUI::IComponentTagValue *c
                             {
                                 p->set_value_f01(control->getValue());
                             }
+                            synth->storage.getPatch().markParameterChanged(p->id);
 
                             if (lfoDisplay)
                                 lfoDisplay->repaint();
@@ -2049,6 +2054,7 @@ int32_t SurgeGUIEditor::controlModifierClicked(Surge::GUI::IComponentTagValue *c
                                     if (setTSTo)
                                     {
                                         pl->bound_value();
+                                        synth->storage.getPatch().markParameterChanged(pl->id);
                                     }
                                 }
                             }
@@ -2071,6 +2077,7 @@ int32_t SurgeGUIEditor::controlModifierClicked(Surge::GUI::IComponentTagValue *c
                                           .scene[current_scene]
                                           .keytrack_root.val.i;
                             p->set_value_f01(p->value_to_normalized(kr - 69));
+                            synth->storage.getPatch().markParameterChanged(p->id);
                             control->setValue(p->get_value_f01());
                             auto mci = dynamic_cast<Surge::Widgets::ModulatableControlInterface *>(
                                 control);
@@ -2685,6 +2692,7 @@ int32_t SurgeGUIEditor::controlModifierClicked(Surge::GUI::IComponentTagValue *c
                                 Surge::GUI::toOSCase(txt), enable, isChecked, [this, p]() {
                                     undoManager()->pushParameterChange(p->id, p, p->val);
                                     p->set_extend_range(!p->extend_range);
+                                    synth->storage.getPatch().markParameterChanged(p->id);
                                     synth->storage.getPatch().isDirty = true;
                                     synth->refresh_editor = true;
 
@@ -3258,6 +3266,7 @@ int32_t SurgeGUIEditor::controlModifierClicked(Surge::GUI::IComponentTagValue *c
                         p->set_value_f01(p->get_default_value_f01());
                         control->setValue(p->get_value_f01());
                     }
+                    synth->storage.getPatch().markParameterChanged(p->id);
 
                     if (bvf)
                     {
@@ -3271,6 +3280,7 @@ int32_t SurgeGUIEditor::controlModifierClicked(Surge::GUI::IComponentTagValue *c
                 default:
                 {
                     p->set_value_f01(p->get_default_value_f01());
+                    synth->storage.getPatch().markParameterChanged(p->id);
                     control->setValue(p->get_value_f01());
 
                     if (oscWaveform && (p->ctrlgroup == cg_OSC))
@@ -3312,6 +3322,7 @@ int32_t SurgeGUIEditor::controlModifierClicked(Surge::GUI::IComponentTagValue *c
                     else
                         curr->val.b = false;
 
+                    synth->storage.getPatch().markParameterChanged(curr->id);
                     curr++;
                 }
 
@@ -3332,6 +3343,7 @@ int32_t SurgeGUIEditor::controlModifierClicked(Surge::GUI::IComponentTagValue *c
                     else
                         curr->val.b = false;
 
+                    synth->storage.getPatch().markParameterChanged(curr->id);
                     curr++;
                 }
 
@@ -3341,6 +3353,7 @@ int32_t SurgeGUIEditor::controlModifierClicked(Surge::GUI::IComponentTagValue *c
             else
             {
                 p->bound_value();
+                synth->storage.getPatch().markParameterChanged(p->id);
             }
         }
     }
@@ -3664,6 +3677,8 @@ void SurgeGUIEditor::valueChanged(Surge::GUI::IComponentTagValue *control)
         if (a < 0)
             a = nn - 1;
         synth->storage.getPatch().scene[current_scene].filterunit[idx].subtype.val.i = a;
+        synth->storage.getPatch().markParameterChanged(
+            synth->storage.getPatch().scene[current_scene].filterunit[idx].subtype.id);
         synth->storage.subtypeMemory[current_scene][idx][t] = a;
         if (csc)
         {
@@ -3827,6 +3842,7 @@ void SurgeGUIEditor::valueChanged(Surge::GUI::IComponentTagValue *control)
         }
 
         synth->storage.getPatch().fx_disable.val.i = d;
+        synth->storage.getPatch().markParameterChanged(synth->storage.getPatch().fx_disable.id);
         fxc->setDeactivatedBitmask(d);
 
         int nfx = fxc->getCurrentEffect();
@@ -4144,6 +4160,8 @@ void SurgeGUIEditor::valueChanged(Surge::GUI::IComponentTagValue *control)
         if (a >= nn)
             a = 0;
         synth->storage.getPatch().scene[current_scene].filterunit[idx].subtype.val.i = a;
+        synth->storage.getPatch().markParameterChanged(
+            synth->storage.getPatch().scene[current_scene].filterunit[idx].subtype.id);
         if (!nn)
             ((Surge::Widgets::Switch *)filtersubtype[idx])->setIntegerValue(0);
         else
@@ -25,8 +25,8 @@
 #include "SkinColors.h"
 #include <fmt/core.h>
 #include "sst/filters/FilterPlotter.h"
-#include <thread>
 #include "Tunings.h"
+#include "LatestRequestWorker.h"
 #include "SurgeGUIEditorTags.h"
 
 static constexpr auto GRAPH_MIN_FREQ = 13.57f;
@@ -39,93 +39,45 @@ namespace Surge
 {
 namespace Overlays
 {
+struct FilterAnalysisInputs
+{
+    int type{0}, subtype{0};
+    float cutoff{60}, resonance{0}, gain{1.f};
+};
+
 struct FilterAnalysisEvaluator
+    : Surge::GUI::LatestRequestWorker<FilterAnalysisInputs, FilterAnalysis::Response>
 {
-    FilterAnalysis *an;
-    FilterAnalysisEvaluator(FilterAnalysis *a) : an(a)
+    FilterAnalysisEvaluator(FilterAnalysis *a)
+        : LatestRequestWorker(
+              a, [fp = std::make_shared<sst::filters::FilterPlotter>(15)](
+                     FilterAnalysisInputs &in) {
+                  auto par = sst::filters::FilterPlotParameters();
+                  par.inputAmplitude *= in.gain;
+                  return std::make_unique<FilterAnalysis::Response>(
+                      fp->plotFilterMagnitudeResponse((sst::filters::FilterType)in.type,
+                                                      (sst::filters::FilterSubType)in.subtype,
+                                                      in.cutoff, in.resonance, par));
+              })
     {
-        analysisThread = std::make_unique<std::thread>(callRunThread, this);
-    }
-    ~FilterAnalysisEvaluator()
-    {
-        {
-            auto lock = std::unique_lock<std::mutex>(dataLock);
-            continueWaiting = false;
-        }
-        cv.notify_one();
-        analysisThread->join();
-    }
-
-    static void callRunThread(FilterAnalysisEvaluator *that) { that->runThread(); }
-    void runThread()
-    {
-        uint64_t lastIB = 0;
-        auto fp = sst::filters::FilterPlotter(15);
-        while (continueWaiting)
-        {
-            if (lastIB == inboundUpdates)
-            {
-                auto lock = std::unique_lock<std::mutex>(dataLock);
-                cv.wait(lock);
-            }
-
-            if (lastIB != inboundUpdates)
-            {
-                int cty, csu;
-                float ccu, cre, cgn;
-                {
-                    auto lock = std::unique_lock<std::mutex>(dataLock);
-                    cty = type;
-                    csu = subtype;
-                    ccu = cutoff;
-                    cre = resonance;
-                    cgn = gain;
-                    lastIB = inboundUpdates;
-                }
-
-                auto par = sst::filters::FilterPlotParameters();
-                par.inputAmplitude *= cgn;
-                auto data = fp.plotFilterMagnitudeResponse(
-                    (sst::filters::FilterType)cty, (sst::filters::FilterSubType)csu, ccu, cre, par);
-
-                {
-                    auto lock = std::unique_lock<std::mutex>(dataLock);
-                    outboundUpdates++;
-                    dataCopy = data;
-
-                    juce::MessageManager::getInstance()->callAsync(
-                        [safethat = juce::Component::SafePointer(an)] {
-                            if (safethat)
-                                safethat->repaint();
-                        });
-                }
-            }
-        }
     }
 
     void request(int t, int s, float c, float r, float g)
     {
-        {
-            auto lock = std::unique_lock<std::mutex>(dataLock);
-
-            type = t;
-            subtype = s;
-            cutoff = c;
-            resonance = r;
-            gain = powf(2.f, g / 18.f);
-            inboundUpdates++;
-        }
-        cv.notify_one();
+        cutoff = c;
+        resonance = r;
+
+        auto in = std::make_unique<FilterAnalysisInputs>();
+        in->type = t;
+        in->subtype = s;
+        in->cutoff = c;
+        in->resonance = r;
+        in->gain = powf(2.f, g / 18.f);
+        LatestRequestWorker::request(std::move(in));
     }
 
-    std::pair<std::vector<float>, std::vector<float>> dataCopy;
-    std::atomic<uint64_t> inboundUpdates{1}, outboundUpdates{1};
-    int type{0}, subtype{0};
-    float cutoff{60}, resonance{0}, gain{1.f};
-    std::mutex dataLock;
-    std::condition_variable cv;
-    std::unique_ptr<std::thread> analysisThread;
-    bool hasWork{false}, continueWaiting{true};
+    // What was last asked for, which the ruler shows while the curve catches up
+    float cutoff{60}, resonance{0};
 };
 
 FilterAnalysis::FilterAnalysis(SurgeGUIEditor *e, SurgeStorage *s, SurgeSynthesizer *synth)
@@ -255,18 +207,18 @@ void FilterAnalysis::paint(juce::Graphics &g)
     }
 
     // construct filter response curve
-    if (catchUpStore != evaluator->outboundUpdates)
+    if (auto res = evaluator->takeResult())
     {
-        std::pair<std::vector<float>, std::vector<float>> data;
-        {
-            auto lock = std::unique_lock(evaluator->dataLock);
-            data = evaluator->dataCopy;
-            catchUpStore = evaluator->outboundUpdates;
-        }
+        response = std::move(*res);
+        pathIsStale = true;
+    }
 
+    if (pathIsStale)
+    {
+        pathIsStale = false;
         plotPath = juce::Path();
 
-        auto [freqAxis, magResponseDBSmoothed] = data;
+        auto &[freqAxis, magResponseDBSmoothed] = response;
         bool started = false;
         const auto nPoints = freqAxis.size();
 
@@ -438,7 +390,7 @@ void FilterAnalysis::resized()
     f1Button->setBounds(2, 2, 40, 15);
     f2Button->setBounds(w - 42, 2, 40, 15);
 
-    catchUpStore = evaluator->outboundUpdates - 1; // because we need to rebuild the path
+    pathIsStale = true;
 }
 
 void FilterAnalysis::mouseDrag(const juce::MouseEvent &event)
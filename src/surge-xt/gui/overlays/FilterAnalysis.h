@@ -97,7 +97,11 @@ struct FilterAnalysis : public OverlayComponent, Surge::GUI::SkinConsumingCompon
     std::unique_ptr<Surge::Widgets::SelfDrawToggleButton> f1Button, f2Button;
     std::unique_ptr<FilterAnalysisEvaluator> evaluator;
     bool shouldRepaintOnParamChange(const SurgePatch &patch, Parameter *p) override;
-    uint64_t catchUpStore{0};
+
+    // frequency axis and smoothed magnitude response in dB, as the evaluator last sent them
+    using Response = std::pair<std::vector<float>, std::vector<float>>;
+    Response response;
+    bool pathIsStale{true};
     juce::Path plotPath;
 };
 } // namespace Overlays
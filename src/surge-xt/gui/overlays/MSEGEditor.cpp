@@ -142,7 +142,7 @@ struct MSEGCanvas : public juce::Component, public Surge::GUI::SkinConsumingComp
         this->eds = eds;
         this->lfodata = lfodata;
         this->sge = sge;
-        Surge::MSEG::rebuildCache(ms);
+        Surge::MSEG::rebuildCache(ms, storage->msegBakedLookup);
         handleDrawable = b->getImage(IDB_MSEG_NODES);
         timeEditMode = (MSEGCanvas::TimeEdit)eds->timeEditMode;
         setOpaque(true);
@@ -2246,7 +2246,7 @@ struct MSEGCanvas : public juce::Component, public Surge::GUI::SkinConsumingComp
 
         if (gotOne)
         {
-            Surge::MSEG::rebuildCache(ms);
+            Surge::MSEG::rebuildCache(ms, storage->msegBakedLookup);
             recalcHotZones(where);
             if (draggingIdx >= 0)
                 hotzones[draggingIdx].dragging = true;
@@ -2781,7 +2781,7 @@ struct MSEGCanvas : public juce::Component, public Surge::GUI::SkinConsumingComp
         if (holdOffOnModelChanged)
             return;
 
-        Surge::MSEG::rebuildCache(ms);
+        Surge::MSEG::rebuildCache(ms, storage->msegBakedLookup);
         applyZoomPanConstraints(activeSegment, specialEndpoint);
         if (rchz)
             recalcHotZones(mouseDownOrigin); // FIXME
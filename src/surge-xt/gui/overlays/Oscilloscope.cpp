@@ -379,8 +379,7 @@ void WaveformDisplay::resized()
 SpectrumDisplay::SpectrumDisplay(SurgeGUIEditor *e, SurgeStorage *s)
     : editor_(e), storage_(s), last_updated_time_(std::chrono::steady_clock::now())
 {
-    std::fill(incoming_scope_data_.begin(), incoming_scope_data_.end(), 0.f);
-    std::fill(new_scope_data_.begin(), new_scope_data_.end(), -100.f);
+    resizeScopeData(params_.fftSize() / 2);
 }
 
 const SpectrumDisplay::Parameters &SpectrumDisplay::getParameters() const { return params_; }
@@ -392,7 +391,13 @@ void SpectrumDisplay::setParameters(Parameters parameters)
     // display "dirty" (ie, stop interpolating distance, jump right to the new thing).
     bool changedVisible =
         (params_.dbRange() != parameters.dbRange()) || (params_.freeze != parameters.freeze);
+    bool changedSize = params_.fft_order != parameters.fft_order;
     params_ = std::move(parameters);
+    if (changedSize)
+    {
+        resizeScopeData(params_.fftSize() / 2);
+        changedVisible = true;
+    }
     if (changedVisible)
     {
         display_dirty_ = true;
@@ -414,19 +419,48 @@ void SpectrumDisplay::paint(juce::Graphics &g)
 
     auto path = juce::Path();
     bool started = false;
-    float binHz = storage_->samplerate / static_cast<float>(internal::fftSize);
+    const int bins = static_cast<int>(new_scope_data_.size());
+    float binHz = storage_->samplerate / static_cast<float>(params_.fftSize());
     float dbMin = params_.noiseFloor();
     float dbMax = params_.maxDb();
     float zeroPoint = dbToY(dbMin, height, dbMin, dbMax);
     float maxPoint = dbToY(dbMax, height, dbMin, dbMax);
     auto now = std::chrono::steady_clock::now();
 
+    auto addPoint = [&](float x, float y) {
+        if (y >= zeroPoint)
+        {
+            path.lineTo(x, zeroPoint);
+            path.closeSubPath();
+            started = false;
+        }
+        else
+        {
+            if (started)
+            {
+                path.lineTo(x, y);
+            }
+            else
+            {
+                path.startNewSubPath(x, zeroPoint);
+                path.lineTo(x, y);
+                started = true;
+            }
+        }
+    };
+
     // Start path.
     path.startNewSubPath(freqToX(lowFreq, width), zeroPoint);
     {
-        mtbs_ = std::chrono::duration<float>(1.f / binHz);
+        // New data arrives once per hop, so that's the span we interpolate across.
+        mtbs_ = std::chrono::duration<float>(params_.hopSize() / storage_->samplerate);
+
+        // At large FFT sizes many bins land on the same pixel column up top, so we only add
+        // the peak of each column to the path. This keeps the path size bounded by the width.
+        int column = std::numeric_limits<int>::min();
+        float columnX = 0.f, columnY = 0.f;
 
-        for (int i = 0; i < internal::fftSize / 2; i++)
+        for (int i = 0; i < bins; i++)
         {
             const float hz = binHz * static_cast<float>(i);
 
@@ -442,25 +476,25 @@ void SpectrumDisplay::paint(juce::Graphics &g)
 
             displayed_data_[i] = y;
 
-            if (y >= zeroPoint)
+            if (static_cast<int>(x) == column)
             {
-                path.lineTo(x, zeroPoint);
-                path.closeSubPath();
-                started = false;
+                columnY = std::min(columnY, y);
+                continue;
             }
-            else
+
+            if (column != std::numeric_limits<int>::min())
             {
-                if (started)
-                {
-                    path.lineTo(x, y);
-                }
-                else
-                {
-                    path.startNewSubPath(x, zeroPoint);
-                    path.lineTo(x, y);
-                    started = true;
-                }
+                addPoint(columnX, columnY);
             }
+
+            column = static_cast<int>(x);
+            columnX = x;
+            columnY = y;
+        }
+
+        if (column != std::numeric_limits<int>::min())
+        {
+            addPoint(columnX, columnY);
         }
     }
     // End path.
@@ -482,7 +516,7 @@ void SpectrumDisplay::recalculateScopeData()
     // data_lock_ *must* be held by the caller.
     const float dbMin = params_.noiseFloor();
     const float dbMax = params_.maxDb();
-    const float offset = juce::Decibels::gainToDecibels((float)internal::fftSize);
+    const float offset = juce::Decibels::gainToDecibels((float)params_.fftSize());
     std::transform(incoming_scope_data_.begin(), incoming_scope_data_.end(),
                    new_scope_data_.begin(), [=](const float f) {
                        return juce::jlimit(dbMin, dbMax,
@@ -491,6 +525,20 @@ void SpectrumDisplay::recalculateScopeData()
 }
 
 void SpectrumDisplay::resized()
+{
+    std::lock_guard l(data_lock_);
+    resetDisplayedData();
+}
+
+void SpectrumDisplay::resizeScopeData(int bins)
+{
+    incoming_scope_data_.assign(bins, 0.f);
+    new_scope_data_.assign(bins, -100.f);
+    displayed_data_.resize(bins);
+    resetDisplayedData();
+}
+
+void SpectrumDisplay::resetDisplayedData()
 {
     auto scopeRect = getLocalBounds().transformedBy(getTransform().inverted());
     auto height = scopeRect.getHeight();
@@ -501,16 +549,22 @@ void SpectrumDisplay::resized()
               dbToY(-96.f, height, -96.f, 0.f));
 }
 
-void SpectrumDisplay::updateScopeData(internal::FftScopeType::iterator begin,
-                                      internal::FftScopeType::iterator end)
+void SpectrumDisplay::updateScopeData(const float *data, size_t bins)
 {
     // Data comes in as gain.
     std::lock_guard l(data_lock_);
 
-    // Decay existing data, and move new data in if it's larger.
-    const float decay = 1.f - sqrt(params_.decay_rate);
+    if (bins != incoming_scope_data_.size())
+    {
+        return;
+    }
 
-    std::transform(begin, end, incoming_scope_data_.begin(), incoming_scope_data_.begin(),
+    // Decay existing data, and move new data in if it's larger. The rate is defined per 8k
+    // samples, so scale it to the hop size to keep it independent of the overlap.
+    const float decay = std::pow(1.f - sqrt(params_.decay_rate),
+                                 static_cast<float>(params_.hopSize()) / internal::defaultFftSize);
+
+    std::transform(data, data + bins, incoming_scope_data_.begin(), incoming_scope_data_.begin(),
                    [decay](const float fn, const float f) { return std::max(f * decay, fn); });
 
     last_updated_time_ = std::chrono::steady_clock::now();
@@ -529,12 +583,9 @@ float SpectrumDisplay::interpolate(const float y0, const float y1,
     return y0 * (1 - mu) + y1 * mu;
 }
 
-// TODO:
-// (1) Give configuration to the user to choose FFT params (namely, desired Hz resolution).
 Oscilloscope::Oscilloscope(SurgeGUIEditor *e, SurgeStorage *s)
-    : editor_(e), storage_(s), forward_fft_(internal::fftOrder),
-      window_(internal::fftSize, juce::dsp::WindowingFunction<float>::hann), pos_(0),
-      complete_(false), fft_thread_(std::bind(std::mem_fn(&Oscilloscope::pullData), this)),
+    : editor_(e), storage_(s), complete_(false),
+      fft_thread_(std::bind(std::mem_fn(&Oscilloscope::pullData), this)),
       channel_selection_(STEREO), scope_mode_(SPECTRUM), left_chan_button_("L"),
       right_chan_button_("R"), scope_mode_button_(*this), background_(s), spectrum_(e, s),
       spectrum_parameters_(e, s, this), waveform_(e, s), waveform_parameters_(e, s, this)
@@ -587,6 +638,15 @@ Oscilloscope::Oscilloscope(SurgeGUIEditor *e, SurgeStorage *s)
     addChildComponent(waveform_);
     addChildComponent(waveform_parameters_);
 
+    {
+        // Size the analyzer from the restored spectrum parameters.
+        std::lock_guard l(data_lock_);
+        auto params = spectrum_parameters_.getParams();
+        background_.updateParameters(params);
+        configureSpectrum(params);
+        spectrum_.setParameters(std::move(params));
+    }
+
     // Set the initial mode based on the DAW state.
     int mode = juce::jlimit(0, 1, s->getPatch().dawExtraState.editor.oscilloscopeOverlayState.mode);
     scope_mode_button_.setValue(static_cast<float>(mode));
@@ -608,6 +668,7 @@ Oscilloscope::~Oscilloscope()
     fft_thread_.join();
     // Data thread can perform subscriptions, so do a final unsubscribe after it's done.
     storage_->audioOut.unsubscribe();
+    releaseSpectrum();
 }
 
 void Oscilloscope::onSkinChanged()
@@ -697,6 +758,15 @@ int32_t Oscilloscope::controlModifierClicked(Surge::GUI::IComponentTagValue *pCo
     case tag_sp_decay_rate:
         menuName = "Spectrum Decay Rate";
         break;
+    case tag_sp_fft_size:
+        menuName = "FFT Size";
+        break;
+    case tag_sp_overlap:
+        menuName = "FFT Overlap";
+        break;
+    case tag_sp_averaging:
+        menuName = "Spectrum Averaging";
+        break;
     default:
         break;
     }
@@ -1071,6 +1141,10 @@ Oscilloscope::SpectrumParameters::SpectrumParameters(SurgeGUIEditor *e, SurgeSto
     params_.noise_floor = juce::jlimit(0.f, 1.f, state->noise_floor);
     params_.max_db = juce::jlimit(0.f, 1.f, state->max_db);
     params_.decay_rate = juce::jlimit(0.f, 1.f, state->decay_rate);
+    params_.fft_order =
+        juce::jlimit(internal::minFftOrder, internal::maxFftOrder, state->fft_order);
+    params_.overlap = juce::jlimit(0, 3, state->fft_overlap);
+    params_.averaging = juce::jlimit(0, 3, state->fft_averaging);
 
     noise_floor_.setOrientation(Surge::ParamConfig::kHorizontal);
     max_db_.setOrientation(Surge::ParamConfig::kHorizontal);
@@ -1151,6 +1225,64 @@ Oscilloscope::SpectrumParameters::SpectrumParameters(SurgeGUIEditor *e, SurgeSto
     freeze_.onToggle = std::bind(toggleParam, std::ref(params_.freeze));
 
     addAndMakeVisible(freeze_);
+
+    // The analysis switches.
+    auto updateSwitch = [this](int &param, int &backer, int value) {
+        std::lock_guard l(params_lock_);
+        params_changed_ = true;
+        backer = value; // Save to DAW state.
+        param = value;
+    };
+
+    fft_size_.setRows(3);
+    fft_size_.setColumns(2);
+    fft_size_.setLabels({"1k", "2k", "4k", "8k", "16k", "32k"});
+    fft_size_.setIntegerValue(params_.fft_order - internal::minFftOrder);
+    fft_size_.setTag(tag_sp_fft_size);
+    fft_size_.setDescription("FFT size. Larger sizes resolve lower frequencies, but react slower.");
+    fft_size_.setOnUpdate([this, state](int value) {
+        std::lock_guard l(params_lock_);
+        params_changed_ = true;
+        params_.fft_order = juce::jlimit(internal::minFftOrder, internal::maxFftOrder,
+                                         value + internal::minFftOrder);
+        state->fft_order = params_.fft_order; // Save to DAW state.
+    });
+
+    overlap_.setRows(4);
+    overlap_.setColumns(1);
+    overlap_.setLabels({"0%", "50%", "75%", "88%"});
+    overlap_.setIntegerValue(params_.overlap);
+    overlap_.setTag(tag_sp_overlap);
+    overlap_.setDescription("Overlap between analyzed frames.");
+    overlap_.setOnUpdate(
+        std::bind(updateSwitch, std::ref(params_.overlap), std::ref(state->fft_overlap), _1));
+
+    averaging_.setRows(4);
+    averaging_.setColumns(1);
+    averaging_.setLabels({"1x", "2x", "4x", "8x"});
+    averaging_.setIntegerValue(params_.averaging);
+    averaging_.setTag(tag_sp_averaging);
+    averaging_.setDescription("Number of frames averaged together.");
+    averaging_.setOnUpdate(
+        std::bind(updateSwitch, std::ref(params_.averaging), std::ref(state->fft_averaging), _1));
+
+    for (auto *sw : {&fft_size_, &overlap_, &averaging_})
+    {
+        sw->setStorage(s);
+        sw->setDraggable(true);
+        sw->setWantsKeyboardFocus(false);
+        sw->addListener(this);
+        // Take our initial value into account and color the switch appropriately.
+        sw->valueChanged(nullptr);
+        addAndMakeVisible(*sw);
+    }
+}
+
+SpectrumDisplay::Parameters Oscilloscope::SpectrumParameters::getParams()
+{
+    std::lock_guard l(params_lock_);
+    params_changed_ = false;
+    return params_;
 }
 
 std::optional<SpectrumDisplay::Parameters> Oscilloscope::SpectrumParameters::getParamsIfDirty()
@@ -1171,6 +1303,9 @@ void Oscilloscope::SpectrumParameters::onSkinChanged()
     noise_floor_.setSkin(skin, associatedBitmapStore);
     max_db_.setSkin(skin, associatedBitmapStore);
     decay_rate_.setSkin(skin, associatedBitmapStore);
+    fft_size_.setSkin(skin, associatedBitmapStore);
+    overlap_.setSkin(skin, associatedBitmapStore);
+    averaging_.setSkin(skin, associatedBitmapStore);
     freeze_.setSkin(skin, associatedBitmapStore);
 
     auto font = skin->fontManager->getLatoAtSize(9, juce::Font::plain);
@@ -1196,6 +1331,10 @@ void Oscilloscope::SpectrumParameters::resized()
     max_db_.setBounds(78, 42, 140, 26);
     decay_rate_.setBounds(219, 28, 140, 26);
 
+    fft_size_.setBounds(364, 14, 50, 52);
+    overlap_.setBounds(418, 14, 32, 52);
+    averaging_.setBounds(454, 14, 32, 52);
+
     freeze_.setBounds(8, 33, buttonWidth, 14);
 }
 
@@ -1222,6 +1361,7 @@ void Oscilloscope::updateDrawing()
             {
                 background_.updateParameters(*params);
                 background_.repaint();
+                configureSpectrum(*params);
                 spectrum_.setParameters(std::move(*params));
             }
             spectrum_.repaint();
@@ -1246,11 +1386,20 @@ void Oscilloscope::visibilityChanged()
 // Lock for member variables must be held by the caller.
 void Oscilloscope::calculateSpectrumData()
 {
-    window_.multiplyWithWindowingTable(fft_data_.data(), internal::fftSize);
-    forward_fft_.performFrequencyOnlyForwardTransform(fft_data_.data());
-
-    float binHz = storage_->samplerate / static_cast<float>(internal::fftSize);
-    for (int i = 0; i < internal::fftSize / 2; i++)
+    // The frame ending at the write position is contiguous in the doubled history, so the
+    // window is applied straight from it into the aligned input buffer.
+    juce::FloatVectorOperations::multiply(fft_in_, history_.data() + history_pos_, fft_window_,
+                                          fft_size_);
+    pffft_transform_ordered(fft_setup_, fft_in_, fft_out_, fft_work_, PFFFT_FORWARD);
+
+    // Ordered real output packs DC and Nyquist into the first pair, then interleaves re/im.
+    // Both of those are outside the displayed range anyway.
+    const float binHz = storage_->samplerate / static_cast<float>(fft_size_);
+    const float alpha = 1.f / static_cast<float>(averaging_frames_);
+    const int bins = fft_size_ / 2;
+
+    scope_data_[0] = 0;
+    for (int i = 1; i < bins; i++)
     {
         float hz = binHz * static_cast<float>(i);
         if (hz < SpectrumDisplay::lowFreq || hz > SpectrumDisplay::highFreq)
@@ -1259,11 +1408,65 @@ void Oscilloscope::calculateSpectrumData()
         }
         else
         {
-            scope_data_[i] = fft_data_[i];
+            const float re = fft_out_[2 * i];
+            const float im = fft_out_[2 * i + 1];
+            const float mag = std::sqrt(re * re + im * im);
+            scope_data_[i] += alpha * (mag - scope_data_[i]);
         }
     }
 }
 
+// Lock for member variables must be held by the caller.
+void Oscilloscope::configureSpectrum(const SpectrumDisplay::Parameters &params)
+{
+    const int size = params.fftSize();
+
+    if (size != fft_size_)
+    {
+        releaseSpectrum();
+
+        fft_size_ = size;
+        fft_setup_ = pffft_new_setup(size, PFFFT_REAL);
+        fft_window_ = static_cast<float *>(pffft_aligned_malloc(size * sizeof(float)));
+        fft_in_ = static_cast<float *>(pffft_aligned_malloc(size * sizeof(float)));
+        fft_out_ = static_cast<float *>(pffft_aligned_malloc(size * sizeof(float)));
+        fft_work_ = static_cast<float *>(pffft_aligned_malloc(size * sizeof(float)));
+
+        juce::dsp::WindowingFunction<float>::fillWindowingTables(
+            fft_window_, size, juce::dsp::WindowingFunction<float>::hann);
+
+        history_.assign(2 * size, 0.f);
+        history_pos_ = 0;
+        scope_data_.assign(size / 2, 0.f);
+    }
+
+    if (params.hopSize() != hop_size_)
+    {
+        hop_size_ = params.hopSize();
+        hop_pos_ = 0;
+    }
+
+    averaging_frames_ = params.averagingFrames();
+}
+
+// Lock for member variables must be held by the caller.
+void Oscilloscope::releaseSpectrum()
+{
+    if (fft_setup_)
+    {
+        pffft_destroy_setup(fft_setup_);
+        pffft_aligned_free(fft_window_);
+        pffft_aligned_free(fft_in_);
+        pffft_aligned_free(fft_out_);
+        pffft_aligned_free(fft_work_);
+    }
+
+    fft_setup_ = nullptr;
+    fft_window_ = fft_in_ = fft_out_ = fft_work_ = nullptr;
+    fft_size_ = 0;
+    hop_size_ = 0;
+}
+
 void Oscilloscope::changeScopeType(ScopeMode type)
 {
     std::unique_lock l(data_lock_);
@@ -1341,12 +1544,14 @@ void Oscilloscope::pullData()
         std::vector<float> &dataR = data.second;
         if (dataL.empty())
         {
-            // Sleep for long enough to accumulate about 4096 samples, or half that in waveform
-            // mode.
-            ScopeMode mode = scope_mode_;
+            // Sleep for long enough to accumulate about 4096 samples (or a hop, if that's
+            // shorter), or 2048 in waveform mode.
+            const int samples = scope_mode_ == SPECTRUM
+                                    ? std::min(hop_size_, internal::defaultFftSize / 2)
+                                    : internal::defaultFftSize / 4;
             l.unlock();
             std::this_thread::sleep_for(std::chrono::duration<float, std::chrono::seconds::period>(
-                internal::fftSize / (mode == SPECTRUM ? 2.f : 4.f) / storage_->samplerate));
+                std::max(samples, 1) / storage_->samplerate));
             continue;
         }
 
@@ -1365,23 +1570,37 @@ void Oscilloscope::pullData()
         {
             waveform_.process(std::move(dataL));
         }
-        else
+        else if (fft_setup_)
         {
-            int sz = dataL.size();
-            if (pos_ + sz >= internal::fftSize)
-            {
-                int mv = internal::fftSize - pos_;
-                int leftovers = sz - mv;
-                std::move(dataL.begin(), dataL.begin() + mv, fft_data_.begin() + pos_);
-                calculateSpectrumData();
-                spectrum_.updateScopeData(scope_data_.begin(), scope_data_.end());
-                std::move(dataL.begin() + mv, dataL.end(), fft_data_.begin());
-                pos_ = leftovers;
-            }
-            else
+            // Each sample is written once into the history ring (and its mirror) and a frame is
+            // analyzed every hop, so the work per sample doesn't depend on the FFT size. Frames
+            // which would be overwritten before they could contribute to the averaged result are
+            // skipped when we fall behind.
+            const int sz = dataL.size();
+            int i = 0;
+            while (i < sz)
             {
-                std::move(dataL.begin(), dataL.end(), fft_data_.begin() + pos_);
-                pos_ += sz;
+                int chunk = std::min({sz - i, hop_size_ - hop_pos_, fft_size_ - history_pos_});
+                std::copy_n(dataL.data() + i, chunk, history_.data() + history_pos_);
+                std::copy_n(dataL.data() + i, chunk, history_.data() + history_pos_ + fft_size_);
+
+                i += chunk;
+                hop_pos_ += chunk;
+                history_pos_ += chunk;
+                if (history_pos_ == fft_size_)
+                {
+                    history_pos_ = 0;
+                }
+
+                if (hop_pos_ == hop_size_)
+                {
+                    hop_pos_ = 0;
+                    if (sz - i < hop_size_ * averaging_frames_)
+                    {
+                        calculateSpectrumData();
+                        spectrum_.updateScopeData(scope_data_.data(), scope_data_.size());
+                    }
+                }
             }
         }
     }
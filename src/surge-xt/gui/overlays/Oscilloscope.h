@@ -41,6 +41,7 @@
 #include "juce_core/juce_core.h"
 #include "juce_dsp/juce_dsp.h"
 #include "juce_gui_basics/juce_gui_basics.h"
+#include "pffft.h"
 #include "sst/cpputils.h"
 
 namespace Surge
@@ -50,11 +51,14 @@ namespace Overlays
 
 namespace internal
 {
-constexpr int fftOrder = 13;
-constexpr int fftSize = 8192;
-
-// Really wish span was available.
-using FftScopeType = std::array<float, fftSize / 2>;
+// The spectrum can be analyzed with anything from a 1k to a 32k point FFT.
+constexpr int minFftOrder = 10;
+constexpr int maxFftOrder = 15;
+constexpr int defaultFftOrder = 13;
+constexpr int defaultFftSize = 1 << defaultFftOrder;
+
+// Sized to half the FFT size; really wish span was available.
+using FftScopeType = std::vector<float>;
 } // namespace internal
 
 // Waveform-specific display taken from s(m)exoscope GPL code and adapted to use with Surge.
@@ -160,6 +164,16 @@ class SpectrumDisplay : public juce::Component, public Surge::GUI::SkinConsuming
         float decay_rate = 1.f;  // Rate of decay of existing spectrum data. Slider.
         bool freeze = false;     // Freeze display, on/off.
 
+        // FFT size as a power of two (1k to 32k), the overlap of consecutive frames as a shift
+        // of that size (0%, 50%, 75% or 87.5%), and the frames averaged as a power of two.
+        int fft_order = internal::defaultFftOrder;
+        int overlap = 1;
+        int averaging = 0;
+
+        int fftSize() const { return 1 << fft_order; }
+        int hopSize() const { return fftSize() >> overlap; }
+        int averagingFrames() const { return 1 << averaging; }
+
         // Range of decibels shown in the display, calculated from slider values.
         float dbRange() const;
 
@@ -177,14 +191,18 @@ class SpectrumDisplay : public juce::Component, public Surge::GUI::SkinConsuming
 
     void paint(juce::Graphics &g) override;
     void resized() override;
-    void updateScopeData(internal::FftScopeType::iterator begin,
-                         internal::FftScopeType::iterator end);
+    // Takes fftSize() / 2 bins of magnitude data; anything else is from a stale
+    // configuration and is dropped.
+    void updateScopeData(const float *data, size_t bins);
 
   private:
     float interpolate(const float y0, const float y1,
                       std::chrono::time_point<std::chrono::steady_clock> t) const;
     // data_lock_ *must* be held by the caller.
     void recalculateScopeData();
+    // data_lock_ *must* be held by the caller.
+    void resizeScopeData(int bins);
+    void resetDisplayedData();
 
     SurgeGUIEditor *editor_;
     SurgeStorage *storage_;
@@ -246,6 +264,10 @@ class Oscilloscope : public OverlayComponent,
         tag_sp_min_level,
         tag_sp_max_level,
         tag_sp_decay_rate,
+
+        tag_sp_fft_size,
+        tag_sp_overlap,
+        tag_sp_averaging,
     };
 
     enum ChannelSelect
@@ -296,6 +318,7 @@ class Oscilloscope : public OverlayComponent,
         SpectrumParameters(SurgeGUIEditor *e, SurgeStorage *s, Oscilloscope *parent);
 
         std::optional<SpectrumDisplay::Parameters> getParamsIfDirty();
+        SpectrumDisplay::Parameters getParams();
 
         void onSkinChanged() override;
         void paint(juce::Graphics &g) override;
@@ -325,6 +348,9 @@ class Oscilloscope : public OverlayComponent,
         Surge::Widgets::SelfUpdatingModulatableSlider noise_floor_;
         Surge::Widgets::SelfUpdatingModulatableSlider max_db_;
         Surge::Widgets::SelfUpdatingModulatableSlider decay_rate_;
+        Surge::Widgets::ClosedMultiSwitchSelfDraw fft_size_;
+        Surge::Widgets::ClosedMultiSwitchSelfDraw overlap_;
+        Surge::Widgets::ClosedMultiSwitchSelfDraw averaging_;
         Surge::Widgets::SelfDrawToggleButton freeze_;
     };
 
@@ -389,6 +415,8 @@ class Oscilloscope : public OverlayComponent,
     static constexpr const int paramsHeight = 80;
 
     void calculateSpectrumData();
+    void configureSpectrum(const SpectrumDisplay::Parameters &params);
+    void releaseSpectrum();
     void changeScopeType(ScopeMode type);
     juce::Rectangle<int> getScopeRect();
     void pullData();
@@ -396,10 +424,15 @@ class Oscilloscope : public OverlayComponent,
 
     SurgeGUIEditor *editor_{nullptr};
     SurgeStorage *storage_{nullptr};
-    juce::dsp::FFT forward_fft_;
-    juce::dsp::WindowingFunction<float> window_;
-    std::array<float, 2 * internal::fftSize> fft_data_;
-    int pos_;
+
+    // Spectrum analysis state. The pffft buffers are SIMD aligned and sized to the FFT.
+    PFFFT_Setup *fft_setup_{nullptr};
+    float *fft_window_{nullptr}, *fft_in_{nullptr}, *fft_out_{nullptr}, *fft_work_{nullptr};
+    int fft_size_{0}, hop_size_{0}, averaging_frames_{1};
+    // The most recent fft_size_ samples, written twice so the frame ending at the write position
+    // is always contiguous and can be windowed straight out of the ring.
+    std::vector<float> history_;
+    int history_pos_{0}, hop_pos_{0};
     internal::FftScopeType scope_data_;
     ChannelSelect channel_selection_;
     ScopeMode scope_mode_;
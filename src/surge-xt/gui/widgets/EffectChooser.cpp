@@ -587,6 +587,11 @@ void EffectChooser::getColorsForSlot(int fxslot, juce::Colour &bgcol, juce::Colo
             }
         }
     }
+
+    if (!byp && (dormantBitmask & (1 << fxslot)))
+    {
+        txtcol = txtcol.withMultipliedAlpha(0.5f);
+    }
 }
 
 void EffectChooser::setEffectType(int index, int type)
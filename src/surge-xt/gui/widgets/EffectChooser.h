@@ -102,6 +102,10 @@ struct EffectChooser : public juce::Component,
     void setDeactivatedBitmask(int d) { deactivatedBitmask = d; };
     int getDeactivatedBitmask() const { return deactivatedBitmask; }
     int deactivatedBitmask{0};
+    // Slots whose effect is idle on the audio thread; drawn with dimmed text
+    void setDormantBitmask(int d) { dormantBitmask = d; }
+    int getDormantBitmask() const { return dormantBitmask; }
+    int dormantBitmask{0};
     void toggleSelectedDeactivation();
     void setEffectSlotDeactivation(int slotIdx, bool state);
 
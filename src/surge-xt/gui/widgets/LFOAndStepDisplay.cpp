@@ -27,8 +27,14 @@
 #include "SurgeGUIUtils.h"
 #include "SurgeJUCEHelpers.h"
 #include "RuntimeFont.h"
+#include "LatestRequestWorker.h"
 #include <algorithm>
 #include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
 #include "widgets/MenuCustomComponents.h"
 #include "AccessibleHelpers.h"
 #include "overlays/TypeinParamEditor.h"
@@ -420,32 +426,57 @@ void LFOAndStepDisplay::paint(juce::Graphics &g)
     paintTypeSelector(g);
 }
 
-void LFOAndStepDisplay::paintWaveform(juce::Graphics &g)
+/*
+ * Simulating the LFO over the whole displayed range is far too much work to redo on every paint,
+ * and dragging a rate or deform knob paints at frame rate. So the simulation lives here, works
+ * only from copies of the modulator state, and produces the curves in the 0..100 space
+ * paintWaveform scales onto the display. The display keeps the last result keyed by the state
+ * it came from and only asks for a new one when that state changes.
+ */
+struct LFOPreviewInputs
 {
-    TimeB mainTimer("-- paintWaveform");
-
-    juce::Path deactPath, path, eupath, edpath;
-    bool drawBeats = isAnythingTemposynced();
-
-    pdata tp[n_scene_params], tpd[n_scene_params];
+    LFOStorage lfo;
+    StepSequencerStorage ss;
+    MSEGStorage ms;
+    FormulaModulatorStorage fs;
+    pdata tp[n_scene_params]{};
+    int width{0};
+    bool useAmpWave{false}, isVoice{false};
+    std::string key;
+};
 
-    tp[lfodata->delay.param_id_in_scene].i = lfodata->delay.val.i;
-    tp[lfodata->attack.param_id_in_scene].i = lfodata->attack.val.i;
-    tp[lfodata->hold.param_id_in_scene].i = lfodata->hold.val.i;
-    tp[lfodata->decay.param_id_in_scene].i = lfodata->decay.val.i;
-    tp[lfodata->sustain.param_id_in_scene].i = lfodata->sustain.val.i;
-    tp[lfodata->release.param_id_in_scene].i = lfodata->release.val.i;
+struct LFOPreview
+{
+    juce::Path path, eupath, edpath, deactPath;
+    bool hasFullWave{false}, waveIsAmpWave{false}, drawEnvelope{true};
+    bool msegRelease{false};
+    float msegReleaseAt{0}, drawnTime{0};
+    bool warnForInvalid{false};
+    std::string invalidMessage;
+    std::string key;
+};
 
-    tp[lfodata->magnitude.param_id_in_scene].i = lfodata->magnitude.val.i;
-    tp[lfodata->rate.param_id_in_scene].i = lfodata->rate.val.i;
-    tp[lfodata->shape.param_id_in_scene].i = lfodata->shape.val.i;
-    tp[lfodata->start_phase.param_id_in_scene].i = lfodata->start_phase.val.i;
-    tp[lfodata->deform.param_id_in_scene].i = lfodata->deform.val.i;
-    tp[lfodata->trigmode.param_id_in_scene].i = lm_keytrigger;
+static std::unique_ptr<LFOPreview>
+simulateLFOPreview(SurgeStorage *storage, LFOPreviewInputs &in,
+                   const std::function<void(LFOModulationSource *)> &populate)
+{
+    auto res = std::make_unique<LFOPreview>();
+    res->key = in.key;
+
+    auto lfodata = &in.lfo;
+    auto ss = &in.ss;
+    auto ms = &in.ms;
+    auto fs = &in.fs;
+    auto &tp = in.tp;
+    pdata tpd[n_scene_params];
+
+    auto &path = res->path;
+    auto &eupath = res->eupath;
+    auto &edpath = res->edpath;
+    auto &deactPath = res->deactPath;
+    bool isUnipolar = lfodata->unipolar.val.b;
 
     float susTime = 0.5;
-    bool msegRelease = false;
-    float msegReleaseAt = 0;
     float lfoEnvelopeDAHDTime = pow(2.0f, lfodata->delay.val.f) + pow(2.0f, lfodata->attack.val.f) +
                                 pow(2.0f, lfodata->hold.val.f) + pow(2.0f, lfodata->decay.val.f);
 
@@ -457,8 +488,8 @@ void LFOAndStepDisplay::paintWaveform(juce::Graphics &g)
         {
             float loopEndsAt = ms->segmentEnd[ms->loop_end];
             susTime = std::max(0.5f, loopEndsAt - lfoEnvelopeDAHDTime);
-            msegReleaseAt = lfoEnvelopeDAHDTime + susTime;
-            msegRelease = true;
+            res->msegReleaseAt = lfoEnvelopeDAHDTime + susTime;
+            res->msegRelease = true;
         }
     }
 
@@ -478,23 +509,19 @@ void LFOAndStepDisplay::paintWaveform(juce::Graphics &g)
      *
      * so
      */
-    // std::cout << _D(totalEnvTime);
     totalEnvTime = std::min(totalEnvTime, 50.f / rateInHz);
-    // std::cout << _D(totalEnvTime) << std::endl;
-    // std::cout << _D(rateInHz) << _D(1.0/rateInHz) << _D(totalEnvTime*rateInHz) << std::endl;
 
-    LFOModulationSource *tlfo = new LFOModulationSource();
-    LFOModulationSource *tFullWave = nullptr;
+    auto tlfo = std::make_unique<LFOModulationSource>();
+    std::unique_ptr<LFOModulationSource> tFullWave;
     tlfo->assign(storage, lfodata, tp, 0, ss, ms, fs, true);
-    populateLFOMS(tlfo);
+    populate(tlfo.get());
     tlfo->attack();
 
     LFOStorage deactivateStorage;
-    bool hasFullWave = false, waveIsAmpWave = false;
 
     if (lfodata->rate.deactivated)
     {
-        hasFullWave = true;
+        res->hasFullWave = true;
         deactivateStorage = *lfodata;
         std::copy(std::begin(tp), std::end(tp), std::begin(tpd));
 
@@ -509,29 +536,24 @@ void LFOAndStepDisplay::paintWaveform(juce::Graphics &g)
         deactivateStorage.start_phase.val.f = 0;
         tpd[lfodata->start_phase.param_id_in_scene].f = 0;
         tpd[lfodata->rate.param_id_in_scene].f = desiredRate;
-        tFullWave = new LFOModulationSource();
+        tFullWave = std::make_unique<LFOModulationSource>();
         tFullWave->assign(storage, &deactivateStorage, tpd, 0, ss, ms, fs, true);
-        populateLFOMS(tFullWave);
+        populate(tFullWave.get());
         tFullWave->attack();
     }
-    else if (lfodata->magnitude.val.f != lfodata->magnitude.val_max.f && skin->getVersion() >= 2)
+    else if (in.useAmpWave)
     {
-        bool useAmpWave = Surge::Storage::getUserDefaultValue(
-            storage, Surge::Storage::ShowGhostedLFOWaveReference, 1);
-        if (useAmpWave)
-        {
-            hasFullWave = true;
-            waveIsAmpWave = true;
-            deactivateStorage = *lfodata;
-            std::copy(std::begin(tp), std::end(tp), std::begin(tpd));
+        res->hasFullWave = true;
+        res->waveIsAmpWave = true;
+        deactivateStorage = *lfodata;
+        std::copy(std::begin(tp), std::end(tp), std::begin(tpd));
 
-            deactivateStorage.magnitude.val.f = 1.f;
-            tpd[lfodata->magnitude.param_id_in_scene].f = 1.f;
-            tFullWave = new LFOModulationSource();
-            tFullWave->assign(storage, &deactivateStorage, tpd, 0, ss, ms, fs, true);
-            populateLFOMS(tFullWave);
-            tFullWave->attack();
-        }
+        deactivateStorage.magnitude.val.f = 1.f;
+        tpd[lfodata->magnitude.param_id_in_scene].f = 1.f;
+        tFullWave = std::make_unique<LFOModulationSource>();
+        tFullWave->assign(storage, &deactivateStorage, tpd, 0, ss, ms, fs, true);
+        populate(tFullWave.get());
+        tFullWave->attack();
     }
 
     if (lfodata->shape.val.i == lt_formula)
@@ -542,18 +564,12 @@ void LFOAndStepDisplay::paintWaveform(juce::Graphics &g)
         }
     }
 
-    bool drawEnvelope = !lfodata->delay.deactivated;
-
-    if (skin->hasColor(Colors::LFO::Waveform::Background))
-    {
-        g.setColour(skin->getColor(Colors::LFO::Waveform::Background));
-        g.fillRect(waveform_display);
-    }
+    res->drawEnvelope = !lfodata->delay.deactivated;
 
-    int minSamples = (1 << 0) * (int)(waveform_display.getWidth());
+    int minSamples = (1 << 0) * in.width;
     int totalSamples =
         std::max((int)minSamples, (int)(totalEnvTime * storage->samplerate / BLOCK_SIZE));
-    float drawnTime = totalSamples * storage->samplerate_inv * BLOCK_SIZE;
+    res->drawnTime = totalSamples * storage->samplerate_inv * BLOCK_SIZE;
 
     // OK so let's assume we want about 1000 pixels worth tops in
     int averagingWindow = (int)(totalSamples / 1000.0) + 1;
@@ -656,7 +672,7 @@ void LFOAndStepDisplay::paintWaveform(juce::Graphics &g)
             path.startNewSubPath(xc, val);
             eupath.startNewSubPath(xc, euval);
 
-            if (!isUnipolar())
+            if (!isUnipolar)
             {
                 edpath.startNewSubPath(xc, edval);
             }
@@ -710,17 +726,172 @@ void LFOAndStepDisplay::paintWaveform(juce::Graphics &g)
 
     if (lfodata->shape.val.i == lt_formula)
     {
-        drawEnvelope = tlfo->formulastate.useEnvelope;
+        res->drawEnvelope = tlfo->formulastate.useEnvelope;
     }
 
     tlfo->completedModulation();
 
-    delete tlfo;
-
     if (tFullWave)
     {
         tFullWave->completedModulation();
-        delete tFullWave;
+    }
+
+    res->warnForInvalid = warnForInvalid;
+    res->invalidMessage = invalidMessage;
+
+    return res;
+}
+
+struct LFOPreviewEvaluator : Surge::GUI::LatestRequestWorker<LFOPreviewInputs, LFOPreview>
+{
+    LFOPreviewEvaluator(LFOAndStepDisplay *d, SurgeStorage *storage)
+        : LatestRequestWorker(d, [storage](LFOPreviewInputs &in) {
+              auto isVoice = in.isVoice;
+              return simulateLFOPreview(storage, in, [isVoice](auto *s) {
+                  s->setIsVoice(isVoice);
+                  if (isVoice)
+                      s->formulastate.velocity = 100;
+              });
+          })
+    {
+    }
+};
+
+LFOAndStepDisplay::~LFOAndStepDisplay() = default;
+
+bool LFOAndStepDisplay::showsAmpWave()
+{
+    if (lfodata->rate.deactivated || lfodata->magnitude.val.f == lfodata->magnitude.val_max.f ||
+        skin->getVersion() < 2)
+        return false;
+
+    return Surge::Storage::getUserDefaultValue(storage,
+                                               Surge::Storage::ShowGhostedLFOWaveReference, 1);
+}
+
+std::string LFOAndStepDisplay::previewKey()
+{
+    std::string key;
+    auto add = [&key](const auto &v) {
+        static_assert(std::is_trivially_copyable_v<std::decay_t<decltype(v)>>);
+        key.append(reinterpret_cast<const char *>(&v), sizeof(v));
+    };
+
+    for (auto *p : {&lfodata->rate, &lfodata->shape, &lfodata->start_phase, &lfodata->magnitude,
+                    &lfodata->deform, &lfodata->trigmode, &lfodata->unipolar, &lfodata->delay,
+                    &lfodata->hold, &lfodata->attack, &lfodata->decay, &lfodata->sustain,
+                    &lfodata->release})
+    {
+        add(p->val.i);
+        add(p->temposync);
+        add(p->deactivated);
+        add(p->extend_range);
+        add(p->absolute);
+        add(p->deform_type);
+    }
+
+    add(lfodata->magnitude.val_max.f);
+    add(lfodata->lfoExtraAmplitude);
+    add(lfoid);
+    add(waveform_display.getWidth());
+    add(showsAmpWave());
+    add(storage->samplerate);
+    add(storage->temposyncratio);
+
+    if (ms && lfodata->shape.val.i == lt_mseg)
+        add(*ms);
+    if (ss && lfodata->shape.val.i == lt_stepseq)
+        add(*ss);
+
+    return key;
+}
+
+std::unique_ptr<LFOPreviewInputs> LFOAndStepDisplay::makePreviewInputs(const std::string &key)
+{
+    auto in = std::make_unique<LFOPreviewInputs>();
+
+    in->lfo = *lfodata;
+    if (ss)
+        in->ss = *ss;
+    if (ms)
+        in->ms = *ms;
+    if (fs)
+        in->fs = *fs;
+
+    auto &tp = in->tp;
+    tp[lfodata->delay.param_id_in_scene].i = lfodata->delay.val.i;
+    tp[lfodata->attack.param_id_in_scene].i = lfodata->attack.val.i;
+    tp[lfodata->hold.param_id_in_scene].i = lfodata->hold.val.i;
+    tp[lfodata->decay.param_id_in_scene].i = lfodata->decay.val.i;
+    tp[lfodata->sustain.param_id_in_scene].i = lfodata->sustain.val.i;
+    tp[lfodata->release.param_id_in_scene].i = lfodata->release.val.i;
+
+    tp[lfodata->magnitude.param_id_in_scene].i = lfodata->magnitude.val.i;
+    tp[lfodata->rate.param_id_in_scene].i = lfodata->rate.val.i;
+    tp[lfodata->shape.param_id_in_scene].i = lfodata->shape.val.i;
+    tp[lfodata->start_phase.param_id_in_scene].i = lfodata->start_phase.val.i;
+    tp[lfodata->deform.param_id_in_scene].i = lfodata->deform.val.i;
+    tp[lfodata->trigmode.param_id_in_scene].i = lm_keytrigger;
+
+    in->width = waveform_display.getWidth();
+    in->useAmpWave = showsAmpWave();
+    in->isVoice = lfoid < n_lfos_voice;
+    in->key = key;
+
+    return in;
+}
+
+void LFOAndStepDisplay::paintWaveform(juce::Graphics &g)
+{
+    TimeB mainTimer("-- paintWaveform");
+
+    bool drawBeats = isAnythingTemposynced();
+    float valScale = 100.0;
+
+    std::unique_ptr<LFOPreview> formulaPreview;
+    const LFOPreview *preview{nullptr};
+
+    if (isFormula())
+    {
+        // Formulas evaluate in the shared display Lua state and can read the patch, so they
+        // still simulate here, every paint
+        auto in = makePreviewInputs({});
+        formulaPreview = simulateLFOPreview(storage, *in, [this](auto *s) { populateLFOMS(s); });
+        preview = formulaPreview.get();
+    }
+    else
+    {
+        if (!previewEvaluator)
+            previewEvaluator = std::make_unique<LFOPreviewEvaluator>(this, storage);
+
+        if (auto res = previewEvaluator->takeResult())
+            cachedPreview = std::move(res);
+
+        auto key = previewKey();
+
+        if (!cachedPreview)
+        {
+            // Nothing to show yet, so do the first one right here rather than paint a blank
+            auto in = makePreviewInputs(key);
+            cachedPreview =
+                simulateLFOPreview(storage, *in, [this](auto *s) { populateLFOMS(s); });
+        }
+        else if (cachedPreview->key != key && requestedPreviewKey != key)
+        {
+            // Keep drawing the previous curve until the new one arrives
+            requestedPreviewKey = key;
+            previewEvaluator->request(makePreviewInputs(key));
+        }
+
+        preview = cachedPreview.get();
+    }
+
+    float drawnTime = preview->drawnTime;
+
+    if (skin->hasColor(Colors::LFO::Waveform::Background))
+    {
+        g.setColour(skin->getColor(Colors::LFO::Waveform::Background));
+        g.fillRect(waveform_display);
     }
 
     auto at =
@@ -769,14 +940,14 @@ void LFOAndStepDisplay::paintWaveform(juce::Graphics &g)
         }
     }
 
-    if (drawEnvelope)
+    if (preview->drawEnvelope)
     {
         g.setColour(skin->getColor(Colors::LFO::Waveform::Envelope));
-        g.strokePath(eupath, juce::PathStrokeType(1.f), at);
+        g.strokePath(preview->eupath, juce::PathStrokeType(1.f), at);
 
         if (!isUnipolar())
         {
-            g.strokePath(edpath, juce::PathStrokeType(1.f), at);
+            g.strokePath(preview->edpath, juce::PathStrokeType(1.f), at);
         }
     }
 
@@ -853,22 +1024,22 @@ void LFOAndStepDisplay::paintWaveform(juce::Graphics &g)
         }
     }
 
-    if (hasFullWave)
+    if (preview->hasFullWave)
     {
-        if (waveIsAmpWave)
+        if (preview->waveIsAmpWave)
         {
             g.setColour(skin->getColor(Colors::LFO::Waveform::GhostedWave));
             auto dotted = juce::Path();
             auto st = juce::PathStrokeType(0.3, juce::PathStrokeType::beveled,
                                            juce::PathStrokeType::butt);
             float dashLength[2] = {4.f, 2.f};
-            st.createDashedStroke(dotted, deactPath, dashLength, 2, at);
+            st.createDashedStroke(dotted, preview->deactPath, dashLength, 2, at);
             g.strokePath(dotted, st);
         }
         else
         {
             g.setColour(skin->getColor(Colors::LFO::Waveform::DeactivatedWave));
-            g.strokePath(deactPath,
+            g.strokePath(preview->deactPath,
                          juce::PathStrokeType(0.5f, juce::PathStrokeType::beveled,
                                               juce::PathStrokeType::butt),
                          at);
@@ -877,8 +1048,8 @@ void LFOAndStepDisplay::paintWaveform(juce::Graphics &g)
 
     g.setColour(skin->getColor(Colors::LFO::Waveform::Wave));
     g.strokePath(
-        path, juce::PathStrokeType(1.f, juce::PathStrokeType::beveled, juce::PathStrokeType::butt),
-        at);
+        preview->path,
+        juce::PathStrokeType(1.f, juce::PathStrokeType::beveled, juce::PathStrokeType::butt), at);
 
     // lower ruler calculation
     // find time delta
@@ -930,10 +1101,10 @@ void LFOAndStepDisplay::paintWaveform(juce::Graphics &g)
      * with the MSEG but I wrote it to debug and we may change our mind so keeping this code
      * here
      */
-    if (msegRelease && false)
+    if (preview->msegRelease && false)
     {
 #if SHOW_RELEASE_TIMES
-        float xp = msegReleaseAt / drawnTime * valScale;
+        float xp = preview->msegReleaseAt / drawnTime * valScale;
         was a vstgui Point sp(xp, valScale * 0.9), ep(xp, valScale * 0.1);
         tf.transform(sp);
         tf.transform(ep);
@@ -942,11 +1113,11 @@ void LFOAndStepDisplay::paintWaveform(juce::Graphics &g)
 #endif
     }
 
-    if (warnForInvalid)
+    if (preview->warnForInvalid)
     {
         g.setColour(skin->getColor(Colors::LFO::Waveform::Wave));
         g.setFont(skin->fontManager->getLatoAtSize(14, juce::Font::bold));
-        g.drawText(invalidMessage, waveform_display.withTrimmedBottom(30),
+        g.drawText(preview->invalidMessage, waveform_display.withTrimmedBottom(30),
                    juce::Justification::centred);
     }
 }
@@ -1997,6 +2168,7 @@ void LFOAndStepDisplay::mouseDrag(const juce::MouseEvent &event)
                     auto prior = lfodata->shape.val.i;
 
                     lfodata->shape.val.i = i;
+                    storage->getPatch().markParameterChanged(lfodata->shape.id);
 
                     sge->refresh_mod();
                     sge->broadcastPluginAutomationChangeFor(&(lfodata->shape));
@@ -2437,6 +2609,7 @@ void LFOAndStepDisplay::updateShapeTo(int i)
         auto prior = lfodata->shape.val.i;
 
         lfodata->shape.val.i = i;
+        storage->getPatch().markParameterChanged(lfodata->shape.id);
 
         setupAccessibility();
 
@@ -36,11 +36,16 @@ struct TypeinLambdaEditor;
 }
 namespace Widgets
 {
+struct LFOPreview;
+struct LFOPreviewInputs;
+struct LFOPreviewEvaluator;
+
 struct LFOAndStepDisplay : public juce::Component,
                            public WidgetBaseMixin<LFOAndStepDisplay>,
                            public LongHoldMixin<LFOAndStepDisplay>
 {
     LFOAndStepDisplay(SurgeGUIEditor *e);
+    ~LFOAndStepDisplay();
     void paint(juce::Graphics &g) override;
     void paintWaveform(juce::Graphics &g);
     void paintStepSeq(juce::Graphics &g);
@@ -121,6 +126,14 @@ struct LFOAndStepDisplay : public juce::Component,
 
     void populateLFOMS(LFOModulationSource *s);
 
+    // The simulated waveform is cached against the state it was built from, see paintWaveform
+    std::unique_ptr<LFOPreviewEvaluator> previewEvaluator;
+    std::unique_ptr<LFOPreview> cachedPreview;
+    std::string requestedPreviewKey;
+    bool showsAmpWave();
+    std::string previewKey();
+    std::unique_ptr<LFOPreviewInputs> makePreviewInputs(const std::string &key);
+
     void setStepToDefault(const juce::MouseEvent &event);
     void setStepValue(const juce::MouseEvent &event);
 
@@ -34,12 +34,138 @@
 #include "widgets/MenuCustomComponents.h"
 #include "AccessibleHelpers.h"
 #include "UserDefaults.h"
+#include "LatestRequestWorker.h"
 #include "fmt/core.h"
 
+#include <mutex>
+#include <type_traits>
+
 namespace Surge
 {
 namespace Widgets
 {
+/*
+ * Rendering the preview means building and running a whole oscillator, which for wavetable
+ * morphs, Twist or String is slow enough to make scrubbing a parameter sluggish. So it runs on
+ * a worker from a copy of the parameter values, and the display keeps the last finished wave
+ * keyed by what it was rendered from. The oscillator still reads oscdata itself, as the engine
+ * does, under the wavetable lock.
+ */
+struct OscillatorPreviewInputs
+{
+    OscillatorStorage *oscdata{nullptr};
+    int type{0};
+    pdata tp[n_scene_params]{};
+    float pitch{0};
+    int totalSamples{0};
+    std::string key;
+};
+
+struct OscillatorPreview
+{
+    juce::Path wavePath;
+    bool valid{false};
+    std::string key;
+};
+
+static std::unique_ptr<OscillatorPreview>
+renderOscillatorPreview(SurgeStorage *storage, OscillatorPreviewInputs &in, unsigned char *oscbuffer)
+{
+    auto res = std::make_unique<OscillatorPreview>();
+    res->key = in.key;
+
+    ::Oscillator *osc{nullptr};
+    bool use_display{false};
+    {
+        std::lock_guard<std::mutex> g(storage->waveTableDataMutex);
+        osc = spawn_osc(in.type, storage, in.oscdata, in.tp, in.tp, oscbuffer);
+
+        if (!osc)
+        {
+            return res;
+        }
+
+        use_display = osc->allow_display();
+
+        if (use_display)
+        {
+            osc->init(in.pitch, true, true);
+        }
+    }
+
+    int totalSamples = in.totalSamples;
+    int averagingWindow = 4; // < and Mult of BlockSizeOS
+    int block_pos = BLOCK_SIZE;
+    auto &wavePath = res->wavePath;
+
+    float oscTmp alignas(16)[2][BLOCK_SIZE_OS];
+    sst::filters::HalfRate::HalfRateFilter hr(6, true);
+    hr.load_coefficients();
+    hr.reset();
+
+    for (int i = 0; i < totalSamples; i += averagingWindow)
+    {
+        if (use_display && block_pos >= BLOCK_SIZE)
+        {
+            // Lock it even if we aren't wavetable. It's fine.
+            storage->waveTableDataMutex.lock();
+            osc->process_block(in.pitch);
+            memcpy(oscTmp[0], osc->output, sizeof(oscTmp[0]));
+            memcpy(oscTmp[1], osc->output, sizeof(oscTmp[1]));
+            hr.process_block_D2(oscTmp[0], oscTmp[1], BLOCK_SIZE_OS);
+            block_pos = 0;
+            storage->waveTableDataMutex.unlock();
+        }
+
+        float val = 0.f;
+
+        if (use_display)
+        {
+            for (int j = 0; j < averagingWindow; ++j)
+            {
+                val += oscTmp[0][block_pos];
+                block_pos++;
+            }
+
+            val = val / averagingWindow;
+        }
+
+        float xc = 1.f * i / totalSamples;
+
+        if (i == 0)
+        {
+            wavePath.startNewSubPath(xc, val);
+        }
+        else
+        {
+            wavePath.lineTo(xc, val);
+        }
+    }
+
+    osc->~Oscillator();
+    res->valid = true;
+
+    return res;
+}
+
+struct OscillatorPreviewEvaluator
+    : Surge::GUI::LatestRequestWorker<OscillatorPreviewInputs, OscillatorPreview>
+{
+    // The worker's own oscillator memory, so it never shares the display's
+    struct alignas(16) Buffer
+    {
+        unsigned char data[oscillator_buffer_size];
+    };
+
+    OscillatorPreviewEvaluator(OscillatorWaveformDisplay *d, SurgeStorage *storage)
+        : LatestRequestWorker(
+              d, [storage, buf = std::make_shared<Buffer>()](OscillatorPreviewInputs &in) {
+                  return renderOscillatorPreview(storage, in, buf->data);
+              })
+    {
+    }
+};
+
 OscillatorWaveformDisplay::OscillatorWaveformDisplay()
 {
     setAccessible(true);
@@ -169,102 +295,32 @@ void OscillatorWaveformDisplay::paint(juce::Graphics &g)
 
     if (!skipEntireOscillator)
     {
-        auto osc = setupOscillator();
+        if (!previewEvaluator)
+            previewEvaluator = std::make_unique<OscillatorPreviewEvaluator>(this, storage);
 
-        if (!osc)
-        {
-            return;
-        }
+        if (auto res = previewEvaluator->takeResult())
+            cachedPreview = std::move(res);
 
-        int totalSamples = (1 << 3) * (int)getWidth();
-        int averagingWindow = 4; // < and Mult of BlockSizeOS
-        float disp_pitch_rs = disp_pitch + 12.0 * log2(storage->dsamplerate / 44100.0);
+        auto in = makePreviewInputs();
 
-        if (!storage->isStandardTuning)
+        if (!cachedPreview)
         {
-            // OK so in this case we need to find a better version of the note which gets us
-            // that pitch. Only way is to search really.
-            auto pit = storage->note_to_pitch_ignoring_tuning(disp_pitch_rs);
-            int bracket = -1;
-
-            for (int i = 0; i < 128; ++i)
-            {
-                if (storage->note_to_pitch(i) < pit && storage->note_to_pitch(i + 1) > pit)
-                {
-                    bracket = i;
-
-                    break;
-                }
-            }
-
-            if (bracket >= 0)
-            {
-                float f1 = storage->note_to_pitch(bracket);
-                float f2 = storage->note_to_pitch(bracket + 1);
-                float frac = (pit - f1) / (f2 - f1);
-
-                disp_pitch_rs = bracket + frac;
-            }
-
-            // That's a strange non-monotonic tuning. Oh well.
+            // Nothing to show yet, so render the first one here rather than paint a blank
+            cachedPreview = renderOscillatorPreview(storage, *in, oscbuffer);
         }
-
-        bool use_display = osc->allow_display();
-
-        if (use_display)
+        else if (cachedPreview->key != in->key && requestedPreviewKey != in->key)
         {
-            osc->init(disp_pitch_rs, true, true);
+            // Keep drawing the previous wave until the new one arrives
+            requestedPreviewKey = in->key;
+            previewEvaluator->request(std::move(in));
         }
 
-        int block_pos = BLOCK_SIZE;
-        juce::Path wavePath;
-
-        float oscTmp alignas(16)[2][BLOCK_SIZE_OS];
-        sst::filters::HalfRate::HalfRateFilter hr(6, true);
-        hr.load_coefficients();
-        hr.reset();
-
-        for (int i = 0; i < totalSamples; i += averagingWindow)
+        if (!cachedPreview->valid)
         {
-            if (use_display && block_pos >= BLOCK_SIZE)
-            {
-                // Lock it even if we aren't wavetable. It's fine.
-                storage->waveTableDataMutex.lock();
-                osc->process_block(disp_pitch_rs);
-                memcpy(oscTmp[0], osc->output, sizeof(oscTmp[0]));
-                memcpy(oscTmp[1], osc->output, sizeof(oscTmp[1]));
-                hr.process_block_D2(oscTmp[0], oscTmp[1], BLOCK_SIZE_OS);
-                block_pos = 0;
-                storage->waveTableDataMutex.unlock();
-            }
-
-            float val = 0.f;
-
-            if (use_display)
-            {
-                for (int j = 0; j < averagingWindow; ++j)
-                {
-                    val += oscTmp[0][block_pos];
-                    block_pos++;
-                }
-
-                val = val / averagingWindow;
-            }
-
-            float xc = 1.f * i / totalSamples;
-
-            if (i == 0)
-            {
-                wavePath.startNewSubPath(xc, val);
-            }
-            else
-            {
-                wavePath.lineTo(xc, val);
-            }
+            return;
         }
 
-        osc->~Oscillator();
-        osc = nullptr;
+        auto &wavePath = cachedPreview->wavePath;
 
         auto yMargin = 2 * usesWT;
         auto h = getHeight() - usesWT * wtbheight - 2 * yMargin;
@@ -516,6 +572,90 @@ void OscillatorWaveformDisplay::repaintBasedOnOscMuteState()
     }
 }
 
+std::unique_ptr<OscillatorPreviewInputs> OscillatorWaveformDisplay::makePreviewInputs()
+{
+    auto in = std::make_unique<OscillatorPreviewInputs>();
+
+    in->oscdata = oscdata;
+    in->type = oscdata->type.val.i;
+    in->tp[oscdata->pitch.param_id_in_scene].f = 0;
+
+    for (int i = 0; i < n_osc_params; i++)
+    {
+        in->tp[oscdata->p[i].param_id_in_scene].i = oscdata->p[i].val.i;
+    }
+
+    in->totalSamples = (1 << 3) * (int)getWidth();
+
+    float disp_pitch_rs = disp_pitch + 12.0 * log2(storage->dsamplerate / 44100.0);
+
+    if (!storage->isStandardTuning)
+    {
+        // OK so in this case we need to find a better version of the note which gets us
+        // that pitch. Only way is to search really.
+        auto pit = storage->note_to_pitch_ignoring_tuning(disp_pitch_rs);
+        int bracket = -1;
+
+        for (int i = 0; i < 128; ++i)
+        {
+            if (storage->note_to_pitch(i) < pit && storage->note_to_pitch(i + 1) > pit)
+            {
+                bracket = i;
+
+                break;
+            }
+        }
+
+        if (bracket >= 0)
+        {
+            float f1 = storage->note_to_pitch(bracket);
+            float f2 = storage->note_to_pitch(bracket + 1);
+            float frac = (pit - f1) / (f2 - f1);
+
+            disp_pitch_rs = bracket + frac;
+        }
+
+        // That's a strange non-monotonic tuning. Oh well.
+    }
+
+    in->pitch = disp_pitch_rs;
+
+    // Everything the rendered wave depends on, including the flags and wavetable the
+    // oscillator reads straight from oscdata
+    auto &key = in->key;
+    auto add = [&key](const auto &v) {
+        static_assert(std::is_trivially_copyable_v<std::decay_t<decltype(v)>>);
+        key.append(reinterpret_cast<const char *>(&v), sizeof(v));
+    };
+
+    add(in->oscdata);
+    add(in->type);
+    add(in->pitch);
+    add(in->totalSamples);
+
+    for (int i = 0; i < n_osc_params; i++)
+    {
+        auto &p = oscdata->p[i];
+        add(p.val.i);
+        add(p.temposync);
+        add(p.deactivated);
+        add(p.extend_range);
+        add(p.absolute);
+        add(p.deform_type);
+    }
+
+    add(oscdata->retrigger.val.i);
+    add(oscdata->extraConfig);
+    add(oscdata->wt.current_id);
+    add(oscdata->wt.n_tables);
+    add(oscdata->wt.size);
+    add(oscdata->wt.flags);
+    add(oscdata->wt.TableF32Data);
+    add(oscdata->wt.TableI16Data);
+
+    return in;
+}
+
 ::Oscillator *OscillatorWaveformDisplay::setupOscillator()
 {
     tp[oscdata->pitch.param_id_in_scene].f = 0;
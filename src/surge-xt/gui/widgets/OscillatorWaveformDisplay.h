@@ -42,6 +42,9 @@ namespace Surge
 namespace Widgets
 {
 struct OscillatorWaveformDisplay;
+struct OscillatorPreview;
+struct OscillatorPreviewInputs;
+struct OscillatorPreviewEvaluator;
 template <> void LongHoldMixin<OscillatorWaveformDisplay>::onLongHold();
 
 struct OscillatorWaveformDisplay : public juce::Component,
@@ -83,6 +86,12 @@ struct OscillatorWaveformDisplay : public juce::Component,
     ::Oscillator *setupOscillator();
     unsigned char oscbuffer alignas(16)[oscillator_buffer_size];
 
+    // The rendered wave is cached against what it was rendered from, see paint
+    std::unique_ptr<OscillatorPreviewEvaluator> previewEvaluator;
+    std::unique_ptr<OscillatorPreview> cachedPreview;
+    std::string requestedPreviewKey;
+    std::unique_ptr<OscillatorPreviewInputs> makePreviewInputs();
+
     void paint(juce::Graphics &g) override;
     void resized() override;
 
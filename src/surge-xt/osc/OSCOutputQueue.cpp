@@ -0,0 +1,290 @@
+/*
+ * Surge XT - a free and open source hybrid synthesizer,
+ * built by Surge Synth Team
+ *
+ * Learn more at https://surge-synthesizer.github.io/
+ *
+ * Copyright 2018-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * Surge XT is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Surge was a commercial product from 2004-2018, copyright and ownership
+ * held by Claes Johanson at Vember Audio during that period.
+ * Claes made Surge open source in September 2018.
+ *
+ * All source for Surge XT is available at
+ * https://github.com/surge-synthesizer/surge
+ */
+
+#include "OSCOutputQueue.h"
+
+namespace Surge
+{
+namespace OSC
+{
+
+OSCOutputQueue::OSCOutputQueue(juce::OSCSender &s) : sender(s)
+{
+    for (auto &w : dirtyParams)
+        w = 0;
+}
+
+OSCOutputQueue::~OSCOutputQueue() { stop(); }
+
+void OSCOutputQueue::start()
+{
+    if (running)
+        return;
+
+    running = true;
+    senderThread = std::thread([this]() { run(); });
+}
+
+void OSCOutputQueue::stop()
+{
+    if (!running)
+        return;
+
+    {
+        std::lock_guard<std::mutex> g(cvMutex);
+        running = false;
+    }
+    cv.notify_all();
+
+    if (senderThread.joinable())
+        senderThread.join();
+
+    // Anything still pending belongs to a connection which is going away
+    std::lock_guard<std::mutex> g(queueMutex);
+    ordered.clear();
+    values.clear();
+    for (auto &w : dirtyParams)
+        w = 0;
+    ModulationChange mc;
+    while (modulationFifo.pop(mc))
+        ;
+    pendingModulation.clear();
+}
+
+void OSCOutputQueue::queueOrdered(const juce::OSCMessage &om)
+{
+    std::lock_guard<std::mutex> g(queueMutex);
+    if (ordered.size() >= maxOrderedBacklog)
+    {
+        stats.messagesDropped++;
+        return;
+    }
+    ordered.push_back(om);
+}
+
+void OSCOutputQueue::queueValue(const juce::OSCMessage &om)
+{
+    auto addr = om.getAddressPattern().toString().toStdString();
+
+    std::lock_guard<std::mutex> g(queueMutex);
+    auto it = values.find(addr);
+    if (it != values.end())
+    {
+        it->second = om;
+        stats.messagesMerged++;
+    }
+    else
+    {
+        values.emplace(addr, om);
+    }
+}
+
+void OSCOutputQueue::markParameterDirty(int paramId, float value01)
+{
+    if (paramId < 0 || paramId >= n_total_params)
+        return;
+
+    // The value goes in before the bit so the sender, which clears the bit first, sees it
+    dirtyValues[paramId].store(value01, std::memory_order_relaxed);
+    uint64_t bit = (uint64_t)1 << (paramId & 63);
+    auto prior = dirtyParams[paramId >> 6].fetch_or(bit, std::memory_order_release);
+    if (prior & bit)
+        stats.messagesMerged++;
+}
+
+void OSCOutputQueue::queueModulation(const ModulationChange &mc)
+{
+    if (!modulationFifo.push(mc))
+        stats.messagesDropped++;
+}
+
+void OSCOutputQueue::run()
+{
+    while (running)
+    {
+        flush();
+
+        std::unique_lock<std::mutex> lk(cvMutex);
+        cv.wait_for(lk, std::chrono::milliseconds(tickMs), [this]() { return !running; });
+    }
+}
+
+bool OSCOutputQueue::readyToSend(const std::string &addr, double now)
+{
+    auto it = addressLastSent.find(addr);
+    if (it != addressLastSent.end() && now - it->second < minIntervalPerAddressMs)
+        return false;
+
+    addressLastSent[addr] = now;
+    return true;
+}
+
+void OSCOutputQueue::flush()
+{
+    auto now = juce::Time::getMillisecondCounterHiRes();
+
+    std::deque<juce::OSCMessage> orderedNow;
+    std::vector<juce::OSCMessage> valuesNow;
+    {
+        std::lock_guard<std::mutex> g(queueMutex);
+        orderedNow.swap(ordered);
+
+        for (auto it = values.begin(); it != values.end();)
+        {
+            if (readyToSend(it->first, now))
+            {
+                valuesNow.push_back(std::move(it->second));
+                it = values.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    for (auto &om : orderedNow)
+        append(std::move(om));
+
+    for (auto &om : valuesNow)
+        append(std::move(om));
+
+    for (int w = 0; w < dirtyWords; ++w)
+    {
+        auto bits = dirtyParams[w].exchange(0, std::memory_order_acquire);
+        if (bits == 0)
+            continue;
+
+        for (int b = 0; b < 64; ++b)
+        {
+            uint64_t bit = (uint64_t)1 << b;
+            if (!(bits & bit))
+                continue;
+
+            auto id = w * 64 + b;
+            if (now - paramLastSent[id] < minIntervalPerAddressMs)
+            {
+                // Rate limited; leave it dirty for a later tick
+                dirtyParams[w].fetch_or(bit);
+                continue;
+            }
+
+            if (buildParameterMessage)
+            {
+                auto v = dirtyValues[id].load(std::memory_order_relaxed);
+                auto om = buildParameterMessage(id, v);
+                if (om.has_value())
+                {
+                    append(std::move(*om));
+                    paramLastSent[id] = now;
+                }
+            }
+        }
+    }
+
+    ModulationChange mc;
+    while (modulationFifo.pop(mc))
+    {
+        uint64_t key = ((uint64_t)mc.ptag << 24) | ((uint64_t)(mc.modsource & 0xFF) << 16) |
+                       ((uint64_t)(mc.scene & 0xF) << 12) | ((uint64_t)(mc.index & 0x7FF) << 1) |
+                       (mc.mute ? 1 : 0);
+        auto res = pendingModulation.insert_or_assign(key, mc);
+        if (!res.second)
+            stats.messagesMerged++;
+    }
+
+    if (buildModulationMessage)
+    {
+        for (auto &[k, m] : pendingModulation)
+        {
+            auto om = buildModulationMessage(m);
+            if (om.has_value())
+                append(std::move(*om));
+        }
+    }
+    pendingModulation.clear();
+
+    sendBundle();
+}
+
+size_t OSCOutputQueue::estimateSize(const juce::OSCMessage &om)
+{
+    // OSC strings are null terminated and padded to four bytes
+    auto padded = [](size_t n) { return (n + 4) & ~(size_t)3; };
+
+    size_t res = padded(om.getAddressPattern().toString().getNumBytesAsUTF8());
+    res += padded(om.size() + 1); // type tag string, including the leading ','
+
+    for (const auto &arg : om)
+    {
+        if (arg.isString())
+            res += padded(arg.getString().getNumBytesAsUTF8());
+        else if (arg.isBlob())
+            res += 4 + ((arg.getBlob().getSize() + 3) & ~(size_t)3);
+        else
+            res += 4;
+    }
+
+    return res;
+}
+
+void OSCOutputQueue::append(juce::OSCMessage &&om)
+{
+    // Each bundle element carries a 4 byte size; the bundle header is 16 bytes
+    auto sz = estimateSize(om) + 4;
+    if (!outgoing.empty() && outgoingBytes + sz + 16 > maxBundleBytes)
+        sendBundle();
+
+    outgoing.push_back(std::move(om));
+    outgoingBytes += sz;
+}
+
+void OSCOutputQueue::sendBundle()
+{
+    if (outgoing.empty())
+        return;
+
+    bool ok;
+    if (outgoing.size() == 1)
+    {
+        ok = sender.send(outgoing[0]);
+    }
+    else
+    {
+        auto bundle = juce::OSCBundle();
+        for (auto &om : outgoing)
+            bundle.addElement(om);
+        ok = sender.send(bundle);
+        stats.bundlesSent++;
+    }
+
+    if (ok)
+        stats.messagesSent += outgoing.size();
+    else
+        stats.sendFailures++;
+
+    outgoing.clear();
+    outgoingBytes = 0;
+}
+
+} // namespace OSC
+} // namespace Surge
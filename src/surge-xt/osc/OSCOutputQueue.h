@@ -0,0 +1,138 @@
+/*
+ * Surge XT - a free and open source hybrid synthesizer,
+ * built by Surge Synth Team
+ *
+ * Learn more at https://surge-synthesizer.github.io/
+ *
+ * Copyright 2018-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * Surge XT is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Surge was a commercial product from 2004-2018, copyright and ownership
+ * held by Claes Johanson at Vember Audio during that period.
+ * Claes made Surge open source in September 2018.
+ *
+ * All source for Surge XT is available at
+ * https://github.com/surge-synthesizer/surge
+ */
+
+#ifndef SURGE_SRC_SURGE_XT_OSC_OSCOUTPUTQUEUE_H
+#define SURGE_SRC_SURGE_XT_OSC_OSCOUTPUTQUEUE_H
+
+#include "juce_osc/juce_osc.h"
+#include "SurgeStorage.h"
+#include "MPSCQueue.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+
+namespace Surge
+{
+namespace OSC
+{
+
+/*
+ * OSCOutputQueue owns all traffic to the OSC sender. Nothing calls OSCSender::send directly;
+ * instead messages are handed over in one of three ways and a dedicated thread wakes once per
+ * tick, gathers what is pending and writes it out as size-bounded bundles.
+ *
+ * - queueOrdered: replies, documentation and errors. Sent in order, never merged. If the
+ *   backlog is full the message is dropped and counted.
+ * - queueValue: a value for an address. Values for the same address within a tick (or within
+ *   the per-address minimum interval) are merged so only the latest is sent.
+ * - markParameterDirty / queueModulation: lock free, so safe from the audio thread and from
+ *   any number of producer threads at once. Parameters store the normalized value they were set
+ *   to and set a bit in a dirty bitset; the sender formats the message from that snapshot, never
+ *   from the live Parameter. Modulation changes carry their value and go through a
+ *   multi-producer queue, and are merged by routing.
+ */
+struct OSCOutputQueue
+{
+    struct ModulationChange
+    {
+        long ptag{0};
+        int modsource{0}, scene{0}, index{0};
+        float value{0.f};
+        bool mute{false};
+    };
+
+    explicit OSCOutputQueue(juce::OSCSender &sender);
+    ~OSCOutputQueue();
+
+    void start();
+    void stop();
+    bool isRunning() const { return running; }
+
+    void queueOrdered(const juce::OSCMessage &om);
+    void queueValue(const juce::OSCMessage &om);
+    void markParameterDirty(int paramId, float value01);
+    void queueModulation(const ModulationChange &mc);
+
+    // Called on the sender thread to turn a dirty parameter (with the normalized value it was
+    // marked with) or a modulation change into a message
+    std::function<std::optional<juce::OSCMessage>(int, float)> buildParameterMessage;
+    std::function<std::optional<juce::OSCMessage>(const ModulationChange &)>
+        buildModulationMessage;
+
+    int tickMs{10};
+    // An address is sent at most once in this many milliseconds; later values wait and merge
+    int minIntervalPerAddressMs{20};
+    // Stay under a typical ethernet MTU so bundles are not fragmented
+    size_t maxBundleBytes{1400};
+    size_t maxOrderedBacklog{32768};
+
+    struct Stats
+    {
+        std::atomic<uint64_t> messagesSent{0}, bundlesSent{0}, messagesMerged{0},
+            messagesDropped{0}, sendFailures{0};
+    } stats;
+
+    static size_t estimateSize(const juce::OSCMessage &om);
+
+  private:
+    void run();
+    void flush();
+    bool readyToSend(const std::string &addr, double now);
+    void append(juce::OSCMessage &&om);
+    void sendBundle();
+
+    juce::OSCSender &sender;
+
+    std::thread senderThread;
+    std::atomic<bool> running{false};
+    std::mutex cvMutex;
+    std::condition_variable cv;
+
+    std::mutex queueMutex;
+    std::deque<juce::OSCMessage> ordered;
+    std::unordered_map<std::string, juce::OSCMessage> values;
+
+    static constexpr int dirtyWords = (n_total_params + 63) / 64;
+    std::array<std::atomic<uint64_t>, dirtyWords> dirtyParams{};
+    std::array<std::atomic<float>, n_total_params> dirtyValues{};
+    std::array<double, n_total_params> paramLastSent{};
+
+    Surge::MPSCQueue<ModulationChange, 4096> modulationFifo;
+
+    // Only touched by the sender thread
+    std::unordered_map<uint64_t, ModulationChange> pendingModulation;
+    std::unordered_map<std::string, double> addressLastSent;
+    std::vector<juce::OSCMessage> outgoing;
+    size_t outgoingBytes{0};
+};
+
+} // namespace OSC
+} // namespace Surge
+
+#endif // SURGE_SRC_SURGE_XT_OSC_OSCOUTPUTQUEUE_H
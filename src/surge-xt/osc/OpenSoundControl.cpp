@@ -206,6 +206,16 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
             OpenSoundControl::sendAllModulators();
             return;
         }
+        if (addr_part == "scheduling")
+        {
+            OpenSoundControl::sendSchedulingStats();
+            return;
+        }
+        if (addr_part == "output")
+        {
+            OpenSoundControl::sendOutputStats();
+            return;
+        }
     }
 
     // 'Frequency' notes
@@ -268,7 +278,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
             noteID = int(frequency * 10000);
 
         // queue packet to audio thread
-        sspPtr->oscRingBuf.push(
+        sspPtr->queueOSCToAudio(
             SurgeSynthProcessor::oscToAudio(SurgeSynthProcessor::FREQNOTE, nullptr, frequency, 0, 0,
                                             static_cast<char>(velocity), noteon, noteID, 0, 0));
     }
@@ -325,7 +335,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
             noteID = int(note);
 
         // Send packet to audio thread
-        sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(
+        sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(
             SurgeSynthProcessor::MNOTE, nullptr, 0.0, 0, static_cast<char>(note),
             static_cast<char>(velocity), noteon, noteID, 0, 0));
     }
@@ -351,7 +361,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
         float bend = message[1].getFloat32();
         if ((bend >= -1.0) && (bend <= 1.0))
         {
-            sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(
+            sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(
                 SurgeSynthProcessor::PITCHBEND, nullptr, 0.0, static_cast<int>(bend * 8192),
                 static_cast<char>(chan), 0, 0, 0, 0, 0));
         }
@@ -388,7 +398,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
                           "' is out of range (0.0 - 4.0).");
                 return;
             }
-            sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(
+            sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(
                 SurgeSynthProcessor::NOTEX_VOL, nullptr, val, 0, 0, 0, 0, noteID, 0, 0));
         }
         else if (addr_part == "pitch")
@@ -399,7 +409,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
                           "' is out of range (-120.0 - 120.0).");
                 return;
             }
-            sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(
+            sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(
                 SurgeSynthProcessor::NOTEX_PITCH, nullptr, val, 0, 0, 0, 0, noteID, 0, 0));
         }
         else if (addr_part == "pan")
@@ -410,7 +420,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
                           "' is out of range (0.0 - 1.0).");
                 return;
             }
-            sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(
+            sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(
                 SurgeSynthProcessor::NOTEX_PAN, nullptr, val, 0, 0, 0, 0, noteID, 0, 0));
         }
         else if (addr_part == "timbre")
@@ -421,7 +431,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
                           "' is out of range (0.0 - 1.0).");
                 return;
             }
-            sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(
+            sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(
                 SurgeSynthProcessor::NOTEX_TIMB, nullptr, val, 0, 0, 0, 0, noteID, 0, 0));
         }
         else if (addr_part == "pressure")
@@ -432,7 +442,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
                           "' is out of range (0.0 - 1.0).");
                 return;
             }
-            sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(
+            sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(
                 SurgeSynthProcessor::NOTEX_PRES, nullptr, val, 0, 0, 0, 0, noteID, 0, 0));
         }
     }
@@ -454,7 +464,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
         if ((chan >= 0.0) && (chan <= 15.) && (cnum >= 0.0) && (cnum <= 127.) && (val >= 0.0) &&
             (val <= 127.0))
         {
-            sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(
+            sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(
                 SurgeSynthProcessor::CC, nullptr, 0.0, static_cast<int>(val),
                 static_cast<char>(chan), static_cast<char>(cnum), 0, 0, 0, 0));
         }
@@ -478,7 +488,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
 
         if ((chan >= 0.0) && (chan <= 15.) && (val >= 0.0) && (val <= 127.0))
         {
-            sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(
+            sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(
                 SurgeSynthProcessor::CHAN_ATOUCH, nullptr, 0.0, static_cast<int>(val),
                 static_cast<char>(chan), 0, 0, 0, 0, 0));
         }
@@ -504,7 +514,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
         if ((chan >= 0.0) && (chan <= 15.) && (nnum >= 0.0) && (nnum <= 127.) && (val >= 0.0) &&
             (val <= 127.0))
         {
-            sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(
+            sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(
                 SurgeSynthProcessor::POLY_ATOUCH, nullptr, 0.0, static_cast<int>(val),
                 static_cast<char>(chan), static_cast<char>(nnum), 0, 0, 0, 0));
         }
@@ -515,13 +525,13 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
     // All notes off
     else if (addr_part == "allnotesoff")
     {
-        sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(SurgeSynthProcessor::ALLNOTESOFF,
+        sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(SurgeSynthProcessor::ALLNOTESOFF,
                                                                 nullptr, 0.0, 0, 0, 0, 0, 0, 0, 0));
     }
 
     else if (addr_part == "allsoundoff")
     {
-        sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(SurgeSynthProcessor::ALLSOUNDOFF,
+        sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(SurgeSynthProcessor::ALLSOUNDOFF,
                                                                 nullptr, 0.0, 0, 0, 0, 0, 0, 0, 0));
     }
 
@@ -568,10 +578,10 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
             }
             if (querying)
             {
-                OpenSoundControl::sendMacro(macnum - 1, true);
+                OpenSoundControl::sendMacro(macnum - 1);
             }
             else
-                sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(
+                sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(
                     SurgeSynthProcessor::MACRO, nullptr, val, --macnum, 0, 0, 0, 0, 0, 0));
         }
 
@@ -602,7 +612,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
                     if (!p->can_be_absolute())
                         sendError("Param " + p->oscName + " can't be absolute.");
                     else
-                        sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(
+                        sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(
                             SurgeSynthProcessor::ABSOLUTE_X, p, 0.0, 0, 0, 0,
                             static_cast<bool>(val), 0, 0, 0));
                 }
@@ -611,7 +621,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
                     if (!p->can_deactivate())
                         sendError("Param " + p->oscName + " doesn't support enabling/disabling.");
                     else
-                        sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(
+                        sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(
                             SurgeSynthProcessor::ENABLE_X, p, 0.0, 0, 0, 0, static_cast<bool>(val),
                             0, 0, 0));
                 }
@@ -620,7 +630,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
                     if (!p->can_temposync())
                         sendError("Param " + p->oscName + " can't tempo-sync.");
                     else
-                        sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(
+                        sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(
                             SurgeSynthProcessor::TEMPOSYNC_X, p, 0.0, 0, 0, 0,
                             static_cast<bool>(val), 0, 0, 0));
                 }
@@ -629,7 +639,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
                     if (!p->can_extend_range())
                         sendError("Param " + p->oscName + " can't extend range.");
                     else
-                        sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(
+                        sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(
                             SurgeSynthProcessor::EXTEND_X, p, 0.0, 0, 0, 0, static_cast<bool>(val),
                             0, 0, 0));
                 }
@@ -638,7 +648,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
                     if (!p->has_deformoptions())
                         sendError("Param " + p->oscName + " doesn't have deform options.");
                     else
-                        sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(
+                        sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(
                             SurgeSynthProcessor::DEFORM_X, p, 0.0, static_cast<int>(val), 0, 0, 0,
                             0, 0, 0));
                 }
@@ -647,7 +657,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
                     if (!p->has_portaoptions())
                         sendError("Param " + p->oscName + " doesn't have portamento options.");
                     else
-                        sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(
+                        sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(
                             SurgeSynthProcessor::PORTA_CONSTRATE_X, p, 0.0, 0, 0, 0,
                             static_cast<bool>(val), 0, 0, 0));
                 }
@@ -656,7 +666,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
                     if (!p->has_portaoptions())
                         sendError("Param " + p->oscName + " doesn't have portamento options.");
                     else
-                        sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(
+                        sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(
                             SurgeSynthProcessor::PORTA_GLISS_X, p, 0.0, 0, 0, 0,
                             static_cast<bool>(val), 0, 0, 0));
                 }
@@ -665,7 +675,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
                     if (!p->has_portaoptions())
                         sendError("Param " + p->oscName + " doesn't have portamento options.");
                     else
-                        sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(
+                        sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(
                             SurgeSynthProcessor::PORTA_RETRIGGER_X, p, 0.0, 0, 0, 0,
                             static_cast<bool>(val), 0, 0, 0));
                 }
@@ -678,7 +688,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
                         int new_curve = static_cast<int>(val);
                         if ((new_curve < -1) || (new_curve > 1))
                             new_curve = 0;
-                        sspPtr->oscRingBuf.push(
+                        sspPtr->queueOSCToAudio(
                             SurgeSynthProcessor::oscToAudio(SurgeSynthProcessor::PORTA_CURVE_X, p,
                                                             0.0, new_curve, 0, 0, false, 0, 0, 0));
                     }
@@ -732,7 +742,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
                 juce::OSCMessage om = juce::OSCMessage(juce::OSCAddressPattern(juce::String(addr)));
                 om.addFloat32(val);
                 om.addString(juce::String(deactivated));
-                OpenSoundControl::send(om, true);
+                OpenSoundControl::send(om);
             }
             else
             {
@@ -751,7 +761,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
                 }
 
                 // Send packet to audio thread
-                sspPtr->oscRingBuf.push(
+                sspPtr->queueOSCToAudio(
                     SurgeSynthProcessor::oscToAudio(SurgeSynthProcessor::FX_DISABLE, nullptr, 0.0,
                                                     selected_mask, 0, 0, onoff > 0, 0, 0, 0));
             }
@@ -770,11 +780,11 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
 
             if (querying)
             {
-                sendAllParameterInfo(p, true);
+                sendAllParameterInfo(p);
             }
             else
             {
-                sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(p, val));
+                sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(p, val));
             }
         }
     }
@@ -817,7 +827,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
             om.addFloat32(oscdata->wt.current_id);
             om.addString(synth->storage.getCurrentWavetableName(oscdata));
 
-            OpenSoundControl::send(om, true);
+            OpenSoundControl::send(om);
             return;
         }
 
@@ -1024,7 +1034,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
                 std::string addr = "/tuning/scl";
                 juce::OSCMessage om = juce::OSCMessage(juce::OSCAddressPattern(juce::String(addr)));
                 om.addString(tuningLabel);
-                OpenSoundControl::send(om, true);
+                OpenSoundControl::send(om);
                 return;
             }
 
@@ -1056,7 +1066,7 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
                 std::string addr = "/tuning/kbm";
                 juce::OSCMessage om = juce::OSCMessage(juce::OSCAddressPattern(juce::String(addr)));
                 om.addString(mappingLabel);
-                OpenSoundControl::send(om, true);
+                OpenSoundControl::send(om);
                 return;
             }
 
@@ -1204,10 +1214,10 @@ void OpenSoundControl::oscMessageReceived(const juce::OSCMessage &message)
 
         if (muteMsg)
 
-            sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(
+            sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(
                 SurgeSynthProcessor::MOD_MUTE, p, depth, modnum, 0, 0, 0, 0, mscene, index));
         else
-            sspPtr->oscRingBuf.push(SurgeSynthProcessor::oscToAudio(
+            sspPtr->queueOSCToAudio(SurgeSynthProcessor::oscToAudio(
                 SurgeSynthProcessor::MOD, p, depth, modnum, 0, 0, 0, 0, mscene, index));
     }
     if (!synth->audio_processing_active)
@@ -1239,7 +1249,11 @@ bool OpenSoundControl::hasEnding(std::string const &fullString, std::string cons
 
 void OpenSoundControl::oscBundleReceived(const juce::OSCBundle &bundle)
 {
-    std::string msg;
+    // A nested bundle with an 'immediately' timetag inherits the schedule of its parent
+    auto priorSampleTime = bundleSampleTime;
+    auto bundleTime = sspPtr->oscSampleTimeFor(bundle.getTimeTag());
+    if (bundleTime.has_value())
+        bundleSampleTime = bundleTime;
 
     for (int i = 0; i < bundle.size(); ++i)
     {
@@ -1249,6 +1263,8 @@ void OpenSoundControl::oscBundleReceived(const juce::OSCBundle &bundle)
         else if (elem.isBundle())
             oscBundleReceived(elem.getBundle());
     }
+
+    bundleSampleTime = priorSampleTime;
 }
 
 /* ----- OSC Sending  ----- */
@@ -1280,11 +1296,48 @@ bool OpenSoundControl::initOSCOut(int port, std::string ipaddr)
         ssp->param_change_to_OSC(str1, numvals, float0, float1, float2, str2);
     });
 
-    // Add a listener for parameter changes that happen on the audio thread
-    //  (e.g. MIDI-'learned' parameters being changed by incoming MIDI messages)
+    // Parameters changed on the audio thread (e.g. MIDI-'learned' parameters being changed by
+    // incoming MIDI messages, or an oscillator type or preset load) just mark themselves dirty
+    // with the normalized value they were sent; the output queue builds the message from that
+    // when it next flushes
+    paramIdByOSCName.clear();
+    oscNameByParamId.assign(synth->storage.getPatch().param_ptr.size(), "");
+    for (auto *p : synth->storage.getPatch().param_ptr)
+    {
+        if (p)
+        {
+            paramIdByOSCName[p->oscName] = p->id;
+            oscNameByParamId[p->id] = p->get_osc_name();
+        }
+    }
+
+    // Both builders run on the sender thread and only use what the producer handed over
+    outputQueue.buildParameterMessage = [this](int id,
+                                               float value01) -> std::optional<juce::OSCMessage> {
+        auto &pp = synth->storage.getPatch().param_ptr;
+        if (id < 0 || id >= (int)pp.size() || !pp[id])
+            return std::nullopt;
+        return makeParameterValueMessage(pp[id], value01);
+    };
+    outputQueue.buildModulationMessage =
+        [this](const OSCOutputQueue::ModulationChange &mc) -> std::optional<juce::OSCMessage> {
+        if (mc.ptag < 0 || mc.ptag >= (long)oscNameByParamId.size())
+            return std::nullopt;
+        auto addr = getModulatorOSCAddr(mc.modsource, mc.scene, mc.index, mc.mute);
+        return makeModulationMessage(addr, oscNameByParamId[mc.ptag], mc.value, false);
+    };
+    outputQueue.start();
+
     synth->addAudioParamListener(
         "OSC_OUT", [this, ssp = sspPtr](std::string oname, float fval, std::string valstr) {
-            assert(juce::MessageManager::getInstanceWithoutCreating());
+            auto it = paramIdByOSCName.find(oname);
+            if (it != paramIdByOSCName.end())
+            {
+                outputQueue.markParameterDirty(it->second, fval);
+                return;
+            }
+
+            // An address with no parameter behind it goes out as it came; these are rare
             auto *mm = juce::MessageManager::getInstanceWithoutCreating();
             if (mm)
             {
@@ -1325,36 +1378,31 @@ void OpenSoundControl::stopSending(bool updateOSCStartInStorage)
     synth->deleteAudioParamListener("OSC_OUT");
     sspPtr->deleteParamChangeListener("OSC_OUT");
 
+    outputQueue.stop();
+
     if (updateOSCStartInStorage)
     {
         synth->storage.oscStartOut = false;
     }
 }
 
-void OpenSoundControl::send(juce::OSCMessage om, bool needsMessageThread)
+// Messages which must all arrive, in order (query replies, docs, errors)
+void OpenSoundControl::send(juce::OSCMessage om)
 {
     if (sendingOSC)
     {
-        if (needsMessageThread)
-        {
-            // Runs on the juce messenger thread
-            juce::MessageManager::getInstance()->callAsync([this, om]() {
-                if (!this->juceOSCSender.send(om))
-                    sendFailed();
-            });
-        }
-        else
-        {
-            // Send OSC directly (used when already on the messenger thread)
-            {
-                if (!this->juceOSCSender.send(om))
-                    sendFailed();
-            }
-        }
+        outputQueue.queueOrdered(om);
     }
 }
 
-void OpenSoundControl::sendFailed() { std::cout << "Error: could not send OSC message."; }
+// Messages which report the latest value at an address; repeated values are merged
+void OpenSoundControl::sendValue(juce::OSCMessage om)
+{
+    if (sendingOSC)
+    {
+        outputQueue.queueValue(om);
+    }
+}
 
 void OpenSoundControl::sendError(std::string errorMsg)
 {
@@ -1362,7 +1410,7 @@ void OpenSoundControl::sendError(std::string errorMsg)
     {
         juce::OSCMessage om = juce::OSCMessage(juce::OSCAddressPattern(juce::String("/error")));
         om.addString(errorMsg);
-        OpenSoundControl::send(om, true);
+        OpenSoundControl::send(om);
     }
     else
         std::cout << "OSC Error: " << errorMsg << std::endl;
@@ -1402,12 +1450,12 @@ void OpenSoundControl::sendAllParams()
             for (int i = 0; i < n; i++)
             {
                 Parameter *p = synth->storage.getPatch().param_ptr[i];
-                sendAllParameterInfo(p, false);
+                sendAllParameterInfo(p);
             }
             // Now do the macros
             for (int i = 0; i < n_customcontrollers; i++)
             {
-                sendMacro(i, false);
+                sendMacro(i);
             }
             // delete timer;    // This prints the elapsed time
         });
@@ -1415,24 +1463,24 @@ void OpenSoundControl::sendAllParams()
 }
 
 // Send one message for every extended option for the given parameter
-void OpenSoundControl::sendParameterExtOptions(const Parameter *p, bool needsMessageThread)
+void OpenSoundControl::sendParameterExtOptions(const Parameter *p)
 {
     if (p->can_be_absolute())
-        sendParameter(p, needsMessageThread, "abs");
+        sendParameter(p, "abs");
     if (p->can_deactivate())
-        sendParameter(p, needsMessageThread, "enable");
+        sendParameter(p, "enable");
     if (p->can_temposync())
-        sendParameter(p, needsMessageThread, "tempo_sync");
+        sendParameter(p, "tempo_sync");
     if (p->can_extend_range())
-        sendParameter(p, needsMessageThread, "extend");
+        sendParameter(p, "extend");
     if (p->has_deformoptions())
-        sendParameter(p, needsMessageThread, "deform");
+        sendParameter(p, "deform");
     if (p->has_portaoptions())
     {
-        sendParameter(p, needsMessageThread, "const_rate");
-        sendParameter(p, needsMessageThread, "gliss");
-        sendParameter(p, needsMessageThread, "retrig");
-        sendParameter(p, needsMessageThread, "curve");
+        sendParameter(p, "const_rate");
+        sendParameter(p, "gliss");
+        sendParameter(p, "retrig");
+        sendParameter(p, "curve");
     }
 }
 
@@ -1491,15 +1539,18 @@ void OpenSoundControl::sendModulator(ModulationRouting mod, int scene, bool glob
 
 void OpenSoundControl::modOSCout(std::string addr, std::string oscName, float val, bool reportMute)
 {
-    std::string paramAddr = addr;
+    OpenSoundControl::send(makeModulationMessage(addr, oscName, val, reportMute));
+}
+
+juce::OSCMessage OpenSoundControl::makeModulationMessage(std::string addr, std::string oscName,
+                                                         float val, bool reportMute)
+{
     if (reportMute)
-        paramAddr = addr.insert(4, "/mute");
+        addr.insert(4, "/mute");
     juce::OSCMessage om = juce::OSCMessage(juce::OSCAddressPattern(juce::String(addr)));
     om.addString(oscName);
     om.addFloat32(val);
-
-    // Sending directly here, because we're already on the JUCE messenger thread
-    OpenSoundControl::send(om, false);
+    return om;
 }
 
 std::string OpenSoundControl::getModulatorOSCAddr(int modid, int scene, int index, bool mute)
@@ -1528,13 +1579,13 @@ std::string OpenSoundControl::getModulatorOSCAddr(int modid, int scene, int inde
     return ("/mod/" + muteStr + sceneStr + modName + indexStr);
 }
 
-void OpenSoundControl::sendMacro(long macnum, bool needsMessageThread)
+void OpenSoundControl::sendMacro(long macnum)
 {
-    auto cms = ((ControllerModulationSource *)synth->storage.getPatch()
-                    .scene[0]
-                    .modsources[macnum + ms_ctrl1]);
-    auto valStr = float_to_clocalestr_wprec(100 * cms->get_output(0), 3) + " %";
-    float val01 = cms->get_output01(0);
+    // Don't read the live macro here; this runs on the OSC thread while the engine writes it
+    SurgeSynthesizer::ModulationSnapshot snap;
+    synth->getModulationSnapshot(snap);
+    auto valStr = float_to_clocalestr_wprec(100 * snap.scene[0][macnum + ms_ctrl1][0], 3) + " %";
+    float val01 = snap.macroOutput01[macnum];
     std::string addr = "/param/macro/" + std::to_string(macnum + 1);
 
     juce::OSCMessage om = juce::OSCMessage(juce::OSCAddressPattern(juce::String(addr)));
@@ -1542,22 +1593,49 @@ void OpenSoundControl::sendMacro(long macnum, bool needsMessageThread)
     if (!valStr.empty())
         om.addString(valStr);
 
-    OpenSoundControl::send(om, needsMessageThread);
+    OpenSoundControl::send(om);
+}
+
+// Report counters for timetagged bundles: scheduled, late, overflowed, and the latency in ms
+void OpenSoundControl::sendSchedulingStats()
+{
+    juce::OSCMessage om = juce::OSCMessage(juce::OSCAddressPattern(juce::String("/scheduling")));
+    om.addFloat32((float)sspPtr->oscEventsScheduled.load());
+    om.addFloat32((float)sspPtr->oscEventsLate.load());
+    om.addFloat32((float)sspPtr->oscEventsOverflowed.load());
+    om.addFloat32((float)synth->storage.oscSchedulingLatencyMs.load());
+    OpenSoundControl::send(om);
+}
+
+// Report output queue counters: messages sent, bundles sent, merged, dropped and failed sends
+void OpenSoundControl::sendOutputStats()
+{
+    juce::OSCMessage om = juce::OSCMessage(juce::OSCAddressPattern(juce::String("/output")));
+    om.addFloat32((float)outputQueue.stats.messagesSent.load());
+    om.addFloat32((float)outputQueue.stats.bundlesSent.load());
+    om.addFloat32((float)outputQueue.stats.messagesMerged.load());
+    om.addFloat32((float)outputQueue.stats.messagesDropped.load());
+    om.addFloat32((float)outputQueue.stats.sendFailures.load());
+    OpenSoundControl::send(om);
 }
 
 void OpenSoundControl::sendPath(std::string pathString)
 {
     juce::OSCMessage om = juce::OSCMessage(juce::OSCAddressPattern(juce::String("/patch")));
     om.addString(pathString);
-    OpenSoundControl::send(om, true);
+    OpenSoundControl::send(om);
 }
 
 /* Send the OSC address and value of the supplied parameter or extended option
     If 'extension' is not empty, it specifies the extended parameter option to report.
     'extension' equals "", by default.
 */
-void OpenSoundControl::sendParameter(const Parameter *p, bool needsMessageThread,
-                                     std::string extension)
+void OpenSoundControl::sendParameter(const Parameter *p, std::string extension)
+{
+    OpenSoundControl::send(makeParameterMessage(p, extension));
+}
+
+juce::OSCMessage OpenSoundControl::makeParameterMessage(const Parameter *p, std::string extension)
 {
     std::string valStr = "";
     float val01 = 0.0;
@@ -1615,10 +1693,33 @@ void OpenSoundControl::sendParameter(const Parameter *p, bool needsMessageThread
     om.addFloat32(val01);
     if (!valStr.empty())
         om.addString(valStr);
-    OpenSoundControl::send(om, needsMessageThread);
+    return om;
 }
 
-void OpenSoundControl::sendParameterDocs(const Parameter *p, bool needsMessageThread)
+juce::OSCMessage OpenSoundControl::makeParameterValueMessage(const Parameter *p, float value01)
+{
+    float val = value01;
+    switch (p->valtype)
+    {
+    case vt_int:
+        val = (float)Parameter::intUnscaledFromFloat(value01, p->val_max.i, p->val_min.i);
+        break;
+    case vt_bool:
+        val = value01 > 0.5f ? 1.f : 0.f;
+        break;
+    default:
+        break;
+    }
+
+    juce::OSCMessage om = juce::OSCMessage(juce::OSCAddressPattern(juce::String(p->oscName)));
+    om.addFloat32(val);
+    auto valStr = p->get_display(true, value01);
+    if (!valStr.empty())
+        om.addString(valStr);
+    return om;
+}
+
+void OpenSoundControl::sendParameterDocs(const Parameter *p)
 {
     // fetch param name/description and set unused params to 'Disabled'
     // note: unused parameters will still return doc values!
@@ -1665,10 +1766,10 @@ void OpenSoundControl::sendParameterDocs(const Parameter *p, bool needsMessageTh
     om.addString(valMin);
     om.addString(valMax);
 
-    OpenSoundControl::send(om, needsMessageThread);
+    OpenSoundControl::send(om);
 }
 
-void OpenSoundControl::sendParameterExtDocs(const Parameter *p, bool needsMessageThread)
+void OpenSoundControl::sendParameterExtDocs(const Parameter *p)
 {
     // Note: this message is always sent, even when no ext params are found.
     // This way OSC clients can reliably determine the available ext params: there is a
@@ -1700,15 +1801,15 @@ void OpenSoundControl::sendParameterExtDocs(const Parameter *p, bool needsMessag
     {
         om.addString(ext);
     }
-    OpenSoundControl::send(om, needsMessageThread);
+    OpenSoundControl::send(om);
 }
 
-void OpenSoundControl::sendAllParameterInfo(const Parameter *p, bool needsMessageThread)
+void OpenSoundControl::sendAllParameterInfo(const Parameter *p)
 {
-    sendParameter(p, needsMessageThread);
-    sendParameterExtOptions(p, needsMessageThread);
-    sendParameterDocs(p, needsMessageThread);
-    sendParameterExtDocs(p, needsMessageThread);
+    sendParameter(p);
+    sendParameterExtOptions(p);
+    sendParameterDocs(p);
+    sendParameterExtDocs(p);
 }
 
 // ModulationAPIListener Implementation
@@ -1748,13 +1849,18 @@ void OpenSoundControl::modEndEdit(long ptag, modsources modsource, int modsource
 void OpenSoundControl::sendMod(long ptag, modsources modsource, int modSourceScene, int index,
                                float val, bool mute)
 {
-    // Runs on the juce messenger thread
-    juce::MessageManager::getInstance()->callAsync(
-        [this, ptag, modsource, modSourceScene, index, val, mute]() {
-            std::string modOSCaddr = getModulatorOSCAddr(modsource, modSourceScene, index, mute);
-            Parameter *param = synth->storage.getPatch().param_ptr[ptag];
-            modOSCout(modOSCaddr, param->get_osc_name(), val, false);
-        });
+    // May be called from the audio thread; the output queue formats the message later
+    if (sendingOSC)
+    {
+        OSCOutputQueue::ModulationChange mc;
+        mc.ptag = ptag;
+        mc.modsource = modsource;
+        mc.scene = modSourceScene;
+        mc.index = index;
+        mc.value = val;
+        mc.mute = mute;
+        outputQueue.queueModulation(mc);
+    }
 }
 
 } // namespace OSC
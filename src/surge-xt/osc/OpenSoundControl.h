@@ -39,8 +39,10 @@
 #include "juce_osc/juce_osc.h"
 #include "SurgeSynthesizer.h"
 #include "SurgeStorage.h"
+#include "OSCOutputQueue.h"
 #include <fmt/core.h>
 #include <fmt/format.h>
+#include <optional>
 
 class SurgeSynthProcessor;
 
@@ -72,7 +74,11 @@ class OpenSoundControl : public juce::OSCReceiver,
     void oscMessageReceived(const juce::OSCMessage &message) override;
     void oscBundleReceived(const juce::OSCBundle &bundle) override;
 
-    void send(juce::OSCMessage om, bool needsMessageThread);
+    // Sample time of the timetagged bundle currently being received; empty for immediately
+    std::optional<int64_t> bundleSampleTime;
+
+    void send(juce::OSCMessage om);
+    void sendValue(juce::OSCMessage om);
     void sendAllParams();
     void sendAllModulators();
     void stopSending(bool updateOSCStartInStorage = true);
@@ -89,6 +95,8 @@ class OpenSoundControl : public juce::OSCReceiver,
                     float depth01) override;
 
     void modOSCout(std::string addr, std::string oscName, float val, bool reportMute);
+    juce::OSCMessage makeModulationMessage(std::string addr, std::string oscName, float val,
+                                           bool reportMute);
 
   private:
     SurgeSynthesizer *synth{nullptr};
@@ -96,24 +104,34 @@ class OpenSoundControl : public juce::OSCReceiver,
     std::string getWholeString(const juce::OSCMessage &message);
     int getNoteID(const juce::OSCMessage &om, int pos);
     juce::OSCSender juceOSCSender;
+    // Declared after the sender, which it writes to from its own thread
+    OSCOutputQueue outputQueue{juceOSCSender};
+    std::unordered_map<std::string, int> paramIdByOSCName;
+    // Built before the output queue starts and not changed while it runs, so the sender thread
+    // can name modulation targets without reading the patch
+    std::vector<std::string> oscNameByParamId;
     void sendError(std::string errorMsg);
     void sendNotFloatError(std::string addr, std::string msg);
     void sendDataCountError(std::string addr, std::string count);
     void sendMidiBoundsError(std::string addr);
-    void sendParameter(const Parameter *p, bool needsMessageThread, std::string extension = "");
-    void sendParameterExtOptions(const Parameter *p, bool needsMessageThread);
-    void sendAllParameterInfo(const Parameter *p, bool needsMessageThread);
-
-    void sendParameterDocs(const Parameter *p, bool needsMessageThread);
-    void sendParameterExtDocs(const Parameter *p, bool needsMessageThread);
-    void sendMacro(long macnum, bool needsMsgThread);
+    void sendParameter(const Parameter *p, std::string extension = "");
+    juce::OSCMessage makeParameterMessage(const Parameter *p, std::string extension = "");
+    // The message for p at a normalized value; reads the parameter's format but not its value
+    juce::OSCMessage makeParameterValueMessage(const Parameter *p, float value01);
+    void sendParameterExtOptions(const Parameter *p);
+    void sendAllParameterInfo(const Parameter *p);
+
+    void sendParameterDocs(const Parameter *p);
+    void sendParameterExtDocs(const Parameter *p);
+    void sendMacro(long macnum);
     void sendModulator(ModulationRouting mod, int scene, bool global);
     void sendPath(std::string pathStr);
+    void sendSchedulingStats();
+    void sendOutputStats();
 
     std::string getModulatorOSCAddr(int modid, int scene, int index, bool mute);
     void sendMod(long ptag, modsources modsource, int modsourceScene, int index, float val,
                  bool reportMute);
-    void sendFailed();
     bool hasEnding(std::string const &fullString, std::string const &ending);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OpenSoundControl)
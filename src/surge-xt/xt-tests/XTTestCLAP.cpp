@@ -0,0 +1,115 @@
+/*
+ * Surge XT - a free and open source hybrid synthesizer,
+ * built by Surge Synth Team
+ *
+ * Learn more at https://surge-synthesizer.github.io/
+ *
+ * Copyright 2018-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * Surge XT is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Surge was a commercial product from 2004-2018, copyright and ownership
+ * held by Claes Johanson at Vember Audio during that period.
+ * Claes made Surge open source in September 2018.
+ *
+ * All source for Surge XT is available at
+ * https://github.com/surge-synthesizer/surge
+ */
+
+#include "catch2/catch_amalgamated.hpp"
+#include "SurgeSynthProcessor.h"
+
+#include <vector>
+
+#if HAS_CLAP_JUCE_EXTENSIONS
+
+namespace
+{
+struct ParamEventList
+{
+    std::vector<clap_event_param_value> events;
+    clap_input_events list{this, size, get};
+
+    static uint32_t size(const clap_input_events *l)
+    {
+        return (uint32_t)static_cast<ParamEventList *>(l->ctx)->events.size();
+    }
+    static const clap_event_header *get(const clap_input_events *l, uint32_t i)
+    {
+        return &static_cast<ParamEventList *>(l->ctx)->events[i].header;
+    }
+
+    void add(uint32_t time, JUCEParameterVariant *jv, double value)
+    {
+        auto e = clap_event_param_value();
+        e.header.size = sizeof(clap_event_param_value);
+        e.header.type = (uint16_t)CLAP_EVENT_PARAM_VALUE;
+        e.header.time = time;
+        e.header.space_id = CLAP_CORE_EVENT_SPACE_ID;
+        e.header.flags = 0;
+        e.param_id = 0;
+        e.cookie = jv;
+        e.note_id = -1;
+        e.port_index = -1;
+        e.channel = -1;
+        e.key = -1;
+        e.value = value;
+        events.push_back(e);
+    }
+};
+
+SurgeParamToJuceParamAdapter *adapterFor(SurgeSynthProcessor &s, Parameter *p)
+{
+    for (auto *jp : s.getParameters())
+        if (auto sp = dynamic_cast<SurgeParamToJuceParamAdapter *>(jp))
+            if (sp->p == p)
+                return sp;
+    return nullptr;
+}
+} // namespace
+
+TEST_CASE("Block End Automation Only Interpolates Continuous Parameters", "[xt-clap]")
+{
+    juce::MessageManager::getInstance();
+    auto s = SurgeSynthProcessor();
+    s.surge->storage.blockEndAutomation = true;
+
+    auto &fu = s.surge->storage.getPatch().scene[0].filterunit[0];
+
+    SECTION("A Float Lands On The Line At The Block End")
+    {
+        auto jv = JUCEParameterVariant();
+        jv.processorParam = adapterFor(s, &fu.cutoff);
+        REQUIRE(jv.processorParam);
+
+        // Events either side of the end of the first block, which is where it is applied
+        ParamEventList el;
+        el.add(BLOCK_SIZE / 2, &jv, 0.2);
+        el.add(BLOCK_SIZE + BLOCK_SIZE / 2, &jv, 0.6);
+
+        s.process_clap_param_at_block_end(&el.list, 0, 2, BLOCK_SIZE);
+        REQUIRE(fu.cutoff.get_value_f01() == Approx(0.4).margin(1e-5));
+    }
+
+    SECTION("An Integer Takes The Value It Was Sent")
+    {
+        auto jv = JUCEParameterVariant();
+        jv.processorParam = adapterFor(s, &fu.type);
+        REQUIRE(jv.processorParam);
+
+        ParamEventList el;
+        el.add(BLOCK_SIZE / 2, &jv, fu.type.value_to_normalized(2));
+        el.add(BLOCK_SIZE + BLOCK_SIZE / 2, &jv, fu.type.value_to_normalized(10));
+
+        s.process_clap_param_at_block_end(&el.list, 0, 2, BLOCK_SIZE);
+        REQUIRE(fu.type.val.i == 2);
+    }
+
+    juce::MessageManager::deleteInstance();
+}
+
+#endif
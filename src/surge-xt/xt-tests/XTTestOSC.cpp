@@ -23,6 +23,13 @@
 #include "catch2/catch_amalgamated.hpp"
 #include "SurgeSynthProcessor.h"
 
+#include <array>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 TEST_CASE("Can Make an SSP", "[xt-osc]")
 {
     juce::MessageManager::getInstance();
@@ -79,4 +86,266 @@ TEST_CASE("Simulate the Audio Thread", "[xt-osc]")
     keepGoing = false;
     t.join();
     juce::MessageManager::deleteInstance();
-}
\ No newline at end of file
+}
+TEST_CASE("Timetagged Bundles Are Scheduled", "[xt-osc]")
+{
+    auto mm = juce::MessageManager::getInstance();
+
+    /*
+     * Drive the audio thread by hand and place bundles by sample time directly, so nothing
+     * here depends on how long the test takes to run
+     */
+    auto s = SurgeSynthProcessor();
+    auto processHostBlock = [&s]() {
+        auto a = juce::AudioBuffer<float>(6, 512);
+        auto m = juce::MidiBuffer();
+        s.processBlock(a, m);
+
+        auto gv = 0;
+        for (const auto &sv : s.surge->voices)
+            for (const auto &v : sv)
+                if (v->state.gate)
+                    gv++;
+        return gv;
+    };
+
+    for (int i = 0; i < 4; ++i)
+        REQUIRE(processHostBlock() == 0);
+    REQUIRE(s.samplesProcessed == 4 * 512);
+
+    SECTION("Future Bundle Is Held Until Its Sample")
+    {
+        auto target = s.samplesProcessed + 4 * 512;
+        s.oscHandler.bundleSampleTime = target;
+        s.oscHandler.oscMessageReceived(juce::OSCMessage("/mnote", 60.f, 90.f));
+        s.oscHandler.bundleSampleTime.reset();
+
+        while (s.samplesProcessed < target)
+            REQUIRE(processHostBlock() == 0);
+        REQUIRE(processHostBlock() == 1);
+        REQUIRE(s.oscEventsScheduled == 1);
+        REQUIRE(s.oscEventsLate == 0);
+    }
+
+    SECTION("Past Bundle Is Applied And Counted Late")
+    {
+        s.oscHandler.bundleSampleTime = s.samplesProcessed - 1000;
+        s.oscHandler.oscMessageReceived(juce::OSCMessage("/mnote", 60.f, 90.f));
+        s.oscHandler.bundleSampleTime.reset();
+
+        REQUIRE(processHostBlock() == 1);
+        REQUIRE(s.oscEventsScheduled == 0);
+        REQUIRE(s.oscEventsLate == 1);
+    }
+
+    SECTION("Bundle Before Sample Zero Is Late, Not Immediate")
+    {
+        s.oscHandler.bundleSampleTime = -100000;
+        s.oscHandler.oscMessageReceived(juce::OSCMessage("/mnote", 60.f, 90.f));
+        s.oscHandler.bundleSampleTime.reset();
+
+        REQUIRE(processHostBlock() == 1);
+        REQUIRE(s.oscEventsLate == 1);
+    }
+
+    SECTION("Immediate Messages Are Not Scheduled")
+    {
+        s.oscHandler.oscMessageReceived(juce::OSCMessage("/mnote", 60.f, 90.f));
+        REQUIRE(processHostBlock() == 1);
+        REQUIRE(s.oscEventsScheduled == 0);
+        REQUIRE(s.oscEventsLate == 0);
+    }
+
+    SECTION("Timetags Convert To Sample Times")
+    {
+        REQUIRE(!s.oscSampleTimeFor(juce::OSCTimeTag()).has_value());
+
+        auto past = juce::Time::getCurrentTime() - juce::RelativeTime::seconds(60);
+        auto pastTime = s.oscSampleTimeFor(juce::OSCTimeTag(past));
+        REQUIRE(pastTime.has_value());
+        REQUIRE(*pastTime < s.samplesProcessed);
+    }
+
+    juce::MessageManager::deleteInstance();
+}
+
+TEST_CASE("OSC Output Queue Merges Values", "[xt-osc]")
+{
+    auto sender = juce::OSCSender();
+    auto q = Surge::OSC::OSCOutputQueue(sender);
+
+    SECTION("Message Size Estimate")
+    {
+        // "/a\0\0" + ",f\0\0" + float
+        REQUIRE(Surge::OSC::OSCOutputQueue::estimateSize(juce::OSCMessage("/a", 1.f)) == 12);
+        // "/abcd" pads to 8, ",fs" to 4, float 4, "hi" to 4
+        REQUIRE(Surge::OSC::OSCOutputQueue::estimateSize(
+                    juce::OSCMessage("/abcd", 1.f, juce::String("hi"))) == 20);
+    }
+
+    SECTION("Values At The Same Address Merge")
+    {
+        q.queueValue(juce::OSCMessage("/param/a/amp/gain", 0.1f));
+        q.queueValue(juce::OSCMessage("/param/a/amp/gain", 0.2f));
+        q.queueValue(juce::OSCMessage("/param/b/amp/gain", 0.3f));
+        REQUIRE(q.stats.messagesMerged == 1);
+    }
+
+    SECTION("Dirty Parameters Merge")
+    {
+        q.markParameterDirty(12, 0.1f);
+        q.markParameterDirty(12, 0.2f);
+        q.markParameterDirty(13, 0.3f);
+        REQUIRE(q.stats.messagesMerged == 1);
+    }
+
+    SECTION("Ordered Messages Never Merge")
+    {
+        q.queueOrdered(juce::OSCMessage("/error", juce::String("one")));
+        q.queueOrdered(juce::OSCMessage("/error", juce::String("two")));
+        REQUIRE(q.stats.messagesMerged == 0);
+        REQUIRE(q.stats.messagesDropped == 0);
+    }
+}
+
+TEST_CASE("OSC Output Queue Takes Changes From Two Producers", "[xt-osc]")
+{
+    auto sender = juce::OSCSender();
+    auto q = Surge::OSC::OSCOutputQueue(sender);
+
+    /*
+     * Two threads stand in for the audio and message threads. Each sends modulation changes to
+     * its own targets and sets its own 100 parameters ten times over. The sender must see every
+     * modulation target once and every parameter at the last value its producer set.
+     */
+    static constexpr int perProducer = 1000, paramsPerProducer = 100;
+    auto finalValue = [](int id) { return (900 + id % paramsPerProducer) / 1000.f; };
+
+    std::array<std::atomic<int>, 2 * perProducer> modulationSeen{};
+    std::array<std::atomic<bool>, 2 * paramsPerProducer> finalParamSeen{};
+    q.buildModulationMessage = [&](const auto &mc) -> std::optional<juce::OSCMessage> {
+        if (mc.ptag >= 0 && mc.ptag < 2 * perProducer)
+            modulationSeen[mc.ptag]++;
+        return std::nullopt;
+    };
+    q.buildParameterMessage = [&](int id, float v) -> std::optional<juce::OSCMessage> {
+        if (id >= 0 && id < 2 * paramsPerProducer && v == finalValue(id))
+            finalParamSeen[id] = true;
+        return std::nullopt;
+    };
+    q.minIntervalPerAddressMs = 0;
+    q.start();
+
+    auto produce = [&q](int producer) {
+        for (int i = 0; i < perProducer; ++i)
+        {
+            Surge::OSC::OSCOutputQueue::ModulationChange mc;
+            mc.ptag = producer * perProducer + i;
+            mc.value = 0.5f;
+            q.queueModulation(mc);
+            q.markParameterDirty(producer * paramsPerProducer + i % paramsPerProducer,
+                                 i / 1000.f);
+        }
+    };
+    auto a = std::thread(produce, 0);
+    auto b = std::thread(produce, 1);
+    a.join();
+    b.join();
+
+    auto allSeen = [&]() {
+        for (auto &m : modulationSeen)
+            if (m == 0)
+                return false;
+        for (auto &p : finalParamSeen)
+            if (!p)
+                return false;
+        return true;
+    };
+    for (int i = 0; i < 500 && !allSeen(); ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(q.tickMs));
+    q.stop();
+
+    REQUIRE(q.stats.messagesDropped == 0);
+    for (auto &m : modulationSeen)
+        REQUIRE(m == 1);
+    for (auto &p : finalParamSeen)
+        REQUIRE(p);
+}
+
+TEST_CASE("Oscillator Preset Loads Send Normalized Values", "[xt-osc]")
+{
+    juce::MessageManager::getInstance();
+    auto s = SurgeSynthProcessor();
+
+    // Everything the output queue sends, by address, as it arrives over loopback
+    struct Collector : juce::OSCReceiver::Listener<juce::OSCReceiver::RealtimeCallback>
+    {
+        std::mutex lock;
+        std::map<std::string, std::vector<float>> seen;
+
+        void oscMessageReceived(const juce::OSCMessage &om) override
+        {
+            if (om.size() > 0 && om[0].isFloat32())
+            {
+                auto g = std::lock_guard<std::mutex>(lock);
+                seen[om.getAddressPattern().toString().toStdString()].push_back(om[0].getFloat32());
+            }
+        }
+        void oscBundleReceived(const juce::OSCBundle &b) override
+        {
+            for (auto &el : b)
+            {
+                if (el.isMessage())
+                    oscMessageReceived(el.getMessage());
+                else if (el.isBundle())
+                    oscBundleReceived(el.getBundle());
+            }
+        }
+    } collector;
+
+    static constexpr int port = 53291;
+    juce::OSCReceiver receiver;
+    REQUIRE(receiver.connect(port));
+    receiver.addListener(&collector);
+    REQUIRE(s.oscHandler.initOSCOut(port, "127.0.0.1"));
+
+    // A sine preset with an int and a float value and retrigger on, the way the menu queues it
+    auto &osc = s.surge->storage.getPatch().scene[0].osc[0];
+    TiXmlElement preset("osc");
+    preset.SetAttribute("p0", 3);
+    preset.SetDoubleAttribute("p1", 0.5);
+    preset.SetAttribute("retrigger", 1);
+    osc.queue_type = ot_sine;
+    osc.queue_xmldata = &preset;
+    s.surge->process();
+    REQUIRE(osc.type.val.i == ot_sine);
+
+    // What the sender should say for each: ints unscaled, floats and bools normalized
+    std::map<std::string, float> expected = {{osc.type.oscName, (float)ot_sine},
+                                             {osc.p[0].oscName, (float)osc.p[0].val.i},
+                                             {osc.p[1].oscName, osc.p[1].get_value_f01()},
+                                             {osc.retrigger.oscName, 1.f}};
+
+    auto allArrived = [&]() {
+        auto g = std::lock_guard<std::mutex>(collector.lock);
+        for (auto &[addr, v] : expected)
+            if (collector.seen[addr].empty())
+                return false;
+        return true;
+    };
+    for (int i = 0; i < 200 && !allArrived(); ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    s.oscHandler.stopSending();
+    receiver.disconnect();
+
+    for (auto &[addr, v] : expected)
+    {
+        INFO("Address " << addr);
+        REQUIRE(!collector.seen[addr].empty());
+        for (auto f : collector.seen[addr])
+            REQUIRE(f == Approx(v).margin(1e-5));
+    }
+
+    juce::MessageManager::deleteInstance();
+}